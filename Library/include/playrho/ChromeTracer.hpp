@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef PLAYRHO_CHROMETRACER_HPP
+#define PLAYRHO_CHROMETRACER_HPP
+
+/// @file
+/// @brief Definition of the @c ChromeTracer class and related code.
+
+#include <atomic>
+#include <chrono>
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t
+#include <iosfwd> // for std::ostream
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility> // for std::pair
+#include <vector>
+
+// IWYU pragma: begin_exports
+
+#include <playrho/Tracer.hpp>
+
+// IWYU pragma: end_exports
+
+namespace playrho {
+
+/// @brief Tracer recording events for output in the Chrome trace event format.
+/// @details Records begin and end events along with when they happened and which thread
+///   they happened on. The recorded events can then be written out as JSON that the
+///   <code>chrome://tracing</code> viewer or the Perfetto UI can load. Each thread that
+///   events were recorded from gets its own lane ("tid") in the timeline.
+/// @note This is thread-safe.
+/// @note Events that can't be recorded, like for lack of memory, are dropped and counted.
+/// @see WriteFile.
+class ChromeTracer: public Tracer
+{
+public:
+    /// @brief Clock type.
+    using clock = std::chrono::steady_clock;
+
+    /// @brief Recorded event.
+    struct Event
+    {
+        const char* name{}; ///< Name of the event's scope.
+        char phase{}; ///< Phase: 'B' for begin or 'E' for end.
+        std::uint32_t lane{}; ///< Lane of the thread the event happened on.
+        std::chrono::nanoseconds time{}; ///< When the event happened since the epoch.
+    };
+
+    /// @brief Default constructor.
+    /// @post <code>GetEpoch()</code> returns the time of construction.
+    ChromeTracer();
+
+    void Begin(const char* name) noexcept override;
+
+    void End(const char* name) noexcept override;
+
+    /// @brief Gets the time that recorded event times are relative to.
+    clock::time_point GetEpoch() const noexcept
+    {
+        return m_epoch;
+    }
+
+    /// @brief Gets a copy of the events recorded so far.
+    std::vector<Event> GetEvents() const;
+
+    /// @brief Gets the number of events recorded so far.
+    std::size_t GetEventCount() const;
+
+    /// @brief Gets the number of events that were dropped instead of being recorded.
+    std::size_t GetDroppedEventCount() const noexcept
+    {
+        return m_dropped;
+    }
+
+    /// @brief Clears the recorded events.
+    void Clear();
+
+    /// @brief Writes the recorded events to the given stream as a JSON object.
+    void Write(std::ostream& os) const;
+
+private:
+    /// @brief Records an event of the given name & phase.
+    /// @details Drops the event if it can't be recorded.
+    void Record(const char* name, char phase) noexcept;
+
+    clock::time_point m_epoch; ///< Time recorded event times are relative to.
+    mutable std::mutex m_mutex; ///< Mutex protecting the following members.
+    std::vector<Event> m_events; ///< Recorded events.
+    std::vector<std::pair<std::thread::id, std::uint32_t>> m_lanes; ///< Threads' lanes.
+    std::atomic<std::size_t> m_dropped{}; ///< Count of dropped events.
+};
+
+/// @brief Writes the events recorded by the given tracer to the named file.
+/// @throws InvalidArgument if the named file could not be opened for writing.
+/// @throws std::ios_base::failure if writing the file failed.
+/// @relatedalso ChromeTracer
+void WriteFile(const ChromeTracer& tracer, const std::string& path);
+
+} // namespace playrho
+
+#endif // PLAYRHO_CHROMETRACER_HPP
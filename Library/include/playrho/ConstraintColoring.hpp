@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef PLAYRHO_CONSTRAINTCOLORING_HPP
+#define PLAYRHO_CONSTRAINTCOLORING_HPP
+
+/// @file
+/// @brief Declarations of the constraint graph coloring types and functions.
+
+#include <array>
+#include <cstddef> // for std::size_t
+#include <vector>
+
+// IWYU pragma: begin_exports
+
+#include <playrho/BodyID.hpp>
+#include <playrho/Span.hpp>
+
+// IWYU pragma: end_exports
+
+namespace playrho {
+
+/// @brief Identifiers of the bodies that solving a constraint changes.
+/// @details Elements that aren't used, like those for bodies that solving the constraint
+///   never writes to, are <code>InvalidBodyID</code>.
+using ConstraintBodies = std::array<BodyID, 4>;
+
+/// @brief Maximum number of colors that <code>GetConstraintColors</code> uses.
+constexpr auto MaxConstraintColors = std::size_t{64};
+
+/// @brief Constraints partitioned into colors.
+/// @see GetConstraintColors.
+struct ConstraintColors
+{
+    /// @brief Indices of the constraints of each color.
+    /// @details No two constraints of the same color share a body, so the constraints of a
+    ///   color can be solved concurrently. Indices are in increasing order.
+    std::vector<std::vector<std::size_t>> colors;
+
+    /// @brief Indices of the constraints that couldn't be given a color.
+    /// @details These have to be solved one at a time. Indices are in increasing order.
+    std::vector<std::size_t> uncolored;
+};
+
+/// @brief Gets the given constraints partitioned into colors.
+/// @details Greedily gives each constraint, in order, the lowest color that none of the
+///   constraint's bodies already have a constraint of. Earlier colors thereby tend to
+///   have more constraints than later ones.
+/// @param constraints Bodies of the constraints to color.
+/// @param bodyCount Number of bodies. All valid identifiers of the given constraints'
+///   bodies must be less than this.
+/// @note Constraints whose bodies together already have constraints of every one of
+///   <code>MaxConstraintColors</code> colors are left uncolored.
+/// @relatedalso ConstraintColors
+ConstraintColors GetConstraintColors(const Span<const ConstraintBodies>& constraints,
+                                     std::size_t bodyCount);
+
+} // namespace playrho
+
+#endif // PLAYRHO_CONSTRAINTCOLORING_HPP
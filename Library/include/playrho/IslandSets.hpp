@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef PLAYRHO_ISLANDSETS_HPP
+#define PLAYRHO_ISLANDSETS_HPP
+
+/// @file
+/// @brief Definition of the @c IslandSets class and related code.
+
+#include <vector>
+
+// IWYU pragma: begin_exports
+
+#include <playrho/BodyID.hpp>
+#include <playrho/ContactID.hpp>
+#include <playrho/JointID.hpp>
+#include <playrho/Settings.hpp> // for BodyCounter
+
+// IWYU pragma: end_exports
+
+namespace playrho {
+
+/// @brief Persistent disjoint sets of bodies.
+/// @details This is a union-find structure of bodies that additionally links the members
+///   of every set into a circular list so they can be iterated over without needing
+///   to traverse the constraint graph. The contacts and joints linked to a set are listed
+///   similarly. It's intended for maintaining islands incrementally: sets are joined as
+///   constraints between bodies get linked and flagged for splitting as constraints get
+///   unlinked. Flagged sets are a superset of an actual island until the user re-partitions
+///   them.
+/// @note Every element starts out as its own singleton set.
+/// @see Island.
+class IslandSets
+{
+public:
+    /// @brief Size type.
+    using size_type = BodyCounter;
+
+    /// @brief Gets the number of elements.
+    size_type size() const noexcept
+    {
+        return static_cast<size_type>(m_entries.size());
+    }
+
+    /// @brief Resizes to the given number of elements.
+    /// @details Any elements added are made into singleton sets.
+    /// @note Elements removed must already be singleton sets.
+    void resize(size_type count);
+
+    /// @brief Clears all the elements.
+    void clear() noexcept
+    {
+        m_entries.clear();
+        m_contacts.clear();
+        m_joints.clear();
+    }
+
+    /// @brief Makes the identified element into a singleton set.
+    /// @note This doesn't update the other members of the set that this element was in nor
+    ///   the constraints linked to that set. It's meant for re-partitioning all the members
+    ///   of a set after unlinking its constraints.
+    /// @pre @p id is less than <code>size()</code>.
+    void Reset(BodyID id) noexcept;
+
+    /// @brief Finds the representative element of the set the identified element is in.
+    /// @note This compresses the paths it visits.
+    /// @pre @p id is less than <code>size()</code>.
+    BodyID Find(BodyID id) noexcept;
+
+    /// @brief Joins the sets that the two identified elements are in.
+    /// @details The member lists of the identified elements are spliced together at the
+    ///   two given elements, and so are the lists of constraints linked to their sets. So an iteration of the members of the set of @p a that's
+    ///   at @p a when this is called, goes on to visit all the members of @p b as well.
+    /// @pre @p a and @p b are less than <code>size()</code>.
+    /// @return <code>true</code> if the sets were joined, <code>false</code> if the
+    ///   identified elements were already in the same set.
+    bool Join(BodyID a, BodyID b) noexcept;
+
+    /// @brief Gets the next member of the set the identified element is in.
+    /// @note Following the next members from any member eventually leads back to it.
+    /// @pre @p id is less than <code>size()</code>.
+    BodyID GetNext(BodyID id) const noexcept
+    {
+        return m_entries[to_underlying(id)].next;
+    }
+
+    /// @brief Gets the number of members of the set the identified element is in.
+    /// @pre @p id is less than <code>size()</code>.
+    size_type GetSize(BodyID id) noexcept
+    {
+        return m_entries[to_underlying(Find(id))].size;
+    }
+
+    /// @brief Flags the set the identified element is in for splitting.
+    /// @details This is for recording that a constraint between members got removed so the
+    ///   set may no longer be a single island.
+    /// @see Unlink.
+    /// @pre @p id is less than <code>size()</code>.
+    void FlagForSplitting(BodyID id) noexcept
+    {
+        m_entries[to_underlying(Find(id))].needsSplitting = true;
+    }
+
+    /// @brief Whether the set the identified element is in has been flagged for splitting.
+    /// @pre @p id is less than <code>size()</code>.
+    bool NeedsSplitting(BodyID id) noexcept
+    {
+        return m_entries[to_underlying(Find(id))].needsSplitting;
+    }
+
+    /// @brief Links the identified contact to the set the identified element is in.
+    /// @pre @p contact isn't already linked and @p id is less than <code>size()</code>.
+    void Link(ContactID contact, BodyID id);
+
+    /// @brief Links the identified joint to the set the identified element is in.
+    /// @pre @p joint isn't already linked and @p id is less than <code>size()</code>.
+    void Link(JointID joint, BodyID id);
+
+    /// @brief Unlinks the identified contact from the set it's linked to.
+    /// @details This also flags that set for splitting.
+    /// @pre @p contact is linked.
+    void Unlink(ContactID contact) noexcept;
+
+    /// @brief Unlinks the identified joint from the set it's linked to.
+    /// @details This also flags that set for splitting.
+    /// @pre @p joint is linked.
+    void Unlink(JointID joint) noexcept;
+
+    /// @brief Whether the identified contact is linked to a set.
+    bool IsLinked(ContactID contact) const noexcept
+    {
+        return (to_underlying(contact) < m_contacts.size()) &&
+               IsValid(m_contacts[to_underlying(contact)].owner);
+    }
+
+    /// @brief Whether the identified joint is linked to a set.
+    bool IsLinked(JointID joint) const noexcept
+    {
+        return (to_underlying(joint) < m_joints.size()) &&
+               IsValid(m_joints[to_underlying(joint)].owner);
+    }
+
+    /// @brief Gets the first contact linked to the set the identified element is in.
+    /// @return Invalid contact ID if no contacts are linked to the set.
+    /// @pre @p id is less than <code>size()</code>.
+    ContactID GetContact(BodyID id) noexcept
+    {
+        return m_entries[to_underlying(Find(id))].contact;
+    }
+
+    /// @brief Gets the first joint linked to the set the identified element is in.
+    /// @return Invalid joint ID if no joints are linked to the set.
+    /// @pre @p id is less than <code>size()</code>.
+    JointID GetJoint(BodyID id) noexcept
+    {
+        return m_entries[to_underlying(Find(id))].joint;
+    }
+
+    /// @brief Gets the next contact linked to the same set as the identified contact.
+    /// @note Following the next contacts from any contact eventually leads back to it.
+    /// @pre @p contact is linked.
+    ContactID GetNext(ContactID contact) const noexcept
+    {
+        return m_contacts[to_underlying(contact)].next;
+    }
+
+    /// @brief Gets the next joint linked to the same set as the identified joint.
+    /// @note Following the next joints from any joint eventually leads back to it.
+    /// @pre @p joint is linked.
+    JointID GetNext(JointID joint) const noexcept
+    {
+        return m_joints[to_underlying(joint)].next;
+    }
+
+private:
+    /// @brief Per element data.
+    struct Entry
+    {
+        BodyID parent; ///< Parent element. Self for representative elements.
+        BodyID next; ///< Next member of the set this element is in.
+        size_type size = 1; ///< Number of members. Only valid for representative elements.
+        bool needsSplitting = false; ///< Only valid for representative elements.
+        ContactID contact = InvalidContactID; ///< Only valid for representative elements.
+        JointID joint = InvalidJointID; ///< Only valid for representative elements.
+    };
+
+    /// @brief Per constraint data.
+    template <class ID>
+    struct Node
+    {
+        ID prev; ///< Previous constraint linked to the same set.
+        ID next; ///< Next constraint linked to the same set.
+        BodyID owner = InvalidBodyID; ///< Member of the set this is linked to, if linked.
+    };
+
+    std::vector<Entry> m_entries; ///< Per element data.
+    std::vector<Node<ContactID>> m_contacts; ///< Per contact data.
+    std::vector<Node<JointID>> m_joints; ///< Per joint data.
+};
+
+} // namespace playrho
+
+#endif // PLAYRHO_ISLANDSETS_HPP
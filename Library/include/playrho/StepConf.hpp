@@ -127,12 +127,24 @@ struct StepConf {
     /// @brief Default curcles ratio.
     static constexpr auto DefaultCirclesRatio = Real(playrho::DefaultCirclesRatio);
 
+    /// @brief Default soft contact frequency.
+    static constexpr auto DefaultSoftContactFrequency = Frequency{30_Hz};
+
+    /// @brief Default soft contact damping ratio.
+    static constexpr auto DefaultSoftContactDampingRatio = Real(10);
+
+    /// @brief Default soft contact push speed.
+    static constexpr auto DefaultSoftContactPushSpeed = LinearVelocity{3_mps};
+
     /// @brief Default regular velocity iterations.
     static constexpr auto DefaultRegVelocityIters = iteration_type{8};
 
     /// @brief Default regular position iterations.
     static constexpr auto DefaultRegPositionIters = iteration_type{3};
 
+    /// @brief Default regular sub-steps.
+    static constexpr auto DefaultRegSubSteps = iteration_type{0};
+
     /// @brief Default time of impact velocity iterations.
     static constexpr auto DefaultToiVelocityIters = iteration_type{8};
 
@@ -160,6 +172,18 @@ struct StepConf {
     /// @brief Default do block-solve processing value .
     static constexpr auto DefaultDoBlocksolve = true;
 
+    /// @brief Default do wide velocity solving value.
+    static constexpr auto DefaultDoWideVelocitySolve = false;
+
+    /// @brief Default do colored island solving value.
+    static constexpr auto DefaultDoColoredIslandSolve = false;
+
+    /// @brief Default do joint batching value.
+    static constexpr auto DefaultDoJointBatching = false;
+
+    /// @brief Default do timing value.
+    static constexpr auto DefaultDoTiming = false;
+
     /// @brief Delta time.
     /// @details This is the time step in seconds.
     Time deltaTime = DefaultStepTime;
@@ -206,6 +230,27 @@ struct StepConf {
     /// @brief Regular-phase minimum momentum.
     Momentum regMinMomentum = DefaultRegMinMomentum;
 
+    /// @brief Soft contact frequency.
+    /// @details Natural frequency at which overlapping shapes are pushed apart by the
+    ///   soft-step solver. It's capped at a quarter of the sub-step rate.
+    /// @note Used in the regular phase of step processing when sub-stepping.
+    /// @see regSubSteps.
+    Frequency softContactFrequency = DefaultSoftContactFrequency;
+
+    /// @brief Soft contact damping ratio.
+    /// @details Damping ratio with which overlapping shapes are pushed apart by the
+    ///   soft-step solver. Values greater than one are over-damped and so push shapes apart
+    ///   without making them bounce.
+    /// @note Used in the regular phase of step processing when sub-stepping.
+    /// @see regSubSteps.
+    Real softContactDampingRatio = DefaultSoftContactDampingRatio;
+
+    /// @brief Soft contact push speed.
+    /// @details Maximum speed at which the soft-step solver pushes overlapping shapes apart.
+    /// @note Used in the regular phase of step processing when sub-stepping.
+    /// @see regSubSteps.
+    LinearVelocity softContactPushSpeed = DefaultSoftContactPushSpeed;
+
     /// @brief Time of impact resolution rate.
     /// @details
     /// This scale factor controls how fast positional overlap is resolved.
@@ -337,6 +382,21 @@ struct StepConf {
     /// @see regMinSeparation.
     iteration_type regPositionIters = DefaultRegPositionIters;
 
+    /// @brief Regular sub-steps.
+    /// @details Zero selects the regular phase's Gauss-Seidel solver which does the regular
+    ///   velocity iterations followed by the regular position iterations. Any other value
+    ///   selects the soft-step solver instead. That divides the step into this many sub-steps
+    ///   and, for each of them, does one velocity iteration that pushes overlapping shapes
+    ///   apart softly and one that relaxes that push. It has no separate contact position
+    ///   iterations, so <code>regVelocityIters</code> and <code>regPositionIters</code> aren't
+    ///   used. Stacks are usually as stable with four sub-steps as with the default iterations
+    ///   of the Gauss-Seidel solver.
+    /// @note Used in the regular phase of step processing.
+    /// @note The wide velocity and colored island solving options only apply to the
+    ///   Gauss-Seidel solver.
+    /// @see softContactFrequency, softContactDampingRatio, softContactPushSpeed.
+    iteration_type regSubSteps = DefaultRegSubSteps;
+
     /// @brief TOI velocity iterations.
     /// @details
     /// This is the number of iterations of velocity resolution that will be done in the step.
@@ -376,6 +436,8 @@ struct StepConf {
     /// @brief Do warm start.
     /// @details Whether or not to perform warm starting (in the regular phase).
     /// @note Used in the regular phase of step processing.
+    /// @note When sub-stepping, this applies to every sub-step.
+    /// @see regSubSteps.
     bool doWarmStart = DefaultDoWarmStart;
 
     /// @brief Do time of impact (TOI) calculations.
@@ -389,6 +451,43 @@ struct StepConf {
 
     /// @brief Do the block-solve algorithm.
     bool doBlocksolve = DefaultDoBlocksolve;
+
+    /// @brief Do wide velocity solving.
+    /// @details Whether or not to solve the velocity constraints of contacts in bundles of
+    ///   constraints that don't share movable bodies, several constraints at once. This can be
+    ///   faster for islands having many contacts, but solves the constraints in a different
+    ///   order so results differ slightly from those of solving them one at a time.
+    /// @note Used in the regular phase of step processing.
+    /// @see WideVelocityConstraints.
+    bool doWideVelocitySolve = DefaultDoWideVelocitySolve;
+
+    /// @brief Do colored island solving.
+    /// @details Whether or not to split the constraints of an island into colors of
+    ///   constraints that don't share bodies and solve each color's constraints concurrently.
+    ///   This lets a single big island make use of a world's task scheduler. It's only done
+    ///   for islands that aren't already being solved concurrently with other islands.
+    ///   Constraints are solved in a different order so results differ slightly from those
+    ///   of solving them one at a time.
+    /// @note Used in the regular phase of step processing.
+    /// @note Overrides <code>doWideVelocitySolve</code> for the islands it's done for.
+    /// @see WorldConf::taskScheduler, GetConstraintColors.
+    bool doColoredIslandSolve = DefaultDoColoredIslandSolve;
+
+    /// @brief Do joint batching.
+    /// @details Whether or not to group the joints of an island by type and solve each
+    ///   group in turn, calling the solver functions of the library provided joint types
+    ///   directly instead of through the type-erased joint interface. This saves a virtual
+    ///   call per joint per iteration, but solves joints of different types in a different
+    ///   order so results differ slightly from those of solving them in island order.
+    /// @note Used in the regular phase of step processing.
+    /// @note Ignored for the islands that colored island solving is done for.
+    bool doJointBatching = DefaultDoJointBatching;
+
+    /// @brief Do timing.
+    /// @details Whether or not to measure how long each of the phases of the step takes.
+    /// @note Used in all of the phases of step processing.
+    /// @see StepStats::times.
+    bool doTiming = DefaultDoTiming;
 };
 
 // Basic requirements...
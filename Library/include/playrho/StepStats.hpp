@@ -24,6 +24,7 @@
 /// @file
 /// @brief Definition of the @c StepStats related classes and code.
 
+#include <chrono> // for std::chrono::nanoseconds
 #include <cstdint> // for std::uint32_t
 #include <limits> // for std::numeric_limits
 #include <type_traits> // for std::remove_const_t
@@ -177,6 +178,30 @@ constexpr auto operator!=(const ToiStepStats &lhs, const ToiStepStats &rhs) -> b
     return !(lhs == rhs);
 }
 
+/// @brief Per-phase step times.
+/// @details These are how long each of the phases of a step took. They're only measured
+///   for steps whose configuration asks for them, so steps not asking for them don't pay
+///   for reading the clock.
+/// @note Phases that happen more than once per step, like contact updating which happens
+///   before and after the regular phase's solving, have their times summed.
+/// @note The solve times are summed over the islands. When islands are solved concurrently
+///   they can add up to more than the time that passed.
+/// @see StepConf::doTiming.
+struct StepTimes {
+    /// @brief Duration type.
+    using duration = std::chrono::nanoseconds;
+
+    duration proxyCreation{}; ///< Time creating the proxies of new shapes.
+    duration proxySync{}; ///< Time synchronizing the proxies of moved bodies.
+    duration contactDestroy{}; ///< Time destroying contacts that stopped overlapping.
+    duration contactUpdate{}; ///< Time updating the manifolds of contacts.
+    duration pairFinding{}; ///< Time finding and adding new contacts.
+    duration islandBuilding{}; ///< Time building the regular phase's islands.
+    duration velocitySolve{}; ///< Time solving the regular phase's velocity constraints.
+    duration positionSolve{}; ///< Time solving the regular phase's position constraints.
+    duration toi{}; ///< Time solving the time of impact (TOI) phase.
+};
+
 /// @brief Per-step statistics.
 /// @details These are statistics output from the <code>d2::World::Step</code> function.
 /// @note Efficient transfer of this data is predicated on compiler support for
@@ -188,6 +213,7 @@ struct StepStats {
     PreStepStats pre; ///< Pre-phase step statistics.
     RegStepStats reg; ///< Reg-phase step statistics.
     ToiStepStats toi; ///< TOI-phase step statistics.
+    StepTimes times; ///< Per-phase step times.
 };
 
 struct IslandStats;
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef PLAYRHO_TASKSCHEDULER_HPP
+#define PLAYRHO_TASKSCHEDULER_HPP
+
+/// @file
+/// @brief Definition of the @c TaskScheduler class and related code.
+
+#include <cstddef> // for std::size_t
+#include <functional> // for std::function
+
+// IWYU pragma: begin_exports
+
+#include <playrho/Span.hpp>
+
+// IWYU pragma: end_exports
+
+namespace playrho {
+
+/// @brief Interface to a user supplied task scheduler.
+/// @details This is how the library gets work done concurrently. The library doesn't create
+///   any threads of its own. Instead, users wanting to make use of multiple cores can provide
+///   an implementation of this interface that hands the given tasks off to whatever threads
+///   or job system they already have.
+/// @note Tasks given to a scheduler by the library never share mutable state with each other,
+///   so implementations are free to run them in any order and on any threads.
+/// @see WorldConf::taskScheduler.
+class TaskScheduler
+{
+public:
+    /// @brief Size type.
+    using size_type = std::size_t;
+
+    /// @brief Task type.
+    using Task = std::function<void()>;
+
+    /// @brief Range function type.
+    /// @details Called with the first and one-past-the-last indices of a range to process.
+    using RangeFunction = std::function<void(size_type first, size_type last)>;
+
+    /// @brief Destructor.
+    virtual ~TaskScheduler() noexcept;
+
+    /// @brief Gets the number of tasks this scheduler can run at the same time.
+    /// @note The library uses this to decide how many pieces to split work into.
+    ///   A value of 0 is treated like 1.
+    virtual size_type GetConcurrency() const noexcept = 0;
+
+    /// @brief Runs the given group of tasks, returning only after they've all completed.
+    /// @details The calling thread may run some or all of the tasks itself.
+    /// @note If a task throws, implementations are expected to wait for the other tasks
+    ///   to complete before rethrowing the exception from this function.
+    virtual void Run(const Span<const Task>& tasks) = 0;
+
+    /// @brief Calls the given function for sub-ranges covering the range <code>[0, count)</code>.
+    /// @details The default implementation splits the range into up to
+    ///   <code>GetConcurrency()</code> contiguous sub-ranges and runs them as a task group
+    ///   via <code>Run</code>. Implementations having a native parallel-for may override this.
+    /// @post Every index in <code>[0, count)</code> was covered by exactly one call.
+    virtual void ParallelFor(size_type count, const RangeFunction& function);
+};
+
+} // namespace playrho
+
+#endif // PLAYRHO_TASKSCHEDULER_HPP
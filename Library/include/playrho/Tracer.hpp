@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef PLAYRHO_TRACER_HPP
+#define PLAYRHO_TRACER_HPP
+
+/// @file
+/// @brief Definition of the @c Tracer class and related code.
+
+namespace playrho {
+
+/// @brief Interface to a user supplied tracer.
+/// @details This is how the library reports the begin and end of the phases of stepping a
+///   world, so that timelines of steps can be recorded and inspected.
+/// @note Names given to a tracer by the library are string literals. They're valid for the
+///   life of the program and can be kept by pointer.
+/// @note When a task scheduler is also being used, implementations must be thread-safe as
+///   they'll get called from whatever threads run the scheduled tasks.
+/// @note Implementations can't throw. Tracing mustn't get in the way of stepping, and
+///   <code>End</code> gets called while unwinding from exceptions thrown during steps.
+/// @see WorldConf::tracer, TraceScope.
+class Tracer
+{
+public:
+    /// @brief Destructor.
+    virtual ~Tracer() noexcept;
+
+    /// @brief Called at the beginning of the named scope.
+    virtual void Begin(const char* name) noexcept = 0;
+
+    /// @brief Called at the end of the named scope.
+    /// @note Always called on the same thread as the matching call to <code>Begin</code>.
+    virtual void End(const char* name) noexcept = 0;
+};
+
+/// @brief Scoped tracing of the given named scope.
+/// @details Calls <code>Begin</code> on the given tracer on construction and calls
+///   <code>End</code> on destruction. Does nothing if given a null tracer.
+class TraceScope
+{
+public:
+    /// @brief Initializing constructor.
+    TraceScope(Tracer* tracer, const char* name) noexcept: m_tracer{tracer}, m_name{name}
+    {
+        if (m_tracer) {
+            m_tracer->Begin(m_name);
+        }
+    }
+
+    TraceScope(const TraceScope& other) = delete;
+
+    TraceScope& operator=(const TraceScope& other) = delete;
+
+    /// @brief Destructor.
+    ~TraceScope() noexcept
+    {
+        if (m_tracer) {
+            m_tracer->End(m_name);
+        }
+    }
+
+private:
+    Tracer* m_tracer{}; ///< Tracer or null.
+    const char* m_name{}; ///< Name of the traced scope.
+};
+
+} // namespace playrho
+
+#endif // PLAYRHO_TRACER_HPP
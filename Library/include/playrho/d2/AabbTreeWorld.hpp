@@ -27,6 +27,7 @@
 
 #include <cstdint> // for std::uint32_t
 #include <map>
+#include <memory> // for std::unique_ptr
 #include <optional>
 #include <tuple>
 #include <type_traits> // for std::is_default_constructible_v, etc.
@@ -46,6 +47,7 @@
 #include <playrho/JointID.hpp>
 #include <playrho/Interval.hpp>
 #include <playrho/Island.hpp>
+#include <playrho/IslandSets.hpp>
 #include <playrho/IslandStats.hpp>
 #include <playrho/KeyedContactID.hpp>
 #include <playrho/ObjectPool.hpp>
@@ -61,17 +63,22 @@
 #include <playrho/ZeroToUnderOne.hpp>
 
 #include <playrho/pmr/MemoryResource.hpp>
+#include <playrho/pmr/MonotonicMemoryResource.hpp>
 #include <playrho/pmr/PoolMemoryResource.hpp>
 #include <playrho/pmr/StatsResource.hpp>
 
 #include <playrho/d2/Body.hpp>
 #include <playrho/d2/BodyConstraint.hpp>
+#include <playrho/d2/BodyStateSpans.hpp>
+#include <playrho/d2/ContactEvents.hpp>
 #include <playrho/d2/ContactImpulsesFunction.hpp>
 #include <playrho/d2/ContactManifoldFunction.hpp>
+#include <playrho/d2/DistanceProxy.hpp>
 #include <playrho/d2/DynamicTree.hpp>
 #include <playrho/d2/Joint.hpp>
 #include <playrho/d2/Shape.hpp>
 #include <playrho/d2/Transformation.hpp>
+#include <playrho/d2/WideDynamicTree.hpp>
 #include <playrho/d2/WorldConf.hpp>
 
 // IWYU pragma: end_exports
@@ -154,6 +161,18 @@ bool operator!=(const AabbTreeWorld& lhs, const AabbTreeWorld& rhs);
 /// @brief Gets the resource statistics of the specified world.
 std::optional<pmr::StatsResource::Stats> GetResourceStats(const AabbTreeWorld& world) noexcept;
 
+/// @brief Gets the contact events recorded by the specified world since its last step began,
+///   and any that were recorded before that but after the step before it.
+/// @note These are always empty unless the world was configured to record them.
+/// @see WorldConf::doContactEvents.
+const ContactEvents& GetContactEvents(const AabbTreeWorld& world) noexcept;
+
+/// @brief Gets the step arena statistics of the specified world.
+/// @return Empty value if the world wasn't configured to use a step arena.
+/// @see WorldConf::doStepArena.
+std::optional<pmr::MonotonicMemoryResource::Stats>
+GetStepArenaStats(const AabbTreeWorld& world) noexcept;
+
 /// @brief Clears this world.
 /// @note This calls the joint and shape destruction listeners (if they're set), for all
 ///   defined joints and shapes, before clearing anything. Any exceptions thrown from these
@@ -316,6 +335,89 @@ const Body& GetBody(const AabbTreeWorld& world, BodyID id);
 /// @see GetBody, GetBodyRange.
 void SetBody(AabbTreeWorld& world, BodyID id, Body value);
 
+/// @brief Sets the transformation of the identified body in place.
+/// @details This is like getting the body, setting its transformation, and setting it back
+///   via <code>SetBody</code> but without copying the body.
+/// @throws WrongState if this function is called while the world is locked.
+/// @throws std::out_of_range if given an invalid id.
+/// @throws InvalidArgument if the specified ID was destroyed.
+/// @see SetBody, GetBody.
+void SetTransformation(AabbTreeWorld& world, BodyID id, const Transformation& value);
+
+/// @brief Sets the velocity of the identified body in place.
+/// @throws WrongState if this function is called while the world is locked.
+/// @throws std::out_of_range if given an invalid id.
+/// @throws InvalidArgument if the specified ID was destroyed.
+/// @see SetTransformation(AabbTreeWorld&, BodyID, const Transformation&).
+void SetVelocity(AabbTreeWorld& world, BodyID id, const Velocity& value);
+
+/// @brief Sets the acceleration of the identified body in place.
+/// @throws WrongState if this function is called while the world is locked.
+/// @throws std::out_of_range if given an invalid id.
+/// @throws InvalidArgument if the specified ID was destroyed.
+/// @see SetTransformation(AabbTreeWorld&, BodyID, const Transformation&).
+void SetAcceleration(AabbTreeWorld& world, BodyID id, const Acceleration& value);
+
+/// @brief Sets or unsets the awake state of the identified body in place.
+/// @throws WrongState if this function is called while the world is locked.
+/// @throws std::out_of_range if given an invalid id.
+/// @throws InvalidArgument if the specified ID was destroyed.
+/// @see SetTransformation(AabbTreeWorld&, BodyID, const Transformation&).
+void SetAwake(AabbTreeWorld& world, BodyID id, bool value);
+
+/// @brief Sets or unsets the impenetrable state of the identified body in place.
+/// @throws WrongState if this function is called while the world is locked.
+/// @throws std::out_of_range if given an invalid id.
+/// @throws InvalidArgument if the specified ID was destroyed.
+/// @see SetTransformation(AabbTreeWorld&, BodyID, const Transformation&).
+void SetImpenetrable(AabbTreeWorld& world, BodyID id, bool value);
+
+/// @brief Sets whether the identified body is allowed to sleep in place.
+/// @throws WrongState if this function is called while the world is locked.
+/// @throws std::out_of_range if given an invalid id.
+/// @throws InvalidArgument if the specified ID was destroyed.
+/// @see SetTransformation(AabbTreeWorld&, BodyID, const Transformation&).
+void SetSleepingAllowed(AabbTreeWorld& world, BodyID id, bool value);
+
+/// @brief Applies the given linear impulse at the given point to the identified body
+///   in place.
+/// @throws WrongState if this function is called while the world is locked.
+/// @throws std::out_of_range if given an invalid id.
+/// @throws InvalidArgument if the specified ID was destroyed.
+/// @see ApplyLinearImpulse(Body&, const Momentum2&, const Length2&).
+void ApplyLinearImpulse(AabbTreeWorld& world, BodyID id, const Momentum2& impulse,
+                        const Length2& point);
+
+/// @brief Applies the given angular impulse to the identified body in place.
+/// @throws WrongState if this function is called while the world is locked.
+/// @throws std::out_of_range if given an invalid id.
+/// @throws InvalidArgument if the specified ID was destroyed.
+/// @see ApplyAngularImpulse(Body&, AngularMomentum).
+void ApplyAngularImpulse(AabbTreeWorld& world, BodyID id, AngularMomentum impulse);
+
+/// @brief Gets the states of the identified bodies.
+/// @details Fills each non-empty span of the given states with the values of the
+///   identified bodies, in the order of the given identifiers.
+/// @throws InvalidArgument if a non-empty span of @p states doesn't have the same size as
+///   @p ids.
+/// @throws std::out_of_range if any of the given identifiers are invalid.
+/// @see SetBodyStates(AabbTreeWorld&, Span<const BodyID>, const ConstBodyStateSpans&).
+void GetBodyStates(const AabbTreeWorld& world, Span<const BodyID> ids,
+                   const BodyStateSpans& states);
+
+/// @brief Sets the states of the identified bodies in place.
+/// @details Sets the identified bodies' values from each non-empty span of the given states,
+///   like calling the single body setters for each of them would do.
+/// @note A body whose location or angle is set, but not both, keeps its other value.
+/// @throws WrongState if this function is called while the world is locked.
+/// @throws InvalidArgument if a non-empty span of @p states doesn't have the same size as
+///   @p ids, or if any of the identified bodies were destroyed.
+/// @throws std::out_of_range if any of the given identifiers are invalid.
+/// @post Nothing's been set if this throws.
+/// @see GetBodyStates(const AabbTreeWorld&, Span<const BodyID>, const BodyStateSpans&).
+void SetBodyStates(AabbTreeWorld& world, Span<const BodyID> ids,
+                   const ConstBodyStateSpans& states);
+
 /// @brief Destroys the identified body.
 /// @details Destroys a given body that had previously been created by a call to this
 ///   world's <code>CreateBody(const Body&)</code> function.
@@ -601,6 +703,9 @@ public:
     friend bool operator==(const AabbTreeWorld& lhs, const AabbTreeWorld& rhs);
     friend bool operator!=(const AabbTreeWorld& lhs, const AabbTreeWorld& rhs);
     friend std::optional<pmr::StatsResource::Stats> GetResourceStats(const AabbTreeWorld& world) noexcept;
+    friend std::optional<pmr::MonotonicMemoryResource::Stats>
+    GetStepArenaStats(const AabbTreeWorld& world) noexcept;
+    friend const ContactEvents& GetContactEvents(const AabbTreeWorld& world) noexcept;
     friend void Clear(AabbTreeWorld& world) noexcept;
     friend StepStats Step(AabbTreeWorld& world, const StepConf& conf);
     friend bool IsStepComplete(const AabbTreeWorld& world) noexcept;
@@ -621,6 +726,17 @@ public:
     friend BodyID CreateBody(AabbTreeWorld& world, Body body);
     friend const Body& GetBody(const AabbTreeWorld& world, BodyID id);
     friend void SetBody(AabbTreeWorld& world, BodyID id, Body value);
+    friend void SetTransformation(AabbTreeWorld& world, BodyID id, const Transformation& value);
+    friend void SetVelocity(AabbTreeWorld& world, BodyID id, const Velocity& value);
+    friend void SetAcceleration(AabbTreeWorld& world, BodyID id, const Acceleration& value);
+    friend void SetAwake(AabbTreeWorld& world, BodyID id, bool value);
+    friend void SetImpenetrable(AabbTreeWorld& world, BodyID id, bool value);
+    friend void SetSleepingAllowed(AabbTreeWorld& world, BodyID id, bool value);
+    friend void ApplyLinearImpulse(AabbTreeWorld& world, BodyID id, const Momentum2& impulse,
+                                   const Length2& point);
+    friend void ApplyAngularImpulse(AabbTreeWorld& world, BodyID id, AngularMomentum impulse);
+    friend void SetBodyStates(AabbTreeWorld& world, Span<const BodyID> ids,
+                              const ConstBodyStateSpans& states);
     friend void Destroy(AabbTreeWorld& world, BodyID id);
     friend const ProxyIDs& GetProxies(const AabbTreeWorld& world, BodyID id);
     friend const BodyContactIDs& GetContacts(const AabbTreeWorld& world, BodyID id);
@@ -701,52 +817,142 @@ private:
     ///   through each other.
     /// @pre <code>IsLocked(const AabbTreeWorld&)</code> & <code>IsStepComplete(const AabbTreeWorld&)</code>
     ///   return true for this world.
+    /// @param conf Time step configuration to use.
+    /// @param times Phase times to add to if <code>conf.doTiming</code> is true.
     /// @post No contact in the world needs updating.
-    RegStepStats SolveReg(const StepConf& conf);
+    RegStepStats SolveReg(const StepConf& conf, StepTimes& times);
+
+    /// @brief Resources for solving islands.
+    /// @details Islands that are solved concurrently with each other need their own.
+    struct IslandSolverResources
+    {
+        pmr::memory_resource* bodyConstraints{}; ///< For body constraints.
+        pmr::memory_resource* positionConstraints{}; ///< For position constraints.
+        pmr::memory_resource* velocityConstraints{}; ///< For velocity constraints.
+
+        /// @brief Map of body identifiers to island-local body constraint identifiers.
+        Span<BodyID> bodyConstraintIndices;
+    };
+
+    /// @brief Owned island solver resources for a batch of islands.
+    struct IslandBatchResources;
+
+    /// @brief Gets the memory resource to use for per-step scratch data.
+    /// @return The step arena if there is one and this world is being stepped,
+    ///   else the given resource.
+    /// @note Memory from the step arena is only good till the end of the step.
+    pmr::memory_resource& GetStepResource(pmr::memory_resource& resource) noexcept
+    {
+        return (m_stepArena && ((m_flags & e_locked) != 0u))? *m_stepArena: resource;
+    }
+
+    /// @brief Gets the collapsed tree to find contacts for the given number of proxies with.
+    /// @details When there are enough proxies compared to how many leaves the dynamic tree
+    ///   has, this rebuilds <code>m_wideTree</code> from it, if it's been modified since
+    ///   the last time, and returns that.
+    /// @return Pointer to <code>m_wideTree</code> or <code>nullptr</code> if the dynamic tree
+    ///   itself is better to find contacts with.
+    const WideDynamicTree* GetWideTree(std::size_t numProxies);
+
+    /// @brief Results of solving an island that are still to be written back to the world.
+    struct RegIslandSolution;
+
+    /// @brief Gets the island solver resources for the identified batch of islands.
+    /// @details The resources for the first batch are the world's own. Those for others
+    ///   are made as needed.
+    /// @note This is not thread-safe.
+    IslandSolverResources GetIslandSolverResources(std::size_t batch);
 
     /// @brief Solves the given island (regularly).
-    /// @details This:
-    ///   1. Updates every island-body's <code>sweep.pos0</code> to its <code>sweep.pos1</code>.
-    ///   2. Updates every island-body's <code>sweep.pos1</code> to the new normalized "solved"
-    ///      position for it.
-    ///   3. Updates every island-body's velocity to the new accelerated, dampened, and "solved"
-    ///      velocity for it.
-    ///   4. Synchronizes every island-body's transform (by updating it to transform one of the
-    ///      body's sweep).
-    ///   5. Reports to the listener (if non-null).
+    /// @details This solves the island's velocity and position constraints into the returned
+    ///   solution. Nothing but the island's joints is written to, so islands not sharing
+    ///   resources can be solved concurrently with each other.
+    /// @param conf Time step configuration information.
+    /// @param island Island of bodies, contacts, and joints to solve for. Must contain at least
+    ///   one body, contact, or joint.
+    /// @param resources Resources to solve the island with.
+    /// @param scheduler Scheduler to solve the island's constraints by color with, if
+    ///   <code>conf.doColoredIslandSolve</code> is true, or <code>nullptr</code>.
+    /// @pre <code>IsLocked(const AabbTreeWorld&)</code> & <code>IsStepComplete(const AabbTreeWorld&)</code>
+    ///   return true for this world.
+    /// @pre @p island contains at least one body, contact, or joint identifier.
+    /// @pre Every island-body's <code>sweep.pos0</code> has been updated to its <code>sweep.pos1</code>.
+    /// @see FinishRegIsland.
+    RegIslandSolution SolveRegIslandViaGS(const StepConf& conf, const Island& island,
+                                          const IslandSolverResources& resources,
+                                          TaskScheduler* scheduler = nullptr);
+
+    /// @brief Solves the given island (regularly) by sub-stepping.
+    /// @details This is the soft-step alternative to <code>SolveRegIslandViaGS</code>.
+    ///   It divides the step into <code>conf.regSubSteps</code> sub-steps. Each of these
+    ///   solves the velocity constraints once, pushing overlapping shapes apart with soft
+    ///   contacts, integrates the positions, and then solves the velocity constraints once
+    ///   more without pushing. There are no separate contact position iterations.
+    /// @note Joints aren't soft, so their positions are still corrected once per sub-step.
+    /// @note Impulses reported and kept for warm starting are those of a sub-step.
     /// @param conf Time step configuration information.
     /// @param island Island of bodies, contacts, and joints to solve for. Must contain at least
     ///   one body, contact, or joint.
+    /// @param resources Resources to solve the island with.
+    /// @pre <code>conf.regSubSteps</code> is greater than zero.
     /// @pre <code>IsLocked(const AabbTreeWorld&)</code> & <code>IsStepComplete(const AabbTreeWorld&)</code>
     ///   return true for this world.
     /// @pre @p island contains at least one body, contact, or joint identifier.
+    /// @pre Every island-body's <code>sweep.pos0</code> has been updated to its <code>sweep.pos1</code>.
+    /// @see FinishRegIsland, StepConf::regSubSteps.
+    RegIslandSolution SolveRegIslandViaSoftStep(const StepConf& conf, const Island& island,
+                                                const IslandSolverResources& resources);
+
+    /// @brief Finishes solving the given island by writing its solution back to the world.
+    /// @details This:
+    ///   1. Updates every island-body's <code>sweep.pos1</code> to the new "solved" position for it.
+    ///   2. Updates every island-body's velocity to the new accelerated, dampened, and "solved"
+    ///      velocity for it.
+    ///   3. Flags the contacts of moved bodies for updating.
+    ///   4. Reports to the listener (if non-null).
+    ///   5. Splits the island's set and puts its bodies to sleep as appropriate.
+    /// @note This is not thread-safe.
     /// @return Island solver results.
-    IslandStats SolveRegIslandViaGS(const StepConf& conf, const Island& island);
+    /// @see SolveRegIslandViaGS, SolveRegIslandViaSoftStep.
+    IslandStats FinishRegIsland(const StepConf& conf, const Island& island,
+                                const RegIslandSolution& solution);
 
     /// @brief Adds to the island based off of a given "seed" body.
-    /// @post Contacts are listed in the island in the order that bodies provide those contacts.
-    /// @post Joints are listed the island in the order that bodies provide those joints.
-    void AddToIsland(Island& island, BodyID seed,
-                     BodyCounter& remNumBodies,
-                     ContactCounter& remNumContacts,
-                     JointCounter& remNumJoints);
+    /// @details Adds the enabled members of the seed body's island set and the enabled
+    ///   contacts and joints linked to that set, rather than searching the constraint graph
+    ///   for them. Non-speedable bodies of those constraints get added too.
+    /// @post Contacts are listed in the island in the order they were linked to the set.
+    /// @post Joints are listed the island in the order they were linked to the set.
+    /// @see m_islandSets.
+    void AddToIsland(Island& island, BodyID seed);
+
+    /// @brief Adds the identified non-speedable body to the island if not already added.
+    /// @note Does nothing for the invalid body ID or for bodies already added.
+    void AddStaticToIsland(Island& island, BodyID bodyID);
 
     /// @brief Body stack.
     using BodyStack = std::vector<BodyID, pmr::polymorphic_allocator<BodyID>>;
 
-    /// @brief Adds to the island.
-    void AddToIsland(Island& island, BodyStack& stack,
-                     BodyCounter& remNumBodies,
-                     ContactCounter& remNumContacts,
-                     JointCounter& remNumJoints);
+    /// @brief Links the identified touching contact to the island sets of its bodies.
+    /// @details Joins the sets of the contact's bodies if they're both speedable.
+    void LinkToIsland(ContactID id);
+
+    /// @brief Links the identified joint to the island sets of its bodies.
+    /// @details Joins the sets of the joint's bodies if they're both speedable.
+    /// @note Joints of bodies that aren't speedable don't get linked.
+    void LinkToIsland(JointID id);
+
+    /// @brief Unlinks the identified contact from its island set if linked.
+    /// @details This flags the set for splitting.
+    void UnlinkFromIsland(ContactID id);
 
-    /// @brief Adds contacts of identified body to island & adds other contacted bodies to body stack.
-    void AddContactsToIsland(Island& island, BodyStack& stack,
-                             const BodyContactIDs& contacts,
-                             BodyID bodyID);
+    /// @brief Unlinks the identified joint from its island set if linked.
+    /// @details This flags the set for splitting.
+    void UnlinkFromIsland(JointID id);
 
-    /// @brief Adds joints to the island.
-    void AddJointsToIsland(Island& island, BodyStack& stack, const BodyJointIDs& joints);
+    /// @brief Re-partitions the island set of the identified body into the sets of bodies
+    ///   that are still connected together by the constraints linked to it.
+    void SplitIsland(BodyID id);
 
     /// @brief Solves the step using successive time of impact (TOI) events.
     /// @details Used for continuous physics.
@@ -759,6 +965,8 @@ private:
 
     /// @brief Solves collisions for the given time of impact.
     /// @param contactID Identifier of contact to solve for.
+    /// @param island Island to build for the contact. The bodies this leaves in it, that are
+    ///   still flagged as islanded, are the ones that got moved.
     /// @param conf Time step configuration to solve for.
     /// @pre <code>IsLocked(const AabbTreeWorld&)</code> returns true for this world.
     /// @pre The identified contact has a valid TOI, is enabled, is awake, and is impenetrable.
@@ -767,7 +975,7 @@ private:
     ///   not already been solved for.
     /// @pre There is not a lower TOI in the time step for which collisions have
     ///   not already been processed.
-    IslandStats SolveToi(ContactID contactID, const StepConf& conf);
+    IslandStats SolveToi(ContactID contactID, Island& island, const StepConf& conf);
 
     /// @brief Solves the time of impact for bodies 0 and 1 of the given island.
     /// @details This:
@@ -874,8 +1082,11 @@ private:
         ContactImpulsesFunction postSolveContact; ///< Listener for post-solving contacts.
     };
 
-    /// @brief Updates the contact times of impact.
-    UpdateContactsData UpdateContactTOIs(const StepConf& conf);
+    /// @brief Updates the times of impact of the identified contacts that need it.
+    /// @details Contacts are gone through in the given order. Their bodies' sweeps get
+    ///   advanced as needed along the way, so this order matters.
+    UpdateContactsData UpdateContactTOIs(const Span<const ContactID>& contacts,
+                                         const StepConf& conf);
 
     /// @brief Processes the narrow phase collision for the contacts collection.
     /// @details
@@ -887,6 +1098,12 @@ private:
     DestroyContactsStats DestroyContacts(KeyedContactIDs& contacts);
 
     /// @brief Update contacts.
+    /// @details Updates all of the contacts that need updating. If this world has a task
+    ///   scheduler, the new manifolds of these contacts are computed concurrently. Touching
+    ///   related state changes and listener notifications are done afterwards in the same
+    ///   order of contacts as when done serially.
+    /// @note When updating concurrently, listeners see the updated manifolds of every contact
+    ///   rather than only of the contacts notified about before.
     UpdateContactsStats UpdateContacts(const StepConf& conf);
 
     /// @brief Adds contacts.
@@ -937,6 +1154,23 @@ private:
     /// @see GetManifold, IsTouching
     void Update(ContactID id, const ContactUpdateConf& conf);
 
+    /// @brief Updates the manifold of the identified contact.
+    /// @details This is the narrow-phase portion of updating a contact. It writes nothing but
+    ///   the contact's manifold, so different contacts can be updated concurrently.
+    /// @return Whether the contact's new manifold (or overlap if it's a sensor) is touching.
+    /// @see Update(ContactID, const ContactUpdateConf&).
+    bool UpdateManifold(ContactID id, const ContactUpdateConf& conf);
+
+    /// @brief Updates the touching related state of the identified contact and notifies any
+    ///   listeners.
+    /// @param id Identifies the contact to update.
+    /// @param newTouching Whether the contact's updated manifold is touching.
+    /// @param oldManifold Manifold of the contact from before it was updated.
+    /// @pre The identified contact needs updating.
+    /// @post The identified contact does not need updating.
+    /// @see UpdateManifold.
+    void UpdateTouching(ContactID id, bool newTouching, const Manifold& oldManifold);
+
     /******** Member variables. ********/
 
     pmr::StatsResource m_statsResource; ///< For PMR statistics.
@@ -947,10 +1181,35 @@ private:
     pmr::PoolMemoryResource m_proxyKeysResource; ///< For dynamic tree.
     pmr::PoolMemoryResource m_islandResource; ///< For island building.
 
+    /// @brief Step arena.
+    /// @details When non-null, this is used instead of the above pool resources.
+    /// @note This is released at the end of every step.
+    /// @see WorldConf::doStepArena, GetStepResource.
+    std::unique_ptr<pmr::MonotonicMemoryResource> m_stepArena;
+
     DynamicTree m_tree; ///< Dynamic tree.
 
+    /// @brief Collapsed copy of the dynamic tree for finding contacts with.
+    /// @details This is rebuilt in place, reusing its storage, and only when the dynamic tree
+    ///   has been modified since it was last built.
+    /// @see GetWideTree.
+    WideDynamicTree m_wideTree;
+
+    /// @brief Modification count of the dynamic tree that <code>m_wideTree</code> was built at.
+    /// @note This is empty when <code>m_wideTree</code> isn't built from the dynamic tree.
+    std::optional<std::size_t> m_wideTreeModifications;
+
     ObjectPool<Body> m_bodyBuffer; ///< Array of body data both used and freed.
     ObjectPool<Shape> m_shapeBuffer; ///< Array of shape data both used and freed.
+
+    /// @brief Child distance proxies of the shapes, indexed by shape identifier.
+    /// @details These are gotten once per set shape so the collision code that needs them
+    ///   over and over again just indexes into arrays instead of making a virtual call
+    ///   through the shape for every child.
+    /// @note This works for shapes of any type since the proxies only refer to the values
+    ///   of the shapes, and shapes never modify their values nor move them around.
+    std::vector<std::vector<DistanceProxy>> m_shapeChildren;
+
     ObjectPool<Joint> m_jointBuffer; ///< Array of joint data both used and freed.
 
     /// @brief Array of contact data both used and freed.
@@ -1003,9 +1262,63 @@ private:
     /// @see Island.
     Islanded m_islanded;
 
+    /// @brief Persistent island sets of bodies.
+    /// @details These get joined as contacts begin touching and joints get added, and get
+    ///   flagged for splitting as contacts end touching and joints get removed. Splitting
+    ///   itself is deferred till all of the bodies of a set could go to sleep.
+    /// @note Sets may be larger than islands but never smaller.
+    IslandSets m_islandSets;
+
+    /// @brief Map of body identifiers to island-local body constraint identifiers.
+    /// @details Sized to the body buffer so that island solving only needs to allocate
+    ///   as many body constraints as there are bodies in the island being solved.
+    /// @note This is step-wise scratch state. Elements are the invalid body ID except for
+    ///   the bodies of the island being solved.
+    /// @see BodyConstraintsMap.
+    std::vector<BodyID> m_bodyConstraintIndices;
+
+    /// @brief Islands found by the regular phase of stepping.
+    /// @details These are kept from step to step, along with the memory their containers
+    ///   got from <code>m_islandResource</code>, so that building islands only allocates
+    ///   when there are more or bigger islands than ever before.
+    /// @note This is step-wise scratch state. Only as many of these as the last regular
+    ///   phase found are meaningful.
+    std::vector<Island> m_islands;
+
+    /// @brief Island solver resources for batches of islands after the first.
+    /// @note This is step-wise scratch state only used when there's a task scheduler.
+    std::vector<std::unique_ptr<IslandBatchResources>> m_islandBatchResources;
+
+    /// @brief Task scheduler.
+    /// @see WorldConf::taskScheduler.
+    TaskScheduler* m_taskScheduler{};
+
+    /// @brief Tracer.
+    /// @see WorldConf::tracer.
+    Tracer* m_tracer{};
+
     /// @brief Listeners.
     Listeners m_listeners;
 
+    /// @brief Recorded contact events.
+    /// @note Only has a value if configured to record contact events.
+    /// @see WorldConf::doContactEvents.
+    std::optional<ContactEvents> m_contactEvents;
+
+    /// @brief Counts of each kind of contact event there are.
+    struct ContactEventCounts
+    {
+        std::size_t begins{}; ///< Count of begin contact events.
+        std::size_t ends{}; ///< Count of end contact events.
+        std::size_t preSolves{}; ///< Count of pre-solve contact events.
+        std::size_t postSolves{}; ///< Count of post-solve contact events.
+    };
+
+    /// @brief Counts of the recorded contact events as of the end of the last step.
+    /// @details These are the events the next step erases when it begins. Any recorded after
+    ///   these are kept through the next step so the caller still gets to see them.
+    ContactEventCounts m_stepContactEventCounts;
+
     FlagsType m_flags = e_stepComplete; ///< Flags.
 
     /// Inverse delta-t from previous step.
@@ -1037,6 +1350,13 @@ inline std::optional<pmr::StatsResource::Stats> GetResourceStats(const AabbTreeW
         ? world.m_statsResource.GetStats(): std::optional<pmr::StatsResource::Stats>{};
 }
 
+inline std::optional<pmr::MonotonicMemoryResource::Stats>
+GetStepArenaStats(const AabbTreeWorld& world) noexcept
+{
+    return world.m_stepArena
+        ? world.m_stepArena->GetStats(): std::optional<pmr::MonotonicMemoryResource::Stats>{};
+}
+
 inline const ProxyIDs& GetProxies(const AabbTreeWorld& world) noexcept
 {
     return world.m_proxiesForContacts;
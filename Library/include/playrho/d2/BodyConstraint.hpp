@@ -26,10 +26,14 @@
 /// @brief Definition of the @c BodyConstraint class and closely related code.
 
 #include <cassert> // for assert
+#include <type_traits> // for std::enable_if_t, std::is_constructible_v
+#include <utility> // for std::forward
 
 // IWYU pragma: begin_exports
 
+#include <playrho/BodyID.hpp>
 #include <playrho/MovementConf.hpp>
+#include <playrho/Span.hpp>
 
 #include <playrho/d2/Body.hpp> // for GetInvMass & other Body helpers
 #include <playrho/d2/Position.hpp>
@@ -153,6 +157,15 @@ inline BodyConstraint& BodyConstraint::SetVelocity(const Velocity& value) noexce
     return *this;
 }
 
+/// @brief Gets whether solving constraints can change the given body's velocity or position.
+/// @details That's the case unless both the body's inverse mass and inverse rotational
+///   inertia are zero, like they are for static and kinematic bodies.
+/// @relatedalso BodyConstraint
+inline bool IsMovable(const BodyConstraint& body) noexcept
+{
+    return (body.GetInvMass() != InvMass{}) || (body.GetInvRotInertia() != InvRotInertia{});
+}
+
 /// @brief Gets the <code>BodyConstraint</code> based on the given parameters.
 inline BodyConstraint GetBodyConstraint(const Body& body, Time time,
                                         const MovementConf& conf) noexcept
@@ -166,6 +179,58 @@ inline BodyConstraint GetBodyConstraint(const Body& body, Time time,
     };
 }
 
+/// @brief Body constraints map.
+/// @details Provides body identifier based access to a contiguous array of body constraints.
+///   Without an index map, body identifiers are used directly as indices into the array.
+///   With an index map, body identifiers are first translated through it. The latter lets
+///   the array hold just the constraints for the bodies of an island while still having
+///   them accessible by the body identifiers that joints refer to.
+/// @see At(const BodyConstraintsMap&, BodyID).
+class BodyConstraintsMap
+{
+public:
+    /// @brief Size type.
+    using size_type = Span<BodyConstraint>::size_type;
+
+    BodyConstraintsMap() = default;
+
+    /// @brief Initializing constructor for directly indexed access.
+    /// @param constraints Container of body constraints indexed by body identifier.
+    template <typename U, typename = std::enable_if_t<
+        !std::is_same_v<std::decay_t<U>, BodyConstraintsMap> &&
+        std::is_constructible_v<Span<BodyConstraint>, U&&>>>
+    constexpr BodyConstraintsMap(U&& constraints) noexcept: // NOLINT(google-explicit-constructor)
+        m_constraints(std::forward<U>(constraints))
+    {
+    }
+
+    /// @brief Initializing constructor for map indexed access.
+    /// @param constraints Array of body constraints.
+    /// @param indices Map of body identifiers to indices of elements in @p constraints.
+    constexpr BodyConstraintsMap(const Span<BodyConstraint>& constraints,
+                                 const Span<const BodyID>& indices) noexcept:
+        m_constraints(constraints), m_indices(indices)
+    {
+    }
+
+    /// @brief Gets the array of body constraints.
+    constexpr Span<BodyConstraint> GetConstraints() const noexcept
+    {
+        return m_constraints;
+    }
+
+    /// @brief Gets the map of body identifiers to body constraint indices.
+    /// @return Empty span for directly indexed access.
+    constexpr Span<const BodyID> GetIndices() const noexcept
+    {
+        return m_indices;
+    }
+
+private:
+    Span<BodyConstraint> m_constraints; ///< Array of body constraints.
+    Span<const BodyID> m_indices; ///< Map of body identifiers to constraint indices.
+};
+
 } // namespace playrho::d2
 
 #endif // PLAYRHO_D2_BODYCONSTRAINT_HPP
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef PLAYRHO_D2_BODYSTATESPANS_HPP
+#define PLAYRHO_D2_BODYSTATESPANS_HPP
+
+/// @file
+/// @brief Definitions of structures for accessing the states of many bodies at once.
+
+// IWYU pragma: begin_exports
+
+#include <playrho/Span.hpp>
+#include <playrho/Units.hpp>
+#include <playrho/Vector2.hpp>
+
+#include <playrho/d2/Acceleration.hpp>
+#include <playrho/d2/Velocity.hpp>
+
+// IWYU pragma: end_exports
+
+namespace playrho::d2 {
+
+/// @brief Spans of contiguous arrays to fill with the states of bodies.
+/// @details Element <code>i</code> of each non-empty span is for the <code>i</code>'th
+///   identifier of the bodies whose states are being gotten. Empty spans are skipped.
+/// @see GetBodyStates, ConstBodyStateSpans.
+struct BodyStateSpans
+{
+    Span<Length2> locations; ///< Locations of the bodies' origins.
+    Span<Angle> angles; ///< Angles of the bodies.
+    Span<Velocity> velocities; ///< Velocities of the bodies.
+    Span<Acceleration> accelerations; ///< Accelerations of the bodies.
+};
+
+/// @brief Spans of contiguous arrays of the new states of bodies.
+/// @details Element <code>i</code> of each non-empty span is for the <code>i</code>'th
+///   identifier of the bodies whose states are being set. Empty spans are skipped.
+/// @see SetBodyStates, BodyStateSpans.
+struct ConstBodyStateSpans
+{
+    Span<const Length2> locations; ///< Locations of the bodies' origins.
+    Span<const Angle> angles; ///< Angles of the bodies.
+    Span<const Velocity> velocities; ///< Velocities of the bodies.
+    Span<const Acceleration> accelerations; ///< Accelerations of the bodies.
+};
+
+} // namespace playrho::d2
+
+#endif // PLAYRHO_D2_BODYSTATESPANS_HPP
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef PLAYRHO_D2_CONTACTEVENTS_HPP
+#define PLAYRHO_D2_CONTACTEVENTS_HPP
+
+/// @file
+/// @brief Definitions of the buffered contact event types.
+
+#include <vector>
+
+// IWYU pragma: begin_exports
+
+#include <playrho/ContactID.hpp>
+#include <playrho/Contactable.hpp>
+#include <playrho/Units.hpp>
+
+#include <playrho/d2/ContactImpulsesList.hpp>
+#include <playrho/d2/Manifold.hpp>
+
+// IWYU pragma: end_exports
+
+namespace playrho::d2 {
+
+/// @brief Begin contact event.
+/// @details Recorded when a contact starts touching.
+/// @see ContactEvents.
+struct BeginContactEvent
+{
+    ContactID contactId; ///< Identifier of the contact.
+    Contactable a; ///< Side A of the contact.
+    Contactable b; ///< Side B of the contact.
+
+    /// @brief Speed the two sides were approaching each other at along the contact normal.
+    /// @details This is the greatest such speed of any of the contact's points. It's zero or
+    ///   less for sides that weren't approaching each other.
+    LinearVelocity approachSpeed{};
+};
+
+/// @brief End contact event.
+/// @details Recorded when a contact stops touching, or is destroyed while touching.
+/// @see ContactEvents.
+struct EndContactEvent
+{
+    ContactID contactId; ///< Identifier of the contact.
+    Contactable a; ///< Side A of the contact.
+    Contactable b; ///< Side B of the contact.
+};
+
+/// @brief Pre-solve contact event.
+/// @details Recorded when a touching non-sensor contact has been updated, before its
+///   constraints get solved.
+/// @see ContactEvents.
+struct PreSolveContactEvent
+{
+    ContactID contactId; ///< Identifier of the contact.
+    Contactable a; ///< Side A of the contact.
+    Contactable b; ///< Side B of the contact.
+    Manifold oldManifold; ///< Manifold of the contact from before it was updated.
+};
+
+/// @brief Post-solve contact event.
+/// @details Recorded after a contact's constraints have been solved.
+/// @see ContactEvents.
+struct PostSolveContactEvent
+{
+    ContactID contactId; ///< Identifier of the contact.
+    Contactable a; ///< Side A of the contact.
+    Contactable b; ///< Side B of the contact.
+    ContactImpulsesList impulses; ///< Impulses applied for the contact's points.
+    unsigned solved{}; ///< Iterations it took to solve, or an invalid iteration value if not.
+};
+
+/// @brief Buffered contact events.
+/// @details Contiguous arrays of the contact events that have been recorded, in the order
+///   they were recorded in. These are the same events that the contact listeners get called
+///   for but they can be gone through all at once after stepping a world.
+/// @see WorldConf::doContactEvents.
+struct ContactEvents
+{
+    std::vector<BeginContactEvent> begins; ///< Begin contact events.
+    std::vector<EndContactEvent> ends; ///< End contact events.
+    std::vector<PreSolveContactEvent> preSolves; ///< Pre-solve contact events.
+    std::vector<PostSolveContactEvent> postSolves; ///< Post-solve contact events.
+};
+
+/// @brief Clears the given contact events while keeping their arrays' capacities.
+/// @relatedalso ContactEvents
+inline void Clear(ContactEvents& events) noexcept
+{
+    events.begins.clear();
+    events.ends.clear();
+    events.preSolves.clear();
+    events.postSolves.clear();
+}
+
+/// @brief Gets whether the given contact events are empty.
+/// @relatedalso ContactEvents
+inline bool empty(const ContactEvents& events) noexcept
+{
+    return events.begins.empty() && events.ends.empty()
+        && events.preSolves.empty() && events.postSolves.empty();
+}
+
+} // namespace playrho::d2
+
+#endif // PLAYRHO_D2_CONTACTEVENTS_HPP
@@ -27,7 +27,9 @@
 
 // IWYU pragma: begin_exports
 
+#include <playrho/Settings.hpp>
 #include <playrho/Span.hpp>
+#include <playrho/Units.hpp>
 
 #include <playrho/d2/Math.hpp>
 #include <playrho/d2/PositionSolution.hpp>
@@ -75,6 +77,83 @@ d2::PositionSolution SolvePositionConstraint(const d2::PositionConstraint& pc,
 
 } // namespace GaussSidel
 
+/// @brief Functions for soft-step solving.
+/// @details Soft-step solving divides a step into sub-steps. Each sub-step solves the
+///   velocity constraints once with contacts that push overlapping shapes apart softly,
+///   integrates the positions, and then solves the velocity constraints once more without
+///   pushing to relax the velocities that pushing added.
+namespace SoftStep {
+
+/// @brief Softness of a constraint.
+/// @details These are the coefficients with which a constraint behaves like a damped spring.
+/// @see GetSoftness.
+struct Softness
+{
+    /// @brief Rate at which position error is turned into a velocity bias.
+    Frequency biasRate = 0_Hz;
+
+    /// @brief Scale of the mass that the velocity error is multiplied by.
+    Real massScale = 1;
+
+    /// @brief Scale of the accumulated impulse that's taken from the impulse increment.
+    Real impulseScale = 0;
+};
+
+/// @brief Gets the softness of a constraint of the given natural frequency and damping ratio
+///   for solving over the given time.
+/// @note A zero frequency gets the softness of a rigid constraint.
+Softness GetSoftness(Frequency frequency, Real dampingRatio, Time h) noexcept;
+
+/// @brief Configuration for soft-step solving velocity constraints.
+struct SoftContactConf
+{
+    /// @brief Softness with which overlapping shapes are pushed apart.
+    Softness softness;
+
+    /// @brief Sub-step time.
+    Time deltaTime = 0_s;
+
+    /// @brief Overlap that contacts are resolved to.
+    Length linearSlop = DefaultLinearSlop;
+
+    /// @brief Maximum speed at which overlapping shapes are pushed apart.
+    LinearVelocity maxPushSpeed = 0_mps;
+
+    /// @brief Whether to push overlapping shapes apart.
+    /// @details Without pushing, contacts only keep shapes from moving into each other.
+    bool usePush = true;
+};
+
+/// @brief Solves the velocity constraint as a soft constraint.
+/// @details This updates the tangent and normal impulses of the velocity constraint
+///   points of the given velocity constraint and updates the given velocities. Unlike
+///   <code>GaussSeidel::SolveVelocityConstraint</code>, the normal impulses are calculated
+///   from the current separations of the position constraint's manifold points instead of
+///   from the velocity constraint's velocity biases.
+/// @param vc Velocity constraint to solve for.
+/// @param pc Position constraint of the same contact as the velocity constraint.
+/// @param bodies Collection of bodies containing the two for the constraints.
+/// @param conf Configuration for the solving.
+/// @return Maximum momentum used for solving both the tangential and normal portions.
+/// @see ApplyRestitution.
+Momentum SolveVelocityConstraint(d2::VelocityConstraint& vc, const d2::PositionConstraint& pc,
+                                 const Span<d2::BodyConstraint>& bodies,
+                                 const SoftContactConf& conf);
+
+/// @brief Applies the restitution of the given velocity constraint.
+/// @details Soft-step solving doesn't use the velocity biases while solving, so they're
+///   applied by this once all the sub-steps are done.
+/// @return Maximum momentum used.
+Momentum ApplyRestitution(d2::VelocityConstraint& vc, const Span<d2::BodyConstraint>& bodies);
+
+/// @brief Gets the minimum separation of the given position constraint's manifold points
+///   at the current positions of the given bodies.
+/// @return Infinity for position constraints not having any points.
+Length GetMinSeparation(const d2::PositionConstraint& pc,
+                        const Span<const d2::BodyConstraint>& bodies);
+
+} // namespace SoftStep
+
 } // namespace playrho
 
 #endif // PLAYRHO_D2_CONTACTSOLVER_HPP
@@ -44,7 +44,7 @@ struct StepConf;
 namespace d2 {
 
 class World;
-class BodyConstraint;
+class BodyConstraintsMap;
 
 /// @example DistanceJoint.cpp
 /// This is the <code>googletest</code> based unit testing file for the interfaces to
@@ -202,7 +202,7 @@ constexpr bool ShiftOrigin(DistanceJointConf&, Length2) noexcept
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @see SolveVelocity.
 /// @relatedalso DistanceJointConf
-void InitVelocity(DistanceJointConf& object, const Span<BodyConstraint>& bodies,
+void InitVelocity(DistanceJointConf& object, const BodyConstraintsMap& bodies,
                   const StepConf& step, const ConstraintSolverConf& conf);
 
 /// @brief Solves velocity constraint.
@@ -216,7 +216,7 @@ void InitVelocity(DistanceJointConf& object, const Span<BodyConstraint>& bodies,
 /// @see InitVelocity.
 /// @return <code>true</code> if velocity is "solved", <code>false</code> otherwise.
 /// @relatedalso DistanceJointConf
-bool SolveVelocity(DistanceJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(DistanceJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step);
 
 /// @brief Solves the position constraint.
@@ -228,7 +228,7 @@ bool SolveVelocity(DistanceJointConf& object, const Span<BodyConstraint>& bodies
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @return <code>true</code> if the position errors are within tolerance.
 /// @relatedalso DistanceJointConf
-bool SolvePosition(const DistanceJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const DistanceJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf);
 
 /// @brief Free function for setting the frequency value of the given configuration.
@@ -27,7 +27,11 @@
 
 #include <cassert> // for assert
 #include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t
 #include <functional> // for std::function
+#include <vector>
+
+#include <playrho/GrowableStack.hpp>
 
 // IWYU pragma: begin_exports
 
@@ -35,6 +39,7 @@
 #include <playrho/d2/DynamicTreeData.hpp>
 #include <playrho/ShapeID.hpp>
 #include <playrho/Settings.hpp>
+#include <playrho/Span.hpp>
 #include <playrho/Vector2.hpp>
 #include <playrho/BodyID.hpp>
 
@@ -63,6 +68,7 @@ namespace playrho::d2 {
 /// @invariant Branch nodes' AABBs are always the AABB which minimally encloses its children.
 /// @invariant Leaf nodes always have a "height" of zero.
 /// @invariant Freed nodes always have a "height" of the maximum value of the height type.
+/// @invariant Leaves of different partitions are never in the same partition sub-tree.
 ///
 /// @note This code was inspired by Nathanael Presson's <code>btDbvt</code>.
 /// @note Nodes are pooled and relocatable, so we use node indices rather than pointers.
@@ -108,6 +114,18 @@ public:
         return !IsUnused(value) && !IsLeaf(value);
     }
 
+    /// @brief Partitions of the leaves of a tree.
+    /// @details The leaves of each partition are kept in a sub-tree of their own. This way,
+    ///   creating, destroying, or updating the leaves of one partition never restructures
+    ///   the sub-tree of the other, and queries can be limited to just one of them. When both
+    ///   partitions have leaves, the root node is a branch whose children are the roots of
+    ///   the two partition sub-trees.
+    /// @see GetRootIndex(Partition), GetPartition.
+    enum class Partition: std::uint8_t {
+        Dynamic, ///< For leaves that are expected to move.
+        Static, ///< For leaves that aren't expected to move.
+    };
+
     /// @brief Non-throwing default constructor.
     /// @post <code>GetNodeCapacity()</code> returns 0.
     /// @post <code>GetNodeCount()</code> returns 0.
@@ -127,6 +145,17 @@ public:
     /// @throws std::bad_alloc If unable to allocate non-zero sized memory.
     explicit DynamicTree(Size nodeCapacity);
 
+    /// @brief Bulk loading constructor.
+    /// @details Constructs a tree of leaves for the given AABBs and leaf data that's been
+    ///   built top-down all at once like <code>Rebuild</code> does.
+    /// @pre @p aabbs and @p data have the same size.
+    /// @post <code>GetLeafCount()</code> returns the size of @p aabbs.
+    /// @post The leaf for element @c i of @p aabbs and @p data has the index @c i.
+    /// @post All the leaves are in the <code>Partition::Dynamic</code> partition.
+    /// @throws std::bad_alloc If unable to allocate necessary memory.
+    /// @see CreateLeaves.
+    DynamicTree(const Span<const AABB>& aabbs, const Span<const Contactable>& data);
+
     /// @brief Copy constructor.
     /// @throws std::bad_alloc If unable to allocate non-zero sized memory.
     DynamicTree(const DynamicTree& other);
@@ -158,6 +187,9 @@ public:
 
     /// @brief Creates a new leaf node.
     /// @details Creates a leaf node for a tight fitting AABB and the given data.
+    /// @param aabb AABB for the new leaf.
+    /// @param data Data for the new leaf.
+    /// @param partition Partition for the new leaf.
     /// @note The indices of leaf nodes that have been destroyed get reused for new nodes.
     /// @pre The number of leaves already allocated (as reported by <code>GetLeafCount()</code>)
     ///   is less than <code>std::numeric_limits<Size>::max()</code>.
@@ -168,13 +200,31 @@ public:
     ///   be set to the index returned from this function.
     /// @post The leaf count per <code>GetLeafCount()</code> is incremented by one.
     /// @post The node count (as reported by <code>GetNodeCount()</code>) will be incremented by one
-    ///   or two (if the root index had not been <code>InvalidSize</code>).
+    ///   or two (if the root index had not been <code>InvalidSize</code>), plus one more if
+    ///   this created the first leaf of a partition while the other partition had leaves.
     /// @return The index of the created leaf node. This will be a value not equal to
     ///   <code>InvalidSize</code>.
     /// @throws std::bad_alloc If unable to allocate necessary memory. If this exception is
     ///   thrown, this function has no effect.
     /// @see GetLeafCount(), GetNodeCount()
-    Size CreateLeaf(const AABB& aabb, const Contactable& data);
+    Size CreateLeaf(const AABB& aabb, const Contactable& data,
+                    Partition partition = Partition::Dynamic);
+
+    /// @brief Creates leaves for the given AABBs and leaf data.
+    /// @details This is a bulk alternative to calling <code>CreateLeaf</code> for each of the
+    ///   given leaves. When there are at least as many new leaves as existing ones in the
+    ///   partition, all of its leaves get built into a new sub-tree top-down in one pass like
+    ///   <code>Rebuild</code> does. Otherwise the new leaves are inserted one at a time like
+    ///   <code>CreateLeaf</code> does.
+    /// @pre @p aabbs, @p data, and @p indices all have the same size.
+    /// @post The leaf count per <code>GetLeafCount()</code> is incremented by the size of
+    ///   @p aabbs.
+    /// @post Element @c i of @p indices is the index of the leaf created for element @c i of
+    ///   @p aabbs and @p data.
+    /// @throws std::bad_alloc If unable to allocate necessary memory.
+    /// @see CreateLeaf, Rebuild.
+    void CreateLeaves(const Span<const AABB>& aabbs, const Span<const Contactable>& data,
+                      const Span<Size>& indices, Partition partition = Partition::Dynamic);
 
     /// @brief Destroys a leaf node.
     /// @param index Identifier of node to destroy.
@@ -191,6 +241,23 @@ public:
     ///   <code>IsLeaf(GetNode(index).GetHeight())</code> is true.
     void UpdateLeaf(Size index, const AABB& aabb);
 
+    /// @brief Moves the identified leaf to the given partition.
+    /// @details This preserves the leaf's index. It does nothing if the leaf's already in
+    ///   the given partition.
+    /// @param index Leaf node's ID.
+    /// @param partition Partition to move the leaf to.
+    /// @pre @p index is less than <code>GetNodeCapacity()</code> and
+    ///   <code>IsLeaf(GetNode(index).GetHeight())</code> is true.
+    /// @post <code>GetPartition(index)</code> returns @p partition.
+    /// @see GetPartition.
+    void SetPartition(Size index, Partition partition) noexcept;
+
+    /// @brief Gets the partition of the identified leaf.
+    /// @param index Leaf node's ID.
+    /// @pre @p index is less than <code>GetNodeCapacity()</code> and
+    ///   <code>IsLeaf(GetNode(index).GetHeight())</code> is true.
+    Partition GetPartition(Size index) const noexcept;
+
     /// @brief Gets the node identified by the given identifier.
     /// @param index Identifier of node to get.
     /// @pre @p index is less than <code>GetNodeCapacity()</code>.
@@ -233,6 +300,13 @@ public:
     /// @return <code>InvalidSize</code> if this tree is "empty", else index to "root" node.
     Size GetRootIndex() const noexcept;
 
+    /// @brief Gets the index of the root node of the given partition's sub-tree.
+    /// @note This is the same as <code>GetRootIndex()</code> when the other partition
+    ///   doesn't have any leaves.
+    /// @return <code>InvalidSize</code> if the partition is "empty", else index to the root
+    ///   node of the partition's sub-tree.
+    Size GetRootIndex(Partition partition) const noexcept;
+
     /// @brief Gets the free index.
     Size GetFreeIndex() const noexcept;
 
@@ -240,8 +314,28 @@ public:
     /// @note This operation is very expensive.
     /// @note Meant for testing.
     /// @throws std::bad_alloc If unable to allocate necessary memory.
+    /// @see Rebuild.
     void RebuildBottomUp();
 
+    /// @brief Rebuilds this tree from its leaves using a top-down binned surface area
+    ///   heuristic (SAH).
+    /// @details Discards all the branch nodes and recursively splits the leaves in two at
+    ///   whichever of the bin boundaries along the widest axis of the leaf centers minimizes
+    ///   the sum of each side's perimeter times its leaf count.
+    /// @note This runs in roughly <code>O(n log n)</code> time for @c n leaves and generally
+    ///   results in a tree having a lower <code>ComputePerimeterRatio</code> than one built
+    ///   up by incrementally creating the same leaves.
+    /// @note Leaf indices and partitions are preserved.
+    /// @throws std::bad_alloc If unable to allocate necessary memory.
+    /// @see RebuildBottomUp, ComputePerimeterRatio.
+    void Rebuild();
+
+    /// @brief Rebuilds just the given partition's sub-tree.
+    /// @details Like <code>Rebuild()</code> but limited to the leaves of the given partition.
+    /// @throws std::bad_alloc If unable to allocate necessary memory.
+    /// @see Rebuild().
+    void Rebuild(Partition partition);
+
     /// @brief Shifts the world origin.
     /// @note Useful for large worlds.
     /// @note The shift formula is: <code>position -= newOrigin</code>.
@@ -270,6 +364,15 @@ public:
     /// @details Gets the current leaf node count.
     Size GetLeafCount() const noexcept;
 
+    /// @brief Gets the current leaf node count of the given partition.
+    Size GetLeafCount(Partition partition) const noexcept;
+
+    /// @brief Gets the count of modifications made to this tree.
+    /// @details This is a count that every function which may change the structure or the
+    ///   AABBs of this tree increments. Comparing it to a previously gotten value tells whether
+    ///   anything derived from this tree, like a collapsed copy of it, may be out of date.
+    std::size_t GetModificationCount() const noexcept;
+
     /// @brief Finds first node which references the given index.
     /// @note Primarily intended for unit testing and/or debugging.
     /// @return Index of node referencing the given index, or the value of
@@ -295,6 +398,51 @@ private:
     /// @see GetNodeCount()
     Size AllocateNode() noexcept;
 
+    /// @brief Builds a sub-tree from the given leaves using the binned SAH.
+    /// @pre @p count is greater than zero and every element of @p leaves identifies a leaf
+    ///   node whose "other" value doesn't matter.
+    /// @pre <code>GetNodeCapacity()</code> is at least <code>count - 1</code> greater than
+    ///   <code>GetNodeCount()</code>.
+    /// @note The order of the elements of @p leaves is modified.
+    /// @return Index of the sub-tree's root node whose "other" value is <code>InvalidSize</code>.
+    /// @throws std::bad_alloc If unable to allocate necessary memory.
+    Size BuildTopDown(Size* leaves, Size count);
+
+    /// @brief Builds a sub-tree from the given leaves by repeatedly pairing up the two nodes
+    ///   whose enclosing AABB has the smallest perimeter.
+    /// @pre @p count is greater than zero and every element of @p leaves identifies a leaf
+    ///   node whose "other" value is <code>InvalidSize</code>.
+    /// @note The elements of @p leaves are modified.
+    /// @return Index of the sub-tree's root node whose "other" value is <code>InvalidSize</code>.
+    /// @throws std::bad_alloc If unable to allocate necessary memory.
+    Size BuildBottomUp(Size* leaves, Size count);
+
+    /// @brief Takes the leaves out of the identified sub-tree, freeing all of its branches.
+    /// @post Every leaf returned has an "other" value of <code>InvalidSize</code>.
+    /// @throws std::bad_alloc If unable to allocate necessary memory.
+    std::vector<Size> TakeLeaves(Size index);
+
+    /// @brief Gets a reference to the given partition's root index.
+    Size& RootIndex(Partition partition) noexcept;
+
+    /// @brief Splits the partition sub-trees from each other.
+    /// @details Detaches the partition sub-trees from the branch node joining them, if there
+    ///   is one, so the sub-trees can be modified on their own by the code used for a single
+    ///   tree. The joining node stays allocated, as the root index, for
+    ///   <code>JoinPartitions</code> to reuse, but it's cleared so it references no other node.
+    /// @post Neither partition's root node has a parent.
+    /// @post The root index is the index of the cleared joining node or the invalid index.
+    /// @see JoinPartitions.
+    void SplitPartitions() noexcept;
+
+    /// @brief Joins the partition sub-trees back together and updates the root index.
+    /// @details Reuses the joining node left by <code>SplitPartitions</code> if both partitions
+    ///   have leaves, else frees it.
+    /// @pre <code>SplitPartitions</code> was called and, if both partitions have leaves and
+    ///   there's no joining node left by it, there's capacity for at least one more node.
+    /// @see SplitPartitions.
+    void JoinPartitions() noexcept;
+
     /// @brief Frees the specified node.
     /// @pre @p index is less than <code>GetNodeCapacity()</code>.
     /// @pre <code>GetNodeCount()</code> is greater than zero.
@@ -308,9 +456,13 @@ private:
     Size m_leafCount{0u}; ///< Leaf count. @details Count of currently allocated leaf nodes.
     Size m_rootIndex{
         InvalidSize}; ///< Index of root element in m_nodes or <code>InvalidSize</code>.
+    Size m_staticRootIndex{InvalidSize}; ///< Index of root of static partition.
+    Size m_dynamicRootIndex{InvalidSize}; ///< Index of root of dynamic partition.
+    Size m_staticLeafCount{0u}; ///< Count of leaves in the static partition.
     Size m_freeIndex{InvalidSize}; ///< Free list. @details Index to free nodes.
     Size m_nodeCapacity{0u}; ///< Node capacity. @details Size of buffer allocated for nodes.
     TreeNode* m_nodes{nullptr}; ///< Nodes. @details Initialized on construction.
+    std::size_t m_modifications{0u}; ///< Count of modifications made to this tree.
 };
 
 /// @brief Is unused.
@@ -355,8 +507,9 @@ public:
 
     /// @brief Initializing constructor.
     constexpr TreeNode(const Contactable& value, const AABB& aabb,
-                       Size other = DynamicTree::InvalidSize) noexcept
-        : m_aabb{aabb}, m_variant{value}, m_height{0}, m_other{other}
+                       Size other = DynamicTree::InvalidSize,
+                       Partition partition = Partition::Dynamic) noexcept
+        : m_aabb{aabb}, m_variant{value}, m_height{0}, m_other{other}, m_partition{partition}
     {
         // Intentionally empty.
     }
@@ -394,6 +547,21 @@ public:
         m_other = other;
     }
 
+    /// @brief Gets the partition of this node.
+    /// @note This is only meaningful for leaf nodes.
+    constexpr Partition GetPartition() const noexcept
+    {
+        return m_partition;
+    }
+
+    /// @brief Sets the partition of this node.
+    /// @pre This node is a leaf, i.e.: <code>IsLeaf(GetHeight())</code> is true.
+    constexpr void SetPartition(Partition partition) noexcept
+    {
+        assert(IsLeaf(GetHeight()));
+        m_partition = partition;
+    }
+
     /// @brief Gets the node's AABB.
     /// @pre This node is not unused, i.e.: <code>IsUnused(GetHeight())</code> is false.
     constexpr AABB GetAABB() const noexcept
@@ -485,6 +653,10 @@ private:
     /// @note This is an index to the next node for a free node, else this is the index to the
     ///   parent node.
     Size m_other = DynamicTree::InvalidSize; ///< Index of another node.
+
+    /// @brief Partition of a leaf node.
+    /// @note This is kept in the leaf so looking it up doesn't need to walk up the tree.
+    Partition m_partition = Partition::Dynamic;
 };
 
 inline DynamicTree::Size DynamicTree::GetRootIndex() const noexcept
@@ -495,6 +667,11 @@ inline DynamicTree::Size DynamicTree::GetRootIndex() const noexcept
     return m_rootIndex;
 }
 
+inline DynamicTree::Size DynamicTree::GetRootIndex(Partition partition) const noexcept
+{
+    return (partition == Partition::Static)? m_staticRootIndex: m_dynamicRootIndex;
+}
+
 inline DynamicTree::Size DynamicTree::GetFreeIndex() const noexcept
 {
     return m_freeIndex;
@@ -510,6 +687,11 @@ inline DynamicTree::Size DynamicTree::GetNodeCount() const noexcept
     return m_nodeCount;
 }
 
+inline std::size_t DynamicTree::GetModificationCount() const noexcept
+{
+    return m_modifications;
+}
+
 inline DynamicTree::Size DynamicTree::GetLeafCount() const noexcept
 {
     assert(((m_leafCount == 0) && (m_rootIndex == InvalidSize)) ||
@@ -518,6 +700,11 @@ inline DynamicTree::Size DynamicTree::GetLeafCount() const noexcept
     return m_leafCount;
 }
 
+inline DynamicTree::Size DynamicTree::GetLeafCount(Partition partition) const noexcept
+{
+    return (partition == Partition::Static)? m_staticLeafCount: m_leafCount - m_staticLeafCount;
+}
+
 inline const DynamicTree::TreeNode& DynamicTree::GetNode(Size index) const noexcept
 {
     assert(index != InvalidSize);
@@ -697,6 +884,51 @@ using DynamicTreeSizeCB = std::function<DynamicTreeOpcode(DynamicTree::Size)>;
 /// @note The callback instance is called for each leaf node that overlaps the supplied AABB.
 void Query(const DynamicTree& tree, const AABB& aabb, const DynamicTreeSizeCB& callback);
 
+/// @brief Query the sub-tree of the given dynamic tree rooted at the given index and find
+///   nodes overlapping the given AABB.
+/// @note The callback instance is called for each leaf node that overlaps the supplied AABB.
+/// @see DynamicTree::GetRootIndex(DynamicTree::Partition).
+void Query(const DynamicTree& tree, DynamicTree::Size root, const AABB& aabb,
+           const DynamicTreeSizeCB& callback);
+
+/// @brief Query the sub-tree of the given dynamic tree rooted at the given index and find
+///   nodes overlapping the given AABB.
+/// @details This is the traversal that the <code>Query</code> functions are implemented with.
+///   It's usable directly by code that doesn't want to pay for calling through a
+///   <code>std::function</code> for every leaf.
+/// @param tree Dynamic tree to do the query over.
+/// @param root Index of the root of the sub-tree to query.
+/// @param aabb The query box.
+/// @param callback Callable taking the index of a leaf node that overlaps the query box and
+///   returning a <code>DynamicTreeOpcode</code> for whether to continue.
+/// @see Query(const DynamicTree&, DynamicTree::Size, const AABB&, const DynamicTreeSizeCB&).
+template <class Callback>
+void QueryLeafs(const DynamicTree& tree, DynamicTree::Size root, const AABB& aabb,
+                Callback&& callback)
+{
+    static constexpr auto InitialStackCapacity = 256;
+    GrowableStack<DynamicTree::Size, InitialStackCapacity> stack;
+    stack.push(root);
+    while (!empty(stack)) {
+        const auto index = stack.top();
+        stack.pop();
+        if ((index == DynamicTree::InvalidSize) || !TestOverlap(tree.GetAABB(index), aabb)) {
+            continue;
+        }
+        const auto height = tree.GetHeight(index);
+        if (DynamicTree::IsBranch(height)) {
+            const auto branchData = tree.GetBranchData(index);
+            stack.push(branchData.child1);
+            stack.push(branchData.child2);
+            continue;
+        }
+        assert(DynamicTree::IsLeaf(height));
+        if (callback(index) == DynamicTreeOpcode::End) {
+            return;
+        }
+    }
+}
+
 /// @brief Query AABB for fixtures callback function type.
 /// @note Returning true will continue the query. Returning false will terminate the query.
 using QueryShapeCallback = std::function<bool(BodyID body, ShapeID shape, ChildCounter child)>;
@@ -44,7 +44,7 @@ struct StepConf;
 namespace d2 {
 
 class World;
-class BodyConstraint;
+class BodyConstraintsMap;
 
 /// @example FrictionJoint.cpp
 /// This is the <code>googletest</code> based unit testing file for the interfaces to
@@ -184,7 +184,7 @@ constexpr bool ShiftOrigin(FrictionJointConf&, Length2) noexcept
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @see SolveVelocity.
 /// @relatedalso FrictionJointConf
-void InitVelocity(FrictionJointConf& object, const Span<BodyConstraint>& bodies,
+void InitVelocity(FrictionJointConf& object, const BodyConstraintsMap& bodies,
                   const StepConf& step, const ConstraintSolverConf& conf);
 
 /// @brief Solves velocity constraint.
@@ -198,14 +198,14 @@ void InitVelocity(FrictionJointConf& object, const Span<BodyConstraint>& bodies,
 /// @see InitVelocity.
 /// @return <code>true</code> if velocity is "solved", <code>false</code> otherwise.
 /// @relatedalso FrictionJointConf
-bool SolveVelocity(FrictionJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(FrictionJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step);
 
 /// @brief Solves the position constraint.
 /// @note This is a no-op and always returns <code>true</code>.
 /// @return <code>true</code>.
 /// @relatedalso FrictionJointConf
-bool SolvePosition(const FrictionJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const FrictionJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf);
 
 /// @brief Free function for getting the max force value of the given configuration.
@@ -47,7 +47,7 @@ namespace d2 {
 
 class Joint;
 class World;
-class BodyConstraint;
+class BodyConstraintsMap;
 
 /// @example GearJoint.cpp
 /// This is the <code>googletest</code> based unit testing file for the interfaces to
@@ -229,7 +229,7 @@ constexpr bool ShiftOrigin(GearJointConf&, const Length2&) noexcept
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @see SolveVelocity.
 /// @relatedalso GearJointConf
-void InitVelocity(GearJointConf& object, const Span<BodyConstraint>& bodies, const StepConf& step,
+void InitVelocity(GearJointConf& object, const BodyConstraintsMap& bodies, const StepConf& step,
                   const ConstraintSolverConf& conf);
 
 /// @brief Solves velocity constraint.
@@ -243,7 +243,7 @@ void InitVelocity(GearJointConf& object, const Span<BodyConstraint>& bodies, con
 /// @see InitVelocity.
 /// @return <code>true</code> if velocity is "solved", <code>false</code> otherwise.
 /// @relatedalso GearJointConf
-bool SolveVelocity(GearJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(GearJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step);
 
 /// @brief Solves the position constraint.
@@ -255,7 +255,7 @@ bool SolveVelocity(GearJointConf& object, const Span<BodyConstraint>& bodies,
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @return <code>true</code> if the position errors are within tolerance.
 /// @relatedalso GearJointConf
-bool SolvePosition(const GearJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const GearJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf);
 
 /// @brief Free function for getting the ratio value of the given configuration.
@@ -59,6 +59,7 @@ namespace playrho::d2 {
 
 class Joint;
 class BodyConstraint;
+class BodyConstraintsMap;
 
 // Forward declare functions.
 // Note that these may be friend functions but that declaring these within the class that
@@ -108,18 +109,18 @@ bool ShiftOrigin(Joint& object, const Length2& value) noexcept;
 /// @brief Initializes velocity constraint data based on the given solver data.
 /// @note This MUST be called prior to calling <code>SolveVelocity</code>.
 /// @see SolveVelocity.
-void InitVelocity(Joint& object, const Span<BodyConstraint>& bodies, const StepConf& step,
+void InitVelocity(Joint& object, const BodyConstraintsMap& bodies, const StepConf& step,
                   const ConstraintSolverConf& conf);
 
 /// @brief Solves velocity constraint.
 /// @pre <code>InitVelocity</code> has been called.
 /// @see InitVelocity.
 /// @return <code>true</code> if velocity is "solved", <code>false</code> otherwise.
-bool SolveVelocity(Joint& object, const Span<BodyConstraint>& bodies, const StepConf& step);
+bool SolveVelocity(Joint& object, const BodyConstraintsMap& bodies, const StepConf& step);
 
 /// @brief Solves the position constraint.
 /// @return <code>true</code> if the position errors are within tolerance.
-bool SolvePosition(const Joint& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const Joint& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf);
 
 /// @example Joint.cpp
@@ -145,11 +146,11 @@ bool SolvePosition(const Joint& object, const Span<BodyConstraint>& bodies,
 ///   - <code>BodyID GetBodyB(const T& object) noexcept;</code>
 ///   - <code>bool GetCollideConnected(const T& object) noexcept;</code>
 ///   - <code>bool ShiftOrigin(T& object, Length2 value) noexcept;</code>
-///   - <code>void InitVelocity(T& object, const Span<BodyConstraint>& bodies,
+///   - <code>void InitVelocity(T& object, const BodyConstraintsMap& bodies,
 ///       const StepConf& step, const ConstraintSolverConf& conf);</code>
-///   - <code>bool SolveVelocity(T& object, const Span<BodyConstraint>& bodies,
+///   - <code>bool SolveVelocity(T& object, const BodyConstraintsMap& bodies,
 ///       const StepConf& step);</code>
-///   - <code>bool SolvePosition(const T& object, const Span<BodyConstraint>& bodies,
+///   - <code>bool SolvePosition(const T& object, const BodyConstraintsMap& bodies,
 ///       const ConstraintSolverConf& conf);</code>
 /// @ingroup JointsGroup
 /// @ingroup PhysicalEntities
@@ -307,7 +308,7 @@ public:
         return object.m_impl ? object.m_impl->ShiftOrigin_(value) : false;
     }
 
-    friend void InitVelocity(Joint& object, const Span<BodyConstraint>& bodies,
+    friend void InitVelocity(Joint& object, const BodyConstraintsMap& bodies,
                              const playrho::StepConf& step, const ConstraintSolverConf& conf)
     {
         if (object.m_impl) {
@@ -315,13 +316,13 @@ public:
         }
     }
 
-    friend bool SolveVelocity(Joint& object, const Span<BodyConstraint>& bodies,
+    friend bool SolveVelocity(Joint& object, const BodyConstraintsMap& bodies,
                               const playrho::StepConf& step)
     {
         return object.m_impl ? object.m_impl->SolveVelocity_(bodies, step) : false;
     }
 
-    friend bool SolvePosition(const Joint& object, const Span<BodyConstraint>& bodies,
+    friend bool SolvePosition(const Joint& object, const BodyConstraintsMap& bodies,
                               const ConstraintSolverConf& conf)
     {
         return object.m_impl ? object.m_impl->SolvePosition_(bodies, conf) : false;
@@ -351,11 +352,11 @@ struct IsValidJointType<
         decltype(GetBodyB(std::declval<T>())), //
         decltype(GetCollideConnected(std::declval<T>())), //
         decltype(ShiftOrigin(std::declval<T&>(), std::declval<Length2>())), //
-        decltype(InitVelocity(std::declval<T&>(), std::declval<const Span<BodyConstraint>&>(),
+        decltype(InitVelocity(std::declval<T&>(), std::declval<const BodyConstraintsMap&>(),
                               std::declval<StepConf>(), std::declval<ConstraintSolverConf>())), //
-        decltype(SolveVelocity(std::declval<T&>(), std::declval<const Span<BodyConstraint>&>(),
+        decltype(SolveVelocity(std::declval<T&>(), std::declval<const BodyConstraintsMap&>(),
                                std::declval<StepConf>())), //
-        decltype(SolvePosition(std::declval<T>(), std::declval<const Span<BodyConstraint>&>(),
+        decltype(SolvePosition(std::declval<T>(), std::declval<const BodyConstraintsMap&>(),
                                std::declval<ConstraintSolverConf>())), //
         decltype(std::declval<T>() == std::declval<T>()), //
         decltype(Joint{std::declval<T>()})>> : std::true_type {
@@ -371,7 +372,9 @@ inline constexpr bool IsValidJointTypeV = detail::IsValidJointType<T>::value;
 // Free functions...
 
 /// @brief Provides referenced access to the identified element of the given container.
-BodyConstraint& At(const Span<BodyConstraint>& container, BodyID key);
+/// @throws std::out_of_range If the given key isn't within the range of the container,
+///   or if it's mapped to the invalid body ID.
+BodyConstraint& At(const BodyConstraintsMap& container, BodyID key);
 
 /// @brief Converts the given joint into its current configuration value.
 /// @note The design for this was based off the design of the C++17 <code>std::any</code>
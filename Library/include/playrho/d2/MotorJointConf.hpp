@@ -44,7 +44,7 @@ struct StepConf;
 namespace d2 {
 
 class World;
-class BodyConstraint;
+class BodyConstraintsMap;
 
 /// @example MotorJoint.cpp
 /// This is the <code>googletest</code> based unit testing file for the interfaces to
@@ -205,7 +205,7 @@ constexpr auto ShiftOrigin(MotorJointConf&, const Length2&) noexcept
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @see SolveVelocity.
 /// @relatedalso MotorJointConf
-void InitVelocity(MotorJointConf& object, const Span<BodyConstraint>& bodies, const StepConf& step,
+void InitVelocity(MotorJointConf& object, const BodyConstraintsMap& bodies, const StepConf& step,
                   const ConstraintSolverConf& conf);
 
 /// @brief Solves velocity constraint.
@@ -219,14 +219,14 @@ void InitVelocity(MotorJointConf& object, const Span<BodyConstraint>& bodies, co
 /// @see InitVelocity.
 /// @return <code>true</code> if velocity is "solved", <code>false</code> otherwise.
 /// @relatedalso MotorJointConf
-bool SolveVelocity(MotorJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(MotorJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step);
 
 /// @brief Solves the position constraint.
 /// @note This is a no-op and always returns <code>true</code>.
 /// @return <code>true</code>.
 /// @relatedalso MotorJointConf
-bool SolvePosition(const MotorJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const MotorJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf);
 
 /// @brief Free function for getting the maximum force value of the given configuration.
@@ -46,7 +46,7 @@ struct StepConf;
 namespace d2 {
 
 class World;
-class BodyConstraint;
+class BodyConstraintsMap;
 
 /// @example PrismaticJoint.cpp
 /// This is the <code>googletest</code> based unit testing file for the interfaces to
@@ -272,7 +272,7 @@ AngularMomentum GetAngularReaction(const PrismaticJointConf& conf);
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @see SolveVelocityConstraints.
 /// @relatedalso PrismaticJointConf
-void InitVelocity(PrismaticJointConf& object, const Span<BodyConstraint>& bodies,
+void InitVelocity(PrismaticJointConf& object, const BodyConstraintsMap& bodies,
                   const StepConf& step, const ConstraintSolverConf& conf);
 
 /// @brief Solves velocity constraint.
@@ -286,7 +286,7 @@ void InitVelocity(PrismaticJointConf& object, const Span<BodyConstraint>& bodies
 /// @see InitVelocity.
 /// @return <code>true</code> if velocity is "solved", <code>false</code> otherwise.
 /// @relatedalso PrismaticJointConf
-bool SolveVelocity(PrismaticJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(PrismaticJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step);
 
 /// @brief Solves the position constraint.
@@ -298,7 +298,7 @@ bool SolveVelocity(PrismaticJointConf& object, const Span<BodyConstraint>& bodie
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @return <code>true</code> if the position errors are within tolerance.
 /// @relatedalso PrismaticJointConf
-bool SolvePosition(const PrismaticJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const PrismaticJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf);
 
 /// @brief Free function for setting the maximum motor torque value of the given configuration.
@@ -45,7 +45,7 @@ namespace d2 {
 
 class Joint;
 class World;
-class BodyConstraint;
+class BodyConstraintsMap;
 
 /// @example PulleyJoint.cpp
 /// This is the <code>googletest</code> based unit testing file for the interfaces to
@@ -205,7 +205,7 @@ bool ShiftOrigin(PulleyJointConf& object, const Length2& newOrigin) noexcept;
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @see SolveVelocity.
 /// @relatedalso PulleyJointConf
-void InitVelocity(PulleyJointConf& object, const Span<BodyConstraint>& bodies,
+void InitVelocity(PulleyJointConf& object, const BodyConstraintsMap& bodies,
                   const StepConf& step, const ConstraintSolverConf& conf);
 
 /// @brief Solves velocity constraint.
@@ -219,7 +219,7 @@ void InitVelocity(PulleyJointConf& object, const Span<BodyConstraint>& bodies,
 /// @see InitVelocity.
 /// @return <code>true</code> if velocity is "solved", <code>false</code> otherwise.
 /// @relatedalso PulleyJointConf
-bool SolveVelocity(PulleyJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(PulleyJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step);
 
 /// @brief Solves the position constraint.
@@ -231,7 +231,7 @@ bool SolveVelocity(PulleyJointConf& object, const Span<BodyConstraint>& bodies,
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @return <code>true</code> if the position errors are within tolerance.
 /// @relatedalso PulleyJointConf
-bool SolvePosition(const PulleyJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const PulleyJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf);
 
 /// @brief Free function for getting the length A value of the given configuration.
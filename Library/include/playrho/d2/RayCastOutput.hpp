@@ -32,8 +32,10 @@
 // IWYU pragma: begin_exports
 
 #include <playrho/BodyID.hpp>
+#include <playrho/Filter.hpp>
 #include <playrho/RayCastOpcode.hpp>
 #include <playrho/ShapeID.hpp>
+#include <playrho/Span.hpp>
 #include <playrho/UnitInterval.hpp>
 #include <playrho/Vector2.hpp>
 
@@ -43,6 +45,9 @@
 // IWYU pragma: end_exports
 
 namespace playrho {
+
+class TaskScheduler;
+
 namespace detail {
 
 template <std::size_t N>
@@ -56,6 +61,7 @@ class Shape;
 class DistanceProxy;
 class DynamicTree;
 struct Transformation;
+class WideDynamicTree;
 class World;
 
 /// @brief Ray-cast hit data.
@@ -76,6 +82,34 @@ struct RayCastHit
 /// @see RayCast, RayCastHit
 using RayCastOutput = std::optional<RayCastHit>;
 
+/// @brief Closest shape hit data of a ray cast against a world.
+/// @see RayCast(const World&, const Span<const RayCastInput>&, const Span<ShapeRayCastOutput>&,
+///   const Span<const Filter>&, TaskScheduler*).
+struct ShapeRayCastHit
+{
+    /// @brief Identifier of the body of the shape that was hit.
+    BodyID body;
+
+    /// @brief Identifier of the shape that was hit.
+    ShapeID shape;
+
+    /// @brief Index of the child of the shape that was hit.
+    ChildCounter child;
+
+    /// @brief Point in world coordinates where the ray hit.
+    Length2 point;
+
+    /// @brief Surface normal in world coordinates at the point of contact.
+    UnitVec normal;
+
+    /// @brief Fraction along the ray at which it hit.
+    UnitIntervalFF<Real> fraction;
+};
+
+/// @brief Shape ray cast output.
+/// @details This is a type alias for an optional <code>ShapeRayCastHit</code> instance.
+using ShapeRayCastOutput = std::optional<ShapeRayCastHit>;
+
 /// @brief Ray cast callback function.
 /// @note Return 0 to terminate ray casting, or > 0 to update the segment bounding box.
 using DynamicTreeRayCastCB = std::function<Real(BodyID body,
@@ -145,6 +179,15 @@ RayCastOutput RayCast(const Shape& shape, ChildCounter childIndex,
 bool RayCast(const DynamicTree& tree, RayCastInput input,
              const DynamicTreeRayCastCB& callback);
 
+/// @brief Cast rays against the leafs in the given wide tree.
+/// @details This calls the callback for the same leaves that ray casting the dynamic tree,
+///   that the given tree was made from, would.
+/// @see RayCast(const DynamicTree&, RayCastInput, const DynamicTreeRayCastCB&).
+/// @return <code>true</code> if terminated at the callback's request,
+///   <code>false</code> otherwise.
+bool RayCast(const WideDynamicTree& tree, RayCastInput input,
+             const DynamicTreeRayCastCB& callback);
+
 /// @brief Ray-cast the world for all fixtures in the path of the ray.
 ///
 /// @note The callback controls whether you get the closest point, any point, or n-points.
@@ -159,6 +202,33 @@ bool RayCast(const DynamicTree& tree, RayCastInput input,
 /// @relatedalso World
 bool RayCast(const World& world, const RayCastInput& input, const ShapeRayCastCB& callback);
 
+/// @brief Ray-casts the world for the closest shape hit by each of the given rays.
+///
+/// @details This is the batched equivalent of calling the callback based world ray-cast
+///   for each ray with a callback that clips the ray to every hit. It avoids the per-ray
+///   callback overhead and looks up each shape that's hit only once per batch.
+///
+/// @note Like the single ray-cast, this ignores shapes that contain the starting point.
+///
+/// @param world The world instance to raycast in.
+/// @param inputs Rays to cast.
+/// @param outputs Where the closest hit, if any, of each ray is written. Element
+///   <code>i</code> is for ray <code>inputs[i]</code>.
+/// @param filters Empty or the filter of each ray. Shapes whose filters shouldn't collide
+///   with a ray's filter are ignored by that ray.
+/// @param scheduler Optional task scheduler to cast the rays concurrently with.
+///
+/// @return Number of rays that hit a shape.
+///
+/// @throws InvalidArgument if <code>outputs</code> is smaller than <code>inputs</code>,
+///   or if <code>filters</code> is neither empty nor the same size as <code>inputs</code>.
+///
+/// @relatedalso World
+std::size_t RayCast(const World& world, const Span<const RayCastInput>& inputs,
+                    const Span<ShapeRayCastOutput>& outputs,
+                    const Span<const Filter>& filters = {},
+                    TaskScheduler* scheduler = nullptr);
+
 /// @}
 
 } // namespace d2
@@ -45,7 +45,7 @@ struct StepConf;
 namespace d2 {
 
 class World;
-class BodyConstraint;
+class BodyConstraintsMap;
 
 /// @example RevoluteJoint.cpp
 /// This is the <code>googletest</code> based unit testing file for the interfaces to
@@ -264,7 +264,7 @@ constexpr AngularMomentum GetAngularReaction(const RevoluteJointConf& conf) noex
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @see SolveVelocityConstraints.
 /// @relatedalso RevoluteJointConf
-void InitVelocity(RevoluteJointConf& object, const Span<BodyConstraint>& bodies,
+void InitVelocity(RevoluteJointConf& object, const BodyConstraintsMap& bodies,
                   const StepConf& step, const ConstraintSolverConf& conf);
 
 /// @brief Solves velocity constraint.
@@ -278,7 +278,7 @@ void InitVelocity(RevoluteJointConf& object, const Span<BodyConstraint>& bodies,
 /// @see InitVelocity.
 /// @return <code>true</code> if velocity is "solved", <code>false</code> otherwise.
 /// @relatedalso RevoluteJointConf
-bool SolveVelocity(RevoluteJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(RevoluteJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step);
 
 /// @brief Solves the position constraint.
@@ -290,7 +290,7 @@ bool SolveVelocity(RevoluteJointConf& object, const Span<BodyConstraint>& bodies
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @return <code>true</code> if the position errors are within tolerance.
 /// @relatedalso RevoluteJointConf
-bool SolvePosition(const RevoluteJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const RevoluteJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf);
 
 /// @brief Free function for setting the angular limits of the given configuration.
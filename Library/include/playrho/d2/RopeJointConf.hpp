@@ -46,7 +46,7 @@ namespace d2 {
 
 class Joint;
 class World;
-class BodyConstraint;
+class BodyConstraintsMap;
 
 /// @example RopeJoint.cpp
 /// This is the <code>googletest</code> based unit testing file for the interfaces to
@@ -161,7 +161,7 @@ constexpr auto ShiftOrigin(RopeJointConf&, const Length2&) noexcept
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @see SolveVelocity.
 /// @relatedalso RopeJointConf
-void InitVelocity(RopeJointConf& object, const Span<BodyConstraint>& bodies, const StepConf& step,
+void InitVelocity(RopeJointConf& object, const BodyConstraintsMap& bodies, const StepConf& step,
                   const ConstraintSolverConf& conf);
 
 /// @brief Solves velocity constraint.
@@ -175,7 +175,7 @@ void InitVelocity(RopeJointConf& object, const Span<BodyConstraint>& bodies, con
 /// @see InitVelocity.
 /// @return <code>true</code> if velocity is "solved", <code>false</code> otherwise.
 /// @relatedalso RopeJointConf
-bool SolveVelocity(RopeJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(RopeJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step);
 
 /// @brief Solves the position constraint.
@@ -187,7 +187,7 @@ bool SolveVelocity(RopeJointConf& object, const Span<BodyConstraint>& bodies,
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @return <code>true</code> if the position errors are within tolerance.
 /// @relatedalso RopeJointConf
-bool SolvePosition(const RopeJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const RopeJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf);
 
 /// @brief Free function for getting the maximum length value of the given configuration.
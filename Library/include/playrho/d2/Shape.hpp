@@ -212,6 +212,10 @@ bool operator!=(const Shape& lhs, const Shape& rhs) noexcept;
 ///   type.
 /// @note A shape can be constructed from or have its value set to any value whose type
 ///   <code>T</code> satisfies the requirement that <code>IsValidShapeTypeV<T> == true</code>.
+/// @note The value a shape refers to is never modified once made. Copies share it, and
+///   setting a property makes a new value that only the set shape refers to. So copying
+///   a shape doesn't allocate memory. That keeps getting shapes from a world cheap, like
+///   for every candidate of a ray cast.
 /// @ingroup PartsGroup
 /// @see https://youtu.be/QGcVXgEVMJg
 /// @see https://en.wikibooks.org/wiki/More_C%2B%2B_Idioms/Polymorphic_Value_Types
@@ -226,10 +230,8 @@ public:
     Shape() noexcept = default;
 
     /// @brief Copy constructor.
-    Shape(const Shape& other) : m_impl{other.m_impl ? other.m_impl->Clone_() : nullptr}
-    {
-        // Intentionally empty.
-    }
+    /// @post This shares the value of the given shape.
+    Shape(const Shape& other) noexcept = default;
 
     /// @brief Move constructor.
     Shape(Shape&& other) noexcept = default;
@@ -245,17 +247,14 @@ public:
     /// @throws std::bad_alloc if there's a failure allocating storage.
     template <typename T, typename Tp = DecayedTypeIfNotSame<T, Shape>,
               typename = std::enable_if_t<std::is_constructible_v<Tp, T>>>
-    explicit Shape(T&& arg) : m_impl{std::make_unique<detail::ShapeModel<Tp>>(std::forward<T>(arg))}
+    explicit Shape(T&& arg) : m_impl{std::make_shared<detail::ShapeModel<Tp>>(std::forward<T>(arg))}
     {
         // Intentionally empty.
     }
 
     /// @brief Copy assignment.
-    Shape& operator=(const Shape& other)
-    {
-        m_impl = other.m_impl ? other.m_impl->Clone_() : nullptr;
-        return *this;
-    }
+    /// @post This shares the value of the given shape.
+    Shape& operator=(const Shape& other) noexcept = default;
 
     /// @brief Move assignment operator.
     Shape& operator=(Shape&& other) = default;
@@ -444,7 +443,9 @@ public:
     }
 
 private:
-    std::unique_ptr<const detail::ShapeConcept> m_impl; ///< Pointer to implementation.
+    /// @brief Pointer to implementation.
+    /// @note This is shared by copies since what it points to is never modified.
+    std::shared_ptr<const detail::ShapeConcept> m_impl;
 };
 
 // Related non-member functions...
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef PLAYRHO_D2_SHAPECAST_HPP
+#define PLAYRHO_D2_SHAPECAST_HPP
+
+/// @file
+/// @brief Declaration of the ShapeCast function and its closely related code.
+
+#include <optional>
+
+// IWYU pragma: begin_exports
+
+#include <playrho/BodyID.hpp>
+#include <playrho/Filter.hpp>
+#include <playrho/ShapeID.hpp>
+#include <playrho/ToiConf.hpp>
+#include <playrho/ToiOutput.hpp>
+#include <playrho/UnitInterval.hpp>
+#include <playrho/Vector2.hpp>
+
+#include <playrho/d2/UnitVec.hpp>
+
+// IWYU pragma: end_exports
+
+namespace playrho::d2 {
+
+class DistanceProxy;
+struct Transformation;
+class World;
+
+/// @brief Shape-cast hit data.
+/// @see ShapeCast.
+struct ShapeCastHit
+{
+    /// @brief Identifier of the body of the shape that was hit.
+    BodyID body;
+
+    /// @brief Identifier of the shape that was hit.
+    ShapeID shape;
+
+    /// @brief Index of the child of the shape that was hit.
+    ChildCounter child;
+
+    /// @brief Fraction of the way from the starting location to the target location
+    ///   at which the cast proxy hit.
+    UnitIntervalFF<Real> fraction;
+
+    /// @brief Point in world coordinates where the cast proxy touched the hit shape.
+    Length2 point;
+
+    /// @brief Surface normal in world coordinates of the hit shape at the point of contact.
+    /// @note This points from the hit shape towards the cast proxy.
+    UnitVec normal;
+
+    /// @brief Time of impact output for the hit.
+    ToiOutput toi;
+};
+
+/// @brief Shape-cast output.
+/// @details This is a type alias for an optional <code>ShapeCastHit</code> instance.
+using ShapeCastOutput = std::optional<ShapeCastHit>;
+
+/// @brief Casts the given convex proxy through the given world for the closest shape hit.
+///
+/// @details Sweeps the proxy linearly from the given transformation to the given location,
+///   keeping its rotation, and finds the earliest time at which it touches a shape of the
+///   world. The dynamic tree is walked with the AABB of the remaining sweep which shrinks
+///   every time a closer hit is found. Times of impact are calculated by the same
+///   <code>GetToiViaSat</code> function that the world's continuous physics uses.
+///
+/// @note Shapes that the proxy already overlaps at the start of the sweep are ignored.
+/// @note Like for <code>GetToiViaSat</code>, the vertex radius of the proxy plus that of
+///   the shapes it's to hit should be greater than the target depth of the given
+///   configuration.
+///
+/// @param world The world instance to cast in.
+/// @param proxy Distance-proxy to cast (in local coordinates).
+/// @param from Transformation of the proxy at the start of the sweep.
+/// @param to Location of the proxy at the end of the sweep.
+/// @param filter Optional filter. If given, shapes whose filters shouldn't collide with
+///   it are ignored.
+/// @param conf Time of impact configuration.
+///
+/// @return Closest hit, if any.
+///
+/// @see GetToiViaSat.
+/// @relatedalso World
+ShapeCastOutput ShapeCast(const World& world, const DistanceProxy& proxy,
+                          const Transformation& from, const Length2& to,
+                          const std::optional<Filter>& filter = {},
+                          const ToiConf& conf = GetDefaultToiConf());
+
+} // namespace playrho::d2
+
+#endif // PLAYRHO_D2_SHAPECAST_HPP
@@ -44,6 +44,7 @@ struct StepConf;
 namespace d2 {
 
 class BodyConstraint;
+class BodyConstraintsMap;
 
 /// @example TargetJoint.cpp
 /// This is the <code>googletest</code> based unit testing file for the interfaces to
@@ -225,7 +226,7 @@ Mass22 GetEffectiveMassMatrix(const TargetJointConf& object, const BodyConstrain
 ///  <code>InvalidBodyID</code> and does not index within range of the given <code>bodies</code> container.
 /// @see SolveVelocity.
 /// @relatedalso TargetJointConf
-void InitVelocity(TargetJointConf& object, const Span<BodyConstraint>& bodies,
+void InitVelocity(TargetJointConf& object, const BodyConstraintsMap& bodies,
                   const StepConf& step, const ConstraintSolverConf& conf);
 
 /// @brief Solves velocity constraint.
@@ -239,14 +240,14 @@ void InitVelocity(TargetJointConf& object, const Span<BodyConstraint>& bodies,
 /// @see InitVelocity.
 /// @return <code>true</code> if velocity is "solved", <code>false</code> otherwise.
 /// @relatedalso TargetJointConf
-bool SolveVelocity(TargetJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(TargetJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step);
 
 /// @brief Solves the position constraint.
 /// @note This is a no-op and always returns <code>true</code>.
 /// @return <code>true</code>.
 /// @relatedalso TargetJointConf
-bool SolvePosition(const TargetJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const TargetJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf);
 
 /// @brief Free function for setting the target value of the given configuration.
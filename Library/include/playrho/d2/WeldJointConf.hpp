@@ -45,7 +45,7 @@ struct StepConf;
 namespace d2 {
 
 class World;
-class BodyConstraint;
+class BodyConstraintsMap;
 
 /// @example WeldJoint.cpp
 /// This is the <code>googletest</code> based unit testing file for the interfaces to
@@ -193,7 +193,7 @@ constexpr auto ShiftOrigin(WeldJointConf&, const Length2&) noexcept
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @see SolveVelocity.
 /// @relatedalso WeldJointConf
-void InitVelocity(WeldJointConf& object, const Span<BodyConstraint>& bodies, const StepConf& step,
+void InitVelocity(WeldJointConf& object, const BodyConstraintsMap& bodies, const StepConf& step,
                   const ConstraintSolverConf& conf);
 
 /// @brief Solves velocity constraint.
@@ -207,7 +207,7 @@ void InitVelocity(WeldJointConf& object, const Span<BodyConstraint>& bodies, con
 /// @see InitVelocity.
 /// @return <code>true</code> if velocity is "solved", <code>false</code> otherwise.
 /// @relatedalso WeldJointConf
-bool SolveVelocity(WeldJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(WeldJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step);
 
 /// @brief Solves the position constraint.
@@ -219,7 +219,7 @@ bool SolveVelocity(WeldJointConf& object, const Span<BodyConstraint>& bodies,
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @return <code>true</code> if the position errors are within tolerance.
 /// @relatedalso WeldJointConf
-bool SolvePosition(const WeldJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const WeldJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf);
 
 /// @brief Free function for setting the frequency of the given configuration.
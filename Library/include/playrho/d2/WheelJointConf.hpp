@@ -50,7 +50,7 @@ struct StepConf;
 namespace playrho::d2 {
 
 class World;
-class BodyConstraint;
+class BodyConstraintsMap;
 
 /// @example WheelJoint.cpp
 /// This is the <code>googletest</code> based unit testing file for the interfaces to
@@ -250,7 +250,7 @@ constexpr auto ShiftOrigin(WheelJointConf&, const Length2&)
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @see SolveVelocity.
 /// @relatedalso WheelJointConf
-void InitVelocity(WheelJointConf& object, const Span<BodyConstraint>& bodies, const StepConf& step,
+void InitVelocity(WheelJointConf& object, const BodyConstraintsMap& bodies, const StepConf& step,
                   const ConstraintSolverConf& conf);
 
 /// @brief Solves velocity constraint.
@@ -264,7 +264,7 @@ void InitVelocity(WheelJointConf& object, const Span<BodyConstraint>& bodies, co
 /// @see InitVelocity.
 /// @return <code>true</code> if velocity is "solved", <code>false</code> otherwise.
 /// @relatedalso WheelJointConf
-bool SolveVelocity(WheelJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(WheelJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step);
 
 /// @brief Solves the position constraint.
@@ -276,7 +276,7 @@ bool SolveVelocity(WheelJointConf& object, const Span<BodyConstraint>& bodies,
 ///  <code>InvalidBodyID</code> and are not  indices within range of the given <code>bodies</code> container.
 /// @return <code>true</code> if the position errors are within tolerance.
 /// @relatedalso WheelJointConf
-bool SolvePosition(const WheelJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const WheelJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf);
 
 /// @brief Sets the maximum motor torque for the given configuration.
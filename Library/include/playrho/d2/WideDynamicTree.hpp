@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef PLAYRHO_D2_WIDEDYNAMICTREE_HPP
+#define PLAYRHO_D2_WIDEDYNAMICTREE_HPP
+
+/// @file
+/// @brief Declaration of the <code>WideDynamicTree</code> class.
+
+#include <array>
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t
+#include <vector>
+
+// IWYU pragma: begin_exports
+
+#include <playrho/Contactable.hpp>
+#include <playrho/Real.hpp>
+
+#include <playrho/d2/AABB.hpp>
+#include <playrho/d2/DynamicTree.hpp>
+
+// IWYU pragma: end_exports
+
+namespace playrho::d2 {
+
+/// @brief A read-only, 4-wide bounding volume hierarchy made from a <code>DynamicTree</code>.
+///
+/// @details This is a snapshot of a dynamic tree that's been collapsed so every branch node
+///   has up to four children. The bounds of a node's children are stored in structure of
+///   arrays form in the node itself. That way testing all of a node's children against a
+///   query takes one pass over contiguous values, which the compiler can turn into vector
+///   instructions, and walking the hierarchy takes about half as many node visits as walking
+///   the binary tree it was made from.
+///
+/// @note This doesn't update along with the tree it was made from. It's meant for when
+///   lots of queries are going to be made against a tree that isn't going to change in
+///   the meantime, like when finding new contacts for many proxies at once.
+/// @note Leaves are identified by their index within the dynamic tree they came from, so
+///   query results can be used with that tree like the results of querying it directly.
+///
+/// @see DynamicTree, Query(const WideDynamicTree&, const AABB&, const DynamicTreeSizeCB&).
+///
+class WideDynamicTree
+{
+public:
+    /// @brief Size type.
+    using Size = DynamicTree::Size;
+
+    /// @brief Partition type.
+    using Partition = DynamicTree::Partition;
+
+    /// @brief Invalid size constant value.
+    static constexpr auto InvalidSize = DynamicTree::InvalidSize;
+
+    /// @brief Maximum number of children that a node can have.
+    static constexpr auto Width = std::size_t{4};
+
+    /// @brief Node of a wide dynamic tree.
+    /// @details Bounds of child slots at or beyond <code>count</code> are empty intervals.
+    struct Node
+    {
+        std::array<Real, Width> minX; ///< Minimum X values of the children's AABBs in meters.
+        std::array<Real, Width> minY; ///< Minimum Y values of the children's AABBs in meters.
+        std::array<Real, Width> maxX; ///< Maximum X values of the children's AABBs in meters.
+        std::array<Real, Width> maxY; ///< Maximum Y values of the children's AABBs in meters.
+
+        /// @brief Indices of the children.
+        /// @details Indices of leaf children are for <code>GetLeaf</code>, while indices
+        ///   of other children are for <code>GetNode</code>.
+        std::array<Size, Width> children;
+
+        std::uint8_t count; ///< Number of children this node has.
+        std::uint8_t leafMask; ///< Bit mask of which of the children are leaves.
+    };
+
+    /// @brief Leaf of a wide dynamic tree.
+    struct Leaf
+    {
+        Size index; ///< Index of the leaf in the dynamic tree this came from.
+        Contactable data; ///< Leaf data.
+    };
+
+    /// @brief Default constructor.
+    /// @post <code>GetRootIndex()</code> returns <code>InvalidSize</code>.
+    WideDynamicTree() noexcept = default;
+
+    /// @brief Initializing constructor.
+    /// @post This is the collapsed equivalent of the given tree.
+    /// @see Rebuild.
+    explicit WideDynamicTree(const DynamicTree& tree);
+
+    /// @brief Rebuilds this from the given tree.
+    /// @details Already allocated storage is reused, so repeatedly rebuilding the same
+    ///   instance is cheaper than repeatedly constructing new ones.
+    /// @post This is the collapsed equivalent of the given tree. The sub-tree of each of the
+    ///   given tree's partitions becomes a sub-tree of its own in this.
+    void Rebuild(const DynamicTree& tree);
+
+    /// @brief Clears this.
+    /// @post <code>GetRootIndex()</code> returns <code>InvalidSize</code>.
+    void Clear() noexcept;
+
+    /// @brief Gets the index of the root node, or <code>InvalidSize</code> if empty.
+    Size GetRootIndex() const noexcept;
+
+    /// @brief Gets the index of the root node of the sub-tree of the given partition.
+    /// @return Index of a node or <code>InvalidSize</code> if the partition is empty.
+    /// @see DynamicTree::GetRootIndex(Partition).
+    Size GetRootIndex(Partition partition) const noexcept;
+
+    /// @brief Gets the number of nodes.
+    Size GetNodeCount() const noexcept;
+
+    /// @brief Gets the number of leaves.
+    Size GetLeafCount() const noexcept;
+
+    /// @brief Gets the node at the given index.
+    /// @pre @p index is less than <code>GetNodeCount()</code>.
+    const Node& GetNode(Size index) const noexcept;
+
+    /// @brief Gets the leaf at the given index.
+    /// @pre @p index is less than <code>GetLeafCount()</code>.
+    const Leaf& GetLeaf(Size index) const noexcept;
+
+private:
+    /// @brief Collapses the sub-tree of the given tree rooted at the given index.
+    /// @return Index of the new node.
+    Size Collapse(const DynamicTree& tree, Size index);
+
+    std::vector<Node> m_nodes; ///< Nodes. The first node is the root unless empty.
+    std::vector<Leaf> m_leaves; ///< Leaves in depth first order.
+    Size m_rootIndex{InvalidSize}; ///< Index of the root node.
+    Size m_staticRootIndex{InvalidSize}; ///< Index of the static partition's root node.
+    Size m_dynamicRootIndex{InvalidSize}; ///< Index of the dynamic partition's root node.
+};
+
+inline WideDynamicTree::Size WideDynamicTree::GetRootIndex() const noexcept
+{
+    return m_rootIndex;
+}
+
+inline WideDynamicTree::Size WideDynamicTree::GetRootIndex(Partition partition) const noexcept
+{
+    return (partition == Partition::Static)? m_staticRootIndex: m_dynamicRootIndex;
+}
+
+inline WideDynamicTree::Size WideDynamicTree::GetNodeCount() const noexcept
+{
+    return static_cast<Size>(m_nodes.size());
+}
+
+inline WideDynamicTree::Size WideDynamicTree::GetLeafCount() const noexcept
+{
+    return static_cast<Size>(m_leaves.size());
+}
+
+inline const WideDynamicTree::Node& WideDynamicTree::GetNode(Size index) const noexcept
+{
+    assert(index < GetNodeCount());
+    return m_nodes[index];
+}
+
+inline const WideDynamicTree::Leaf& WideDynamicTree::GetLeaf(Size index) const noexcept
+{
+    assert(index < GetLeafCount());
+    return m_leaves[index];
+}
+
+/// @brief Query the given wide dynamic tree and find leaves overlapping the given AABB.
+/// @details This finds the same leaves that querying the dynamic tree, that the given tree
+///   was made from, would find. The callback is called with their dynamic tree indices.
+/// @relatedalso WideDynamicTree
+void Query(const WideDynamicTree& tree, const AABB& aabb, const DynamicTreeSizeCB& callback);
+
+/// @brief Query the sub-tree of the given wide dynamic tree rooted at the given node index
+///   and find leaves overlapping the given AABB.
+/// @param tree Tree to query.
+/// @param root Index of the node to start from, or <code>WideDynamicTree::InvalidSize</code>.
+/// @param aabb AABB to find overlapping leaves for.
+/// @param callback Function called with the dynamic tree index of each overlapping leaf.
+/// @relatedalso WideDynamicTree
+void Query(const WideDynamicTree& tree, WideDynamicTree::Size root, const AABB& aabb,
+           const DynamicTreeSizeCB& callback);
+
+} // namespace playrho::d2
+
+#endif // PLAYRHO_D2_WIDEDYNAMICTREE_HPP
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef PLAYRHO_D2_WIDEVELOCITYCONSTRAINTS_HPP
+#define PLAYRHO_D2_WIDEVELOCITYCONSTRAINTS_HPP
+
+/// @file
+/// @brief Declaration of the <code>WideVelocityConstraints</code> class.
+
+#include <array>
+#include <cassert> // for assert
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t
+#include <vector>
+
+// IWYU pragma: begin_exports
+
+#include <playrho/BodyID.hpp>
+#include <playrho/Real.hpp>
+#include <playrho/Span.hpp>
+#include <playrho/Units.hpp>
+
+// IWYU pragma: end_exports
+
+namespace playrho::d2 {
+
+class BodyConstraint;
+class VelocityConstraint;
+
+/// @brief Velocity constraints packed into 4-wide bundles for solving many at once.
+///
+/// @details This is a structure of arrays copy of velocity constraints in which each bundle
+///   holds up to four constraints that don't share any movable body. With no two lanes of a
+///   bundle reading or writing the velocity of the same movable body, a whole bundle can be
+///   solved in one pass over contiguous values that the compiler can turn into vector
+///   instructions, instead of solving the constraints one at a time.
+///
+/// @note Bodies having zero inverse mass and zero inverse rotational inertia don't keep
+///   constraints from sharing a bundle since solving doesn't change their velocities.
+/// @note Constraints are solved in the order of the bundles they're in. That's not the order
+///   that they were given in, so the results match those of solving the constraints one at
+///   a time only to within the tolerance of a Gauss-Seidel iteration.
+///
+/// @see VelocityConstraint, GaussSeidel::SolveVelocityConstraint.
+///
+class WideVelocityConstraints
+{
+public:
+    /// @brief Maximum number of constraints that a bundle can have.
+    static constexpr auto Width = std::size_t{4};
+
+    /// @brief Lane values of a bundle.
+    using Lanes = std::array<Real, Width>;
+
+    /// @brief Point values of a bundle's constraints.
+    /// @details Values are in the SI units of the like named <code>VelocityConstraint</code>
+    ///   point values.
+    struct Point
+    {
+        Lanes relAX; ///< X values of the point positions relative to body A.
+        Lanes relAY; ///< Y values of the point positions relative to body A.
+        Lanes relBX; ///< X values of the point positions relative to body B.
+        Lanes relBY; ///< Y values of the point positions relative to body B.
+        Lanes normalMass; ///< Normal masses.
+        Lanes tangentMass; ///< Tangent masses.
+        Lanes velocityBias; ///< Velocity biases.
+        Lanes normalImpulse; ///< Normal impulses.
+        Lanes tangentImpulse; ///< Tangent impulses.
+        Lanes active; ///< One for lanes having this point, zero otherwise.
+    };
+
+    /// @brief Bundle of up to <code>Width</code> velocity constraints.
+    /// @details Values of lanes at or beyond <code>count</code> are zero so solving them
+    ///   doesn't change anything.
+    struct Bundle
+    {
+        std::array<BodyID, Width> bodyA; ///< Island-local identifiers of the A bodies.
+        std::array<BodyID, Width> bodyB; ///< Island-local identifiers of the B bodies.
+        std::array<std::size_t, Width> constraints; ///< Indices of the source constraints.
+        Lanes invMassA; ///< Inverse masses of the A bodies.
+        Lanes invRotInertiaA; ///< Inverse rotational inertias of the A bodies.
+        Lanes invMassB; ///< Inverse masses of the B bodies.
+        Lanes invRotInertiaB; ///< Inverse rotational inertias of the B bodies.
+        Lanes normalX; ///< X values of the normals.
+        Lanes normalY; ///< Y values of the normals.
+        Lanes friction; ///< Friction coefficients.
+        Lanes tangentSpeed; ///< Tangent speeds.
+        Lanes k11; ///< Block solver K values at row 1 column 1.
+        Lanes k12; ///< Block solver K values at row 1 column 2 and at row 2 column 1.
+        Lanes k22; ///< Block solver K values at row 2 column 2.
+        Lanes normalMass11; ///< Block solver normal masses at row 1 column 1.
+        Lanes normalMass12; ///< Block solver normal masses at row 1 column 2 and 2, 1.
+        Lanes normalMass22; ///< Block solver normal masses at row 2 column 2.
+        Lanes blockSolve; ///< One for lanes to block solve the normal constraint, else zero.
+        std::array<Point, 2> points; ///< Points.
+        std::uint8_t count; ///< Number of constraints this bundle has.
+    };
+
+    /// @brief Default constructor.
+    WideVelocityConstraints() noexcept = default;
+
+    /// @brief Initializing constructor.
+    /// @see Assign.
+    WideVelocityConstraints(const Span<const VelocityConstraint>& constraints,
+                            const Span<const BodyConstraint>& bodies);
+
+    /// @brief Assigns this from the given constraints.
+    /// @details Already allocated storage is reused, so repeatedly assigning to the same
+    ///   instance is cheaper than repeatedly constructing new ones.
+    /// @param constraints Constraints to pack into bundles. Their body identifiers must
+    ///   be indices into the given bodies.
+    /// @param bodies Bodies of the given constraints.
+    void Assign(const Span<const VelocityConstraint>& constraints,
+                const Span<const BodyConstraint>& bodies);
+
+    /// @brief Clears this.
+    void Clear() noexcept;
+
+    /// @brief Solves the constraints, updating the given bodies' velocities.
+    /// @details This updates the impulses of this instance's copy of the constraints and
+    ///   the velocities of the given bodies like
+    ///   <code>GaussSeidel::SolveVelocityConstraint</code> does for each constraint.
+    /// @param bodies The bodies this was assigned with.
+    /// @return Maximum momentum used for solving both the tangential and normal portions
+    ///   of the constraints.
+    /// @see Store.
+    Momentum Solve(const Span<BodyConstraint>& bodies);
+
+    /// @brief Stores the impulses of this instance's copy of the constraints into the
+    ///   given constraints.
+    /// @param constraints The constraints this was assigned with.
+    void Store(const Span<VelocityConstraint>& constraints) const;
+
+    /// @brief Gets the number of bundles.
+    std::size_t GetBundleCount() const noexcept;
+
+    /// @brief Gets the bundle at the given index.
+    /// @pre @p index is less than <code>GetBundleCount()</code>.
+    const Bundle& GetBundle(std::size_t index) const noexcept;
+
+private:
+    std::vector<Bundle> m_bundles; ///< Bundles in the order they're solved in.
+};
+
+inline std::size_t WideVelocityConstraints::GetBundleCount() const noexcept
+{
+    return size(m_bundles);
+}
+
+inline const WideVelocityConstraints::Bundle&
+WideVelocityConstraints::GetBundle(std::size_t index) const noexcept
+{
+    assert(index < GetBundleCount());
+    return m_bundles[index];
+}
+
+} // namespace playrho::d2
+
+#endif // PLAYRHO_D2_WIDEVELOCITYCONSTRAINTS_HPP
@@ -60,7 +60,9 @@
 #include <playrho/pmr/StatsResource.hpp>
 
 #include <playrho/d2/Body.hpp>
+#include <playrho/d2/BodyStateSpans.hpp>
 #include <playrho/d2/BodyConf.hpp> // for GetDefaultBodyConf
+#include <playrho/d2/ContactEvents.hpp>
 #include <playrho/d2/ContactImpulsesFunction.hpp>
 #include <playrho/d2/ContactManifoldFunction.hpp>
 #include <playrho/d2/Joint.hpp>
@@ -192,6 +194,16 @@ bool operator!=(const World& lhs, const World& rhs) noexcept;
 /// @see WorldConf.
 std::optional<pmr::StatsResource::Stats> GetResourceStats(const World& world) noexcept;
 
+/// @brief Gets the contact events recorded by the specified world since its last step began.
+/// @note These are always empty unless the world configuration the given world was
+///   constructed with specified the recording of these events.
+/// @note Contact events recorded outside of a step, like end contact events from destroying
+///   a body, are kept until the step after the next one begins. So they can be gotten
+///   along with the events of the next step as well as before it.
+/// @param world The world to get the recorded contact events of.
+/// @see WorldConf::doContactEvents.
+const ContactEvents& GetContactEvents(const World& world) noexcept;
+
 /// @brief Clears the given world.
 /// @note This calls the joint and shape destruction listeners (if they're set), for all
 ///   defined joints and shapes, before clearing anything. Any exceptions thrown from these
@@ -337,10 +349,13 @@ std::vector<BodyID> GetBodiesForProxies(const World& world);
 BodyID CreateBody(World& world, const Body& body = Body{}, bool resetMassData = true);
 
 /// @brief Gets the state of the identified body.
+/// @details This provides read access to the body in place, without copying it.
+/// @note The returned reference is only valid until the world is next modified. Copy
+///   the body if its state is needed beyond that.
 /// @throws std::out_of_range If given an out of range body identifier.
 /// @see CreateBody(World&, const Body&, bool), SetBody(World&, BodyID, const Body&),
 ///   GetBodyRange.
-Body GetBody(const World& world, BodyID id);
+const Body& GetBody(const World& world, BodyID id);
 
 /// @brief Sets the state of the identified body.
 /// @param world The world containing the identified body whose state is to be set.
@@ -354,6 +369,35 @@ Body GetBody(const World& world, BodyID id);
 /// @see GetBody(const World&, BodyID), GetBodyRange, GetShapeRange.
 void SetBody(World& world, BodyID id, const Body& body);
 
+/// @brief Gets the states of the identified bodies.
+/// @details Fills each non-empty span of the given states with the values of the
+///   identified bodies, in the order of the given identifiers. This is meant for copying
+///   the states of many bodies out of the world at once, like for rendering them.
+/// @param world The world containing the identified bodies.
+/// @param ids Identifiers of the bodies whose states are to be gotten.
+/// @param states Spans to fill. Empty ones are skipped.
+/// @throws InvalidArgument if a non-empty span of @p states doesn't have the same size as
+///   @p ids.
+/// @throws std::out_of_range if any of the given identifiers are out of range.
+/// @see SetBodyStates(World&, Span<const BodyID>, const ConstBodyStateSpans&).
+void GetBodyStates(const World& world, Span<const BodyID> ids, const BodyStateSpans& states);
+
+/// @brief Sets the states of the identified bodies.
+/// @details Sets the identified bodies' values from each non-empty span of the given states,
+///   like calling <code>SetTransformation</code>, <code>SetVelocity</code>, or
+///   <code>SetAcceleration</code> for each of them would do.
+/// @note A body whose location or angle is set, but not both, keeps its other value.
+/// @param world The world containing the identified bodies.
+/// @param ids Identifiers of the bodies whose states are to be set.
+/// @param states Spans of the new values. Empty ones are skipped.
+/// @throws WrongState if this function is called while the world is locked.
+/// @throws InvalidArgument if a non-empty span of @p states doesn't have the same size as
+///   @p ids, or if any of the identified bodies were destroyed.
+/// @throws std::out_of_range if any of the given identifiers are out of range.
+/// @post Nothing's been set if this throws.
+/// @see GetBodyStates(const World&, Span<const BodyID>, const BodyStateSpans&).
+void SetBodyStates(World& world, Span<const BodyID> ids, const ConstBodyStateSpans& states);
+
 /// @brief Destroys the identified body.
 /// @details Destroys the identified body that had previously been created by a call
 ///   to this world's <code>CreateBody(const BodyConf&)</code> function.
@@ -789,6 +833,7 @@ public:
     friend bool operator!=(const World& lhs, const World& rhs) noexcept;
 
     friend std::optional<pmr::StatsResource::Stats> GetResourceStats(const World& world) noexcept;
+    friend const ContactEvents& GetContactEvents(const World& world) noexcept;
     friend void Clear(World& world) noexcept;
     friend StepStats Step(World& world, const StepConf& conf);
     friend bool IsStepComplete(const World& world) noexcept;
@@ -805,8 +850,25 @@ public:
     friend std::vector<BodyID> GetBodies(const World& world);
     friend std::vector<BodyID> GetBodiesForProxies(const World& world);
     friend BodyID CreateBody(World& world, const Body& body, bool resetMassData);
-    friend Body GetBody(const World& world, BodyID id);
+    friend const Body& GetBody(const World& world, BodyID id);
     friend void SetBody(World& world, BodyID id, const Body& body);
+
+    // Body in-place setter friend functions (see WorldBody.hpp)...
+    friend void SetTransformation(World& world, BodyID id, const Transformation& value);
+    friend void SetVelocity(World& world, BodyID id, const Velocity& value);
+    friend void SetAcceleration(World& world, BodyID id, const Acceleration& value);
+    friend void SetAwake(World& world, BodyID id);
+    friend void UnsetAwake(World& world, BodyID id);
+    friend void SetImpenetrable(World& world, BodyID id);
+    friend void UnsetImpenetrable(World& world, BodyID id);
+    friend void SetSleepingAllowed(World& world, BodyID id, bool value);
+    friend void ApplyLinearImpulse(World& world, BodyID id, const Momentum2& impulse,
+                                   const Length2& point);
+    friend void ApplyAngularImpulse(World& world, BodyID id, AngularMomentum impulse);
+    friend void GetBodyStates(const World& world, Span<const BodyID> ids,
+                              const BodyStateSpans& states);
+    friend void SetBodyStates(World& world, Span<const BodyID> ids,
+                              const ConstBodyStateSpans& states);
     friend void Destroy(World& world, BodyID id);
     friend std::vector<std::pair<BodyID, JointID>> GetJoints(const World& world, BodyID id);
     friend std::vector<std::tuple<ContactKey, ContactID>> GetContacts(const World& world, BodyID id);
@@ -909,6 +971,11 @@ inline std::optional<pmr::StatsResource::Stats> GetResourceStats(const World& wo
     return world.m_impl->GetResourceStats_();
 }
 
+inline const ContactEvents& GetContactEvents(const World& world) noexcept
+{
+    return world.m_impl->GetContactEvents_();
+}
+
 inline void Clear(World& world) noexcept
 {
     world.m_impl->Clear_();
@@ -976,7 +1043,7 @@ inline std::vector<BodyID> GetBodiesForProxies(const World& world)
     return world.m_impl->GetBodiesForProxies_();
 }
 
-inline Body GetBody(const World& world, BodyID id)
+inline const Body& GetBody(const World& world, BodyID id)
 {
     return world.m_impl->GetBody_(id);
 }
@@ -986,6 +1053,18 @@ inline void SetBody(World& world, BodyID id, const Body& body)
     world.m_impl->SetBody_(id, body);
 }
 
+inline void GetBodyStates(const World& world, Span<const BodyID> ids,
+                          const BodyStateSpans& states)
+{
+    world.m_impl->GetBodyStates_(ids, states);
+}
+
+inline void SetBodyStates(World& world, Span<const BodyID> ids,
+                          const ConstBodyStateSpans& states)
+{
+    world.m_impl->SetBodyStates_(ids, states);
+}
+
 inline void Destroy(World& world, BodyID id)
 {
     world.m_impl->Destroy_(id);
@@ -31,6 +31,8 @@
 #include <playrho/Interval.hpp>
 #include <playrho/Positive.hpp>
 #include <playrho/Settings.hpp>
+#include <playrho/TaskScheduler.hpp>
+#include <playrho/Tracer.hpp>
 #include <playrho/Units.hpp>
 
 #include <playrho/pmr/MemoryResource.hpp> // for pmr things
@@ -79,9 +81,21 @@ struct WorldConf {
     /// @brief Default do-stats value.
     static constexpr auto DefaultDoStats = false;
 
+    /// @brief Default do-step-arena value.
+    static constexpr auto DefaultDoStepArena = false;
+
+    /// @brief Default do-contact-events value.
+    static constexpr auto DefaultDoContactEvents = false;
+
     /// @brief Uses the given min vertex radius value.
     constexpr WorldConf& UseUpstream(pmr::memory_resource *value) noexcept;
 
+    /// @brief Uses the given task scheduler.
+    constexpr WorldConf& UseTaskScheduler(TaskScheduler *value) noexcept;
+
+    /// @brief Uses the given tracer.
+    constexpr WorldConf& UseTracer(Tracer *value) noexcept;
+
     /// @brief Uses the given vertex radius range value.
     constexpr WorldConf& UseVertexRadius(const Interval<Positive<Length>>& value) noexcept;
 
@@ -97,6 +111,20 @@ struct WorldConf {
     /// @brief Upstream memory resource.
     pmr::memory_resource *upstream = DefaultUpstream;
 
+    /// @brief Task scheduler.
+    /// @details When non-null, the world uses this to solve independent islands concurrently.
+    ///   Results are the same as when this is null.
+    /// @warning The pointed to object must stay valid for the life of the configured world.
+    /// @warning The upstream memory resource must be thread-safe when this is non-null.
+    TaskScheduler *taskScheduler = nullptr;
+
+    /// @brief Tracer.
+    /// @details When non-null, the world reports the begin and end of the phases of its
+    ///   steps to this.
+    /// @warning The pointed to object must stay valid for the life of the configured world.
+    /// @warning This must be thread-safe when the task scheduler is non-null.
+    Tracer *tracer = nullptr;
+
     /// @brief Allowable vertex radius range.
     /// @details The allowable vertex radius range that this world establishes which
     ///   shapes may be created with. Trying to create a shape having a vertex radius
@@ -147,6 +175,27 @@ struct WorldConf {
     ///    getting those data members tweaked to your needs.
     /// @see GetResourceStats(const World&).
     bool doStats = DefaultDoStats;
+
+    /// @brief Whether to use a step arena for per-step scratch data or not.
+    /// @details When true, the data the world only needs while stepping, like its islands
+    ///   and constraints, gets allocated from a monotonic arena that's released at the end
+    ///   of every step, instead of from the pool resources sized by the @c reserve* data
+    ///   members. The arena grows to the most memory ever needed by a step, so that after
+    ///   a few warm-up steps, stepping no longer allocates from the upstream resource for
+    ///   this data.
+    /// @note The initial size of the arena is the sum of the sizes the @c reserve* data
+    ///   members call for.
+    /// @see GetStepArenaStats(const AabbTreeWorld&).
+    bool doStepArena = DefaultDoStepArena;
+
+    /// @brief Whether to record contact events or not.
+    /// @details When true, the world records begin, end, pre-solve, and post-solve contact
+    ///   events into contiguous arrays. Every step erases the events that were there when the
+    ///   last step ended, so after a step they hold the events of that step preceded by any
+    ///   recorded between the two steps. This is independent of the contact listeners which
+    ///   still get called if they're set.
+    /// @see GetContactEvents(const World&).
+    bool doContactEvents = DefaultDoContactEvents;
 };
 
 constexpr WorldConf& WorldConf::UseUpstream(pmr::memory_resource *value) noexcept
@@ -155,6 +204,18 @@ constexpr WorldConf& WorldConf::UseUpstream(pmr::memory_resource *value) noexcep
     return *this;
 }
 
+constexpr WorldConf& WorldConf::UseTaskScheduler(TaskScheduler *value) noexcept
+{
+    taskScheduler = value;
+    return *this;
+}
+
+constexpr WorldConf& WorldConf::UseTracer(Tracer *value) noexcept
+{
+    tracer = value;
+    return *this;
+}
+
 constexpr WorldConf& WorldConf::UseVertexRadius(const Interval<Positive<Length>>& value) noexcept
 {
     vertexRadius = value;
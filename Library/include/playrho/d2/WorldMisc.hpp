@@ -25,15 +25,20 @@
 /// @file
 /// @brief Declarations of free functions of World for unidentified information.
 
+#include <cstddef> // for std::size_t
+
 // IWYU pragma: begin_exports
 
 #include <playrho/BodyID.hpp>
 #include <playrho/JointID.hpp>
 #include <playrho/ContactID.hpp>
+#include <playrho/Filter.hpp>
+#include <playrho/Span.hpp>
 #include <playrho/StepConf.hpp>
 #include <playrho/StepStats.hpp>
 #include <playrho/ShapeID.hpp>
 
+#include <playrho/d2/AABB.hpp>
 #include <playrho/d2/Math.hpp>
 
 // IWYU pragma: end_exports
@@ -80,6 +85,47 @@ StepStats Step(World& world, Time delta,
                TimestepIters velocityIterations = StepConf::DefaultRegVelocityIters,
                TimestepIters positionIterations = StepConf::DefaultRegPositionIters);
 
+/// @brief Shape query hit data.
+/// @see Query(const World&, const Span<const AABB>&, const Filter&, const Span<ShapeQueryHit>&).
+struct ShapeQueryHit
+{
+    /// @brief Index of the query AABB that the hit is for.
+    std::size_t query;
+
+    /// @brief Identifier of the body of the shape that was hit.
+    BodyID body;
+
+    /// @brief Identifier of the shape that was hit.
+    ShapeID shape;
+
+    /// @brief Index of the child of the shape that was hit.
+    ChildCounter child;
+};
+
+/// @brief Queries the world for the shape children that potentially overlap each of the
+///   given AABBs and that should collide with the given filter.
+///
+/// @details This is the batched equivalent of querying the world's dynamic tree for each
+///   of the given AABBs and filtering the results by their shapes' filters. Filters are
+///   evaluated during the tree walk with each shape's filter only looked up once per call,
+///   and no callbacks are involved.
+///
+/// @note Hits are written in order of their query index. Writing stops once the given
+///   span is full, but hits continue to be counted. So a return value that's greater than
+///   the size of <code>hits</code> means the given span was too small.
+///
+/// @param world The world to query.
+/// @param aabbs The query boxes.
+/// @param filter Filter that the filters of the hit shapes should collide with.
+/// @param hits Where hits get written to.
+///
+/// @return Count of hits found.
+///
+/// @see ShouldCollide(Filter, Filter), GetTree(const World&).
+/// @relatedalso World
+std::size_t Query(const World& world, const Span<const AABB>& aabbs, const Filter& filter,
+                  const Span<ShapeQueryHit>& hits);
+
 } // namespace playrho::d2
 
 #endif // PLAYRHO_D2_WORLDMISC_HPP
@@ -37,7 +37,7 @@ struct ConstraintSolverConf;
 }
 
 namespace playrho::d2 {
-class BodyConstraint;
+class BodyConstraintsMap;
 }
 
 namespace playrho::d2::detail {
@@ -80,14 +80,14 @@ struct JointConcept {
     virtual bool ShiftOrigin_(const Length2& value) noexcept = 0;
 
     /// @brief Initializes the velocities for this joint.
-    virtual void InitVelocity_(const Span<BodyConstraint>& bodies, const StepConf& step,
+    virtual void InitVelocity_(const BodyConstraintsMap& bodies, const StepConf& step,
                                const ConstraintSolverConf& conf) = 0;
 
     /// @brief Solves the velocities for this joint.
-    virtual bool SolveVelocity_(const Span<BodyConstraint>& bodies, const StepConf& step) = 0;
+    virtual bool SolveVelocity_(const BodyConstraintsMap& bodies, const StepConf& step) = 0;
 
     /// @brief Solves the positions for this joint.
-    virtual bool SolvePosition_(const Span<BodyConstraint>& bodies,
+    virtual bool SolvePosition_(const BodyConstraintsMap& bodies,
                                 const ConstraintSolverConf& conf) const = 0;
 };
 
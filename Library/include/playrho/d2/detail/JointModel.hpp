@@ -107,20 +107,20 @@ struct JointModel final : JointConcept {
     }
 
     /// @copydoc JointConcept::InitVelocity_
-    void InitVelocity_(const Span<BodyConstraint>& bodies, const playrho::StepConf& step,
+    void InitVelocity_(const BodyConstraintsMap& bodies, const playrho::StepConf& step,
                        const ConstraintSolverConf& conf) override
     {
         InitVelocity(data, bodies, step, conf);
     }
 
     /// @copydoc JointConcept::SolveVelocity_
-    bool SolveVelocity_(const Span<BodyConstraint>& bodies, const playrho::StepConf& step) override
+    bool SolveVelocity_(const BodyConstraintsMap& bodies, const playrho::StepConf& step) override
     {
         return SolveVelocity(data, bodies, step);
     }
 
     /// @copydoc JointConcept::SolvePosition_
-    bool SolvePosition_(const Span<BodyConstraint>& bodies,
+    bool SolvePosition_(const BodyConstraintsMap& bodies,
                         const ConstraintSolverConf& conf) const override
     {
         return SolvePosition(data, bodies, conf);
@@ -47,6 +47,8 @@
 #include <playrho/pmr/StatsResource.hpp>
 
 #include <playrho/d2/Body.hpp>
+#include <playrho/d2/BodyStateSpans.hpp>
+#include <playrho/d2/ContactEvents.hpp>
 #include <playrho/d2/ContactImpulsesFunction.hpp>
 #include <playrho/d2/ContactManifoldFunction.hpp>
 #include <playrho/d2/Joint.hpp>
@@ -122,6 +124,11 @@ struct WorldConcept {
     ///   world was constructed with specified the collection of these statistics.
     virtual std::optional<pmr::StatsResource::Stats> GetResourceStats_() const noexcept = 0;
 
+    /// @brief Gets the recorded contact events.
+    /// @note These are always empty unless the world configuration the world was
+    ///   constructed with specified the recording of these events.
+    virtual const ContactEvents& GetContactEvents_() const noexcept = 0;
+
     /// @brief Clears the world.
     /// @note This calls the joint and shape destruction listeners (if they're set), for all
     ///   defined joints and shapes, before clearing anything. Any exceptions thrown from these
@@ -243,8 +250,9 @@ struct WorldConcept {
 
     /// @brief Gets the state of the identified body.
     /// @throws std::out_of_range If given an invalid body identifier.
+    /// @note The returned reference is only valid until this world is next modified.
     /// @see SetBody_, GetBodyRange_.
-    virtual Body GetBody_(BodyID id) const = 0;
+    virtual const Body& GetBody_(BodyID id) const = 0;
 
     /// @brief Sets the state of the identified body.
     /// @throws std::out_of_range if given an invalid id of if the given body references any
@@ -253,6 +261,60 @@ struct WorldConcept {
     /// @see GetBody_, GetBodyRange_.
     virtual void SetBody_(BodyID id, const Body& value) = 0;
 
+    /// @brief Sets the transformation of the identified body in place.
+    /// @details This is like setting the body via <code>SetBody_</code> with a copy of it
+    ///   having the new value but without copying the body.
+    /// @throws WrongState if this function is called while the world is locked.
+    /// @throws std::out_of_range if given an invalid id.
+    /// @throws InvalidArgument if the specified ID was destroyed.
+    /// @see SetBody_, GetBody_.
+    virtual void SetTransformation_(BodyID id, const Transformation& value) = 0;
+
+    /// @brief Sets the velocity of the identified body in place.
+    /// @copydetails SetTransformation_
+    virtual void SetVelocity_(BodyID id, const Velocity& value) = 0;
+
+    /// @brief Sets the acceleration of the identified body in place.
+    /// @copydetails SetTransformation_
+    virtual void SetAcceleration_(BodyID id, const Acceleration& value) = 0;
+
+    /// @brief Sets or unsets the awake state of the identified body in place.
+    /// @copydetails SetTransformation_
+    virtual void SetAwake_(BodyID id, bool value) = 0;
+
+    /// @brief Sets or unsets the impenetrable state of the identified body in place.
+    /// @copydetails SetTransformation_
+    virtual void SetImpenetrable_(BodyID id, bool value) = 0;
+
+    /// @brief Sets whether the identified body is allowed to sleep in place.
+    /// @copydetails SetTransformation_
+    virtual void SetSleepingAllowed_(BodyID id, bool value) = 0;
+
+    /// @brief Applies the given linear impulse at the given point to the identified body
+    ///   in place.
+    /// @copydetails SetTransformation_
+    virtual void ApplyLinearImpulse_(BodyID id, const Momentum2& impulse,
+                                     const Length2& point) = 0;
+
+    /// @brief Applies the given angular impulse to the identified body in place.
+    /// @copydetails SetTransformation_
+    virtual void ApplyAngularImpulse_(BodyID id, AngularMomentum impulse) = 0;
+
+    /// @brief Gets the states of the identified bodies.
+    /// @throws InvalidArgument if a non-empty span of @p states doesn't have the same size
+    ///   as @p ids.
+    /// @throws std::out_of_range if any of the given identifiers are invalid.
+    /// @see SetBodyStates_.
+    virtual void GetBodyStates_(Span<const BodyID> ids, const BodyStateSpans& states) const = 0;
+
+    /// @brief Sets the states of the identified bodies in place.
+    /// @throws WrongState if this function is called while the world is locked.
+    /// @throws InvalidArgument if a non-empty span of @p states doesn't have the same size
+    ///   as @p ids, or if any of the identified bodies were destroyed.
+    /// @throws std::out_of_range if any of the given identifiers are invalid.
+    /// @see GetBodyStates_.
+    virtual void SetBodyStates_(Span<const BodyID> ids, const ConstBodyStateSpans& states) = 0;
+
     /// @brief Destroys the identified body.
     /// @details Destroys the identified body that had previously been created by a call to this
     ///   world's <code>CreateBody_(const Body&)</code> function.
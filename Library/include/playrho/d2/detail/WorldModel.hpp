@@ -134,6 +134,12 @@ struct WorldModel final: WorldConcept {
         return GetResourceStats(data);
     }
 
+    /// @copydoc WorldConcept::GetContactEvents_
+    const ContactEvents& GetContactEvents_() const noexcept override
+    {
+        return GetContactEvents(data);
+    }
+
     /// @copydoc WorldConcept::Clear_
     void Clear_() noexcept override
     {
@@ -221,7 +227,7 @@ struct WorldModel final: WorldConcept {
     }
 
     /// @copydoc WorldConcept::GetBody_
-    Body GetBody_(BodyID id) const override
+    const Body& GetBody_(BodyID id) const override
     {
         return GetBody(data, id);
     }
@@ -232,6 +238,66 @@ struct WorldModel final: WorldConcept {
         SetBody(data, id, value);
     }
 
+    /// @copydoc WorldConcept::SetTransformation_
+    void SetTransformation_(BodyID id, const Transformation& value) override
+    {
+        SetTransformation(data, id, value);
+    }
+
+    /// @copydoc WorldConcept::SetVelocity_
+    void SetVelocity_(BodyID id, const Velocity& value) override
+    {
+        SetVelocity(data, id, value);
+    }
+
+    /// @copydoc WorldConcept::SetAcceleration_
+    void SetAcceleration_(BodyID id, const Acceleration& value) override
+    {
+        SetAcceleration(data, id, value);
+    }
+
+    /// @copydoc WorldConcept::SetAwake_
+    void SetAwake_(BodyID id, bool value) override
+    {
+        SetAwake(data, id, value);
+    }
+
+    /// @copydoc WorldConcept::SetImpenetrable_
+    void SetImpenetrable_(BodyID id, bool value) override
+    {
+        SetImpenetrable(data, id, value);
+    }
+
+    /// @copydoc WorldConcept::SetSleepingAllowed_
+    void SetSleepingAllowed_(BodyID id, bool value) override
+    {
+        SetSleepingAllowed(data, id, value);
+    }
+
+    /// @copydoc WorldConcept::ApplyLinearImpulse_
+    void ApplyLinearImpulse_(BodyID id, const Momentum2& impulse, const Length2& point) override
+    {
+        ApplyLinearImpulse(data, id, impulse, point);
+    }
+
+    /// @copydoc WorldConcept::ApplyAngularImpulse_
+    void ApplyAngularImpulse_(BodyID id, AngularMomentum impulse) override
+    {
+        ApplyAngularImpulse(data, id, impulse);
+    }
+
+    /// @copydoc WorldConcept::GetBodyStates_
+    void GetBodyStates_(Span<const BodyID> ids, const BodyStateSpans& states) const override
+    {
+        GetBodyStates(data, ids, states);
+    }
+
+    /// @copydoc WorldConcept::SetBodyStates_
+    void SetBodyStates_(Span<const BodyID> ids, const ConstBodyStateSpans& states) override
+    {
+        SetBodyStates(data, ids, states);
+    }
+
     /// @copydoc WorldConcept::Destroy_(BodyID)
     void Destroy_(BodyID id) override
     {
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef PLAYRHO_MONOTONIC_MEMORY_RESOURCE_HPP
+#define PLAYRHO_MONOTONIC_MEMORY_RESOURCE_HPP
+
+#include <cstddef> // for std::size_t, std::byte
+#include <ostream>
+#include <vector>
+
+// IWYU pragma: begin_exports
+
+#include <playrho/pmr/MemoryResource.hpp>
+
+// IWYU pragma: end_exports
+
+namespace playrho::pmr {
+
+/// @brief Configurable options.
+struct MonotonicMemoryOptions
+{
+    /// @brief Reserve bytes.
+    /// @note This is the size of the block allocated on construction. If zero, no memory
+    ///   is pre-allocated.
+    std::size_t reserveBytes{};
+};
+
+/// @brief Operator equals support.
+constexpr bool operator==(const MonotonicMemoryOptions& lhs,
+                          const MonotonicMemoryOptions& rhs) noexcept
+{
+    return lhs.reserveBytes == rhs.reserveBytes;
+}
+
+/// @brief Operator not-equals support.
+constexpr bool operator!=(const MonotonicMemoryOptions& lhs,
+                          const MonotonicMemoryOptions& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+/// @brief Monotonic memory resource.
+/// @details Allocates by bumping a pointer through its current block of memory and only
+///   gets more memory from upstream when that block runs out. Deallocation is a no-op.
+///   All the memory handed out gets reclaimed at once by <code>Release</code>, which also
+///   resizes the memory held to the most that's been needed between releases. So once a
+///   repeating pattern of allocations has been gone through, going through it again
+///   doesn't allocate from upstream at all.
+/// @note This is similar to <code>std::pmr::monotonic_buffer_resource</code> except that
+///   its memory is reused after being released instead of being given back upstream.
+/// @see https://en.cppreference.com/w/cpp/memory/monotonic_buffer_resource
+class MonotonicMemoryResource final: public memory_resource
+{
+public:
+    /// @brief Statistics data.
+    struct Stats
+    {
+        /// @brief Number of blocks of memory gotten from upstream and currently held.
+        std::size_t numBlocks{};
+
+        /// @brief Total bytes capacity of all blocks.
+        std::size_t totalBytes{};
+
+        /// @brief Bytes used since construction or the last release.
+        /// @note This is counted as though all the allocations were from one block,
+        ///   including any bytes skipped over for alignment.
+        std::size_t usedBytes{};
+
+        /// @brief Most bytes used between releases.
+        std::size_t maxUsedBytes{};
+
+        /// @brief Number of allocations done from upstream since construction.
+        std::size_t upstreamAllocations{};
+
+        /// @brief Operator equals support.
+        friend bool operator==(const Stats& lhs, const Stats& rhs) noexcept
+        {
+            return (lhs.numBlocks == rhs.numBlocks) // force line-break
+                && (lhs.totalBytes == rhs.totalBytes) // force line-break
+                && (lhs.usedBytes == rhs.usedBytes) // force line-break
+                && (lhs.maxUsedBytes == rhs.maxUsedBytes) // force line-break
+                && (lhs.upstreamAllocations == rhs.upstreamAllocations);
+        }
+
+        /// @brief Operator not-equals support.
+        friend bool operator!=(const Stats& lhs, const Stats& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+    /// @brief Default and initializing constructor.
+    /// @post <code>GetOptions()</code> returns the given options.
+    /// @throws std::bad_alloc if an allocation of <code>options.reserveBytes</code> fails.
+    MonotonicMemoryResource(const MonotonicMemoryOptions& options = {},
+                            memory_resource* upstream = nullptr);
+
+    /// @brief Copy construction deleted!
+    MonotonicMemoryResource(const MonotonicMemoryResource& other) = delete;
+
+    /// @brief Moves construction deleted!
+    MonotonicMemoryResource(MonotonicMemoryResource&& other) = delete;
+
+    /// @brief Destructor.
+    /// @note Deallocates the allocated memory.
+    /// @warning Terminates if upstream resource throws on deallocating any memory.
+    ~MonotonicMemoryResource() noexcept override;
+
+    /// @brief Copy assignment deleted!
+    MonotonicMemoryResource& operator=(const MonotonicMemoryResource& other) = delete;
+
+    /// @brief Moves assignment deleted!
+    MonotonicMemoryResource& operator=(MonotonicMemoryResource&& other) = delete;
+
+    /// @brief Gets the options used by this instance.
+    MonotonicMemoryOptions GetOptions() const noexcept
+    {
+        return m_options;
+    }
+
+    /// @brief Gets the current statistics.
+    Stats GetStats() const noexcept;
+
+    /// @brief Gets the upstream resource.
+    memory_resource* GetUpstream() const noexcept
+    {
+        return m_upstream;
+    }
+
+    /// @brief Releases all the memory allocated from this instance for reuse.
+    /// @details If more than one block was needed since the last release, the blocks get
+    ///   replaced by a single block big enough for the most bytes ever used between releases.
+    /// @warning Any memory previously allocated from this instance must no longer be in use.
+    /// @throws std::bad_alloc if allocating the replacement block fails. This instance
+    ///   is left holding no blocks in that case but is otherwise still usable.
+    void Release();
+
+private:
+    /// @brief Block of memory gotten from upstream.
+    struct Block
+    {
+        std::byte* data{}; ///< Pointer to the memory.
+        std::size_t size{}; ///< Size of the memory in bytes.
+    };
+
+    void *do_allocate(std::size_t num_bytes, std::size_t alignment) override;
+
+    /// @note This is a no-op. Memory is only reclaimed by <code>Release</code>.
+    void do_deallocate(void *p, std::size_t num_bytes, std::size_t alignment) override;
+
+    bool do_is_equal(const memory_resource &other) const noexcept override;
+
+    /// @brief Allocates a new block from upstream of at least the given size.
+    Block& AllocateBlock(std::size_t num_bytes);
+
+    /// @brief Deallocates all the blocks.
+    void DeallocateBlocks() noexcept;
+
+    /// @brief Options used by this instance.
+    MonotonicMemoryOptions m_options;
+
+    /// @brief Upstream memory provider.
+    memory_resource* m_upstream{new_delete_resource()};
+
+    /// @brief Blocks of memory gotten from upstream.
+    /// @note Allocations are only made from the last one.
+    std::vector<Block> m_blocks;
+
+    std::size_t m_offset{}; ///< Offset into the last block of its unused memory.
+    std::size_t m_usedBytes{}; ///< Bytes used since construction or the last release.
+    std::size_t m_maxUsedBytes{}; ///< Most bytes used between releases.
+    std::size_t m_upstreamAllocations{}; ///< Number of allocations from upstream.
+};
+
+/// @brief Provide output streaming support for <code>MonotonicMemoryResource::Stats</code>.
+std::ostream& operator<<(std::ostream& os, const MonotonicMemoryResource::Stats& stats);
+
+}
+
+#endif // PLAYRHO_MONOTONIC_MEMORY_RESOURCE_HPP
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <algorithm> // for std::find_if
+#include <fstream>
+#include <ostream>
+
+#include <playrho/ChromeTracer.hpp>
+#include <playrho/InvalidArgument.hpp>
+
+namespace playrho {
+
+namespace {
+
+/// @brief Writes the given string to the given stream escaped as JSON string content.
+void WriteEscaped(std::ostream& os, const char* str)
+{
+    static constexpr char hexDigits[] = "0123456789abcdef";
+    for (; str && *str; ++str) {
+        const auto c = *str;
+        switch (c) {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\r': os << "\\r"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20u) {
+                const auto value = static_cast<unsigned char>(c);
+                os << "\\u00" << hexDigits[value >> 4u] << hexDigits[value & 0xFu];
+            }
+            else {
+                os << c;
+            }
+            break;
+        }
+    }
+}
+
+} // namespace
+
+ChromeTracer::ChromeTracer(): m_epoch{clock::now()}
+{
+    // Intentionally empty.
+}
+
+void ChromeTracer::Begin(const char* name) noexcept
+{
+    Record(name, 'B');
+}
+
+void ChromeTracer::End(const char* name) noexcept
+{
+    Record(name, 'E');
+}
+
+void ChromeTracer::Record(const char* name, char phase) noexcept
+{
+    const auto time = clock::now() - m_epoch;
+    const auto id = std::this_thread::get_id();
+    try {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        auto it = std::find_if(begin(m_lanes), end(m_lanes), [&id](const auto& entry) {
+            return entry.first == id;
+        });
+        if (it == end(m_lanes)) {
+            it = m_lanes.insert(end(m_lanes), {id, static_cast<std::uint32_t>(size(m_lanes))});
+        }
+        m_events.push_back(Event{name, phase, it->second,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time)});
+    }
+    catch (...) {
+        // Locking or growing the arrays failed. Losing the event beats throwing from here.
+        ++m_dropped;
+    }
+}
+
+std::vector<ChromeTracer::Event> ChromeTracer::GetEvents() const
+{
+    const std::lock_guard<std::mutex> lock{m_mutex};
+    return m_events;
+}
+
+std::size_t ChromeTracer::GetEventCount() const
+{
+    const std::lock_guard<std::mutex> lock{m_mutex};
+    return size(m_events);
+}
+
+void ChromeTracer::Clear()
+{
+    const std::lock_guard<std::mutex> lock{m_mutex};
+    m_events.clear();
+}
+
+void ChromeTracer::Write(std::ostream& os) const
+{
+    const auto events = GetEvents();
+    os << "{\"traceEvents\":[";
+    auto first = true;
+    for (const auto& event: events) {
+        os << (first? "\n": ",\n");
+        first = false;
+        os << "{\"name\":\"";
+        WriteEscaped(os, event.name);
+        // Times are in microseconds but fractional values are allowed.
+        const auto micros = event.time.count() / 1000;
+        const auto nanos = event.time.count() % 1000;
+        os << "\",\"cat\":\"playrho\",\"ph\":\"" << event.phase << "\"";
+        os << ",\"ts\":" << micros << '.' << (nanos / 100) << ((nanos / 10) % 10) << (nanos % 10);
+        os << ",\"pid\":1,\"tid\":" << event.lane << "}";
+    }
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+void WriteFile(const ChromeTracer& tracer, const std::string& path)
+{
+    auto file = std::ofstream{path};
+    if (!file) {
+        throw InvalidArgument("WriteFile: unable to open file for writing");
+    }
+    file.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+    tracer.Write(file);
+}
+
+} // namespace playrho
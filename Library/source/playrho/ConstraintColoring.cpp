@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <cassert> // for assert
+#include <cstdint> // for std::uint64_t
+#include <limits> // for std::numeric_limits
+
+#include <playrho/ConstraintColoring.hpp>
+#include <playrho/to_underlying.hpp>
+
+namespace playrho {
+
+namespace {
+
+/// @brief Set of colors.
+using ColorSet = std::uint64_t;
+
+static_assert(MaxConstraintColors <= static_cast<std::size_t>(std::numeric_limits<ColorSet>::digits),
+              "MaxConstraintColors must fit in a ColorSet!");
+
+} // anonymous namespace
+
+ConstraintColors GetConstraintColors(const Span<const ConstraintBodies>& constraints,
+                                     std::size_t bodyCount)
+{
+    auto result = ConstraintColors{};
+    auto bodyColors = std::vector<ColorSet>(bodyCount);
+    for (auto i = std::size_t{0}; i < size(constraints); ++i) {
+        auto used = ColorSet{0};
+        for (const auto& body: constraints[i]) {
+            if (IsValid(body)) {
+                assert(to_underlying(body) < bodyCount);
+                used |= bodyColors[to_underlying(body)];
+            }
+        }
+        auto color = std::size_t{0};
+        while ((color < MaxConstraintColors) && ((used & (ColorSet{1} << color)) != 0u)) {
+            ++color;
+        }
+        if (color == MaxConstraintColors) {
+            result.uncolored.push_back(i);
+            continue;
+        }
+        if (color >= size(result.colors)) {
+            result.colors.resize(color + 1u);
+        }
+        result.colors[color].push_back(i);
+        for (const auto& body: constraints[i]) {
+            if (IsValid(body)) {
+                bodyColors[to_underlying(body)] |= ColorSet{1} << color;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace playrho
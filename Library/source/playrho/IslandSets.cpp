@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <cassert>
+#include <type_traits>
+#include <utility> // for std::swap
+
+#include <playrho/IslandSets.hpp>
+
+namespace playrho {
+
+static_assert(std::is_default_constructible_v<IslandSets>);
+static_assert(std::is_copy_constructible_v<IslandSets>);
+static_assert(std::is_nothrow_move_constructible_v<IslandSets>);
+
+namespace {
+
+/// @brief Links the identified constraint in at the end of the list that's at @p first.
+template <class Nodes, class ID>
+void LinkNode(Nodes& nodes, ID& first, ID id, BodyID owner)
+{
+    const auto index = to_underlying(id);
+    if (index >= nodes.size()) {
+        nodes.resize(index + 1u);
+    }
+    auto& node = nodes[index];
+    assert(!IsValid(node.owner));
+    node.owner = owner;
+    if (!IsValid(first)) {
+        node.prev = id;
+        node.next = id;
+        first = id;
+        return;
+    }
+    // Links in before the first so iterating the list visits constraints in linked order.
+    const auto last = nodes[to_underlying(first)].prev;
+    node.prev = last;
+    node.next = first;
+    nodes[to_underlying(last)].next = id;
+    nodes[to_underlying(first)].prev = id;
+}
+
+/// @brief Unlinks the identified constraint from the list that's at @p first.
+template <class Nodes, class ID>
+void UnlinkNode(Nodes& nodes, ID& first, ID id, ID invalid) noexcept
+{
+    auto& node = nodes[to_underlying(id)];
+    if (node.next == id) {
+        first = invalid;
+    }
+    else {
+        nodes[to_underlying(node.prev)].next = node.next;
+        nodes[to_underlying(node.next)].prev = node.prev;
+        if (first == id) {
+            first = node.next;
+        }
+    }
+    node.owner = InvalidBodyID;
+}
+
+/// @brief Splices the lists that are at @p a and @p b together.
+/// @return First constraint of the combined list.
+template <class Nodes, class ID>
+ID SpliceNodes(Nodes& nodes, ID a, ID b) noexcept
+{
+    if (!IsValid(a)) {
+        return b;
+    }
+    if (IsValid(b)) {
+        // Puts b's list after the end of a's list.
+        const auto lastA = nodes[to_underlying(a)].prev;
+        const auto lastB = nodes[to_underlying(b)].prev;
+        nodes[to_underlying(lastA)].next = b;
+        nodes[to_underlying(b)].prev = lastA;
+        nodes[to_underlying(lastB)].next = a;
+        nodes[to_underlying(a)].prev = lastB;
+    }
+    return a;
+}
+
+} // anonymous namespace
+
+void IslandSets::resize(size_type count)
+{
+    const auto oldSize = size();
+    m_entries.resize(count);
+    for (auto i = oldSize; i < count; ++i) {
+        Reset(BodyID(i));
+    }
+}
+
+void IslandSets::Reset(BodyID id) noexcept
+{
+    assert(to_underlying(id) < size());
+    m_entries[to_underlying(id)] = Entry{id, id};
+}
+
+BodyID IslandSets::Find(BodyID id) noexcept
+{
+    assert(to_underlying(id) < size());
+    // Uses path halving: every other element on the path gets linked to its grandparent.
+    for (;;) {
+        auto& entry = m_entries[to_underlying(id)];
+        if (entry.parent == id) {
+            return id;
+        }
+        const auto grandparent = m_entries[to_underlying(entry.parent)].parent;
+        entry.parent = grandparent;
+        id = grandparent;
+    }
+}
+
+bool IslandSets::Join(BodyID a, BodyID b) noexcept
+{
+    auto rootA = Find(a);
+    auto rootB = Find(b);
+    if (rootA == rootB) {
+        return false;
+    }
+    // Splicing the circular member lists at the given elements (rather than at the roots)
+    // is what allows iterations at a to go on to visit b's members.
+    std::swap(m_entries[to_underlying(a)].next, m_entries[to_underlying(b)].next);
+    if (m_entries[to_underlying(rootA)].size < m_entries[to_underlying(rootB)].size) {
+        std::swap(rootA, rootB);
+    }
+    auto& entryA = m_entries[to_underlying(rootA)];
+    const auto& entryB = m_entries[to_underlying(rootB)];
+    entryA.size += entryB.size;
+    entryA.needsSplitting = entryA.needsSplitting || entryB.needsSplitting;
+    entryA.contact = SpliceNodes(m_contacts, entryA.contact, entryB.contact);
+    entryA.joint = SpliceNodes(m_joints, entryA.joint, entryB.joint);
+    m_entries[to_underlying(rootB)].parent = rootA;
+    return true;
+}
+
+void IslandSets::Link(ContactID contact, BodyID id)
+{
+    LinkNode(m_contacts, m_entries[to_underlying(Find(id))].contact, contact, id);
+}
+
+void IslandSets::Link(JointID joint, BodyID id)
+{
+    LinkNode(m_joints, m_entries[to_underlying(Find(id))].joint, joint, id);
+}
+
+void IslandSets::Unlink(ContactID contact) noexcept
+{
+    assert(IsLinked(contact));
+    auto& entry = m_entries[to_underlying(Find(m_contacts[to_underlying(contact)].owner))];
+    UnlinkNode(m_contacts, entry.contact, contact, InvalidContactID);
+    entry.needsSplitting = true;
+}
+
+void IslandSets::Unlink(JointID joint) noexcept
+{
+    assert(IsLinked(joint));
+    auto& entry = m_entries[to_underlying(Find(m_joints[to_underlying(joint)].owner))];
+    UnlinkNode(m_joints, entry.joint, joint, InvalidJointID);
+    entry.needsSplitting = true;
+}
+
+} // namespace playrho
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <algorithm> // for std::clamp
+#include <vector>
+
+#include <playrho/TaskScheduler.hpp>
+
+namespace playrho {
+
+TaskScheduler::~TaskScheduler() noexcept = default;
+
+void TaskScheduler::ParallelFor(size_type count, const RangeFunction& function)
+{
+    if (count == 0u) {
+        return;
+    }
+    const auto numTasks = std::clamp(GetConcurrency(), size_type{1}, count);
+    if (numTasks == 1u) {
+        function(0u, count);
+        return;
+    }
+    auto tasks = std::vector<Task>{};
+    tasks.reserve(numTasks);
+    const auto perTask = count / numTasks;
+    const auto extra = count % numTasks;
+    auto first = size_type{0};
+    for (auto i = size_type{0}; i < numTasks; ++i) {
+        const auto last = first + perTask + ((i < extra)? 1u: 0u);
+        tasks.emplace_back([&function,first,last]{ function(first, last); });
+        first = last;
+    }
+    Run(tasks);
+}
+
+} // namespace playrho
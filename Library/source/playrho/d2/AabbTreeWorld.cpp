@@ -20,14 +20,20 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <cassert> // for assert
+#include <chrono> // for std::chrono::steady_clock
 #include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t
 #include <exception> // for std::throw_with_nested
 #include <functional>
 #include <iterator> // for std::next
 #include <limits> // for std::numeric_limits
 #include <map>
+#include <memory> // for std::unique_ptr
+#include <numeric> // for std::iota
 #include <optional>
+#include <queue> // for std::priority_queue
 #include <set>
 #include <stdexcept> // for std::out_of_range
 #include <tuple>
@@ -38,15 +44,11 @@
 #include <atomic>
 #endif
 
-//#define DO_THREADED
-#if defined(DO_THREADED)
-#include <future>
-#endif
-
 #include <playrho/BodyID.hpp>
 #include <playrho/BodyType.hpp>
 #include <playrho/Contact.hpp>
 #include <playrho/Contactable.hpp>
+#include <playrho/ConstraintColoring.hpp>
 #include <playrho/ContactID.hpp>
 #include <playrho/ContactKey.hpp>
 #include <playrho/ConstraintSolverConf.hpp>
@@ -66,9 +68,11 @@
 #include <playrho/Span.hpp>
 #include <playrho/StepConf.hpp>
 #include <playrho/StepStats.hpp>
+#include <playrho/TaskScheduler.hpp>
 #include <playrho/Templates.hpp>
 #include <playrho/ToiConf.hpp>
 #include <playrho/ToiOutput.hpp>
+#include <playrho/Tracer.hpp>
 #include <playrho/to_underlying.hpp>
 #include <playrho/UnitInterval.hpp>
 #include <playrho/Units.hpp>
@@ -77,6 +81,7 @@
 #include <playrho/ZeroToUnderOne.hpp>
 
 #include <playrho/pmr/MemoryResource.hpp>
+#include <playrho/pmr/MonotonicMemoryResource.hpp>
 #include <playrho/pmr/PoolMemoryResource.hpp>
 
 #include <playrho/d2/AABB.hpp>
@@ -113,6 +118,8 @@
 #include <playrho/d2/VelocityConstraint.hpp>
 #include <playrho/d2/WeldJointConf.hpp>
 #include <playrho/d2/WheelJointConf.hpp>
+#include <playrho/d2/WideDynamicTree.hpp>
+#include <playrho/d2/WideVelocityConstraints.hpp>
 #include <playrho/d2/World.hpp>
 #include <playrho/d2/WorldConf.hpp>
 #include <playrho/d2/WorldContact.hpp> // for SameTouching
@@ -149,6 +156,27 @@ struct AabbTreeWorld::ContactUpdateConf
     Manifold::Conf manifold; ///< Manifold configuration data.
 };
 
+/// @brief Owned island solver resources for a batch of islands.
+struct AabbTreeWorld::IslandBatchResources
+{
+    pmr::PoolMemoryResource bodyConstraints; ///< For body constraints.
+    pmr::PoolMemoryResource positionConstraints; ///< For position constraints.
+    pmr::PoolMemoryResource velocityConstraints; ///< For velocity constraints.
+
+    /// @brief Map of body identifiers to island-local body constraint identifiers.
+    std::vector<BodyID> bodyConstraintIndices;
+};
+
+/// @brief Results of solving an island that are still to be written back to the world.
+struct AabbTreeWorld::RegIslandSolution
+{
+    BodyConstraints bodyConstraints; ///< Solved body constraints.
+    VelocityConstraints velConstraints; ///< Solved velocity constraints.
+    IslandStats stats; ///< Island solver results so far.
+    StepTimes::duration velocityTime{}; ///< Time solving velocity constraints, if timed.
+    StepTimes::duration positionTime{}; ///< Time solving position constraints, if timed.
+};
+
 namespace {
 
 constexpr auto idIsDestroyedMsg = "ID is destroyed";
@@ -160,6 +188,23 @@ constexpr auto noSuchManifoldMsg = "no such manifold";
 constexpr auto noSuchShapeMsg = "no such shape";
 constexpr auto noSuchJointMsg = "no such joint";
 
+/// @brief Child distance proxies of shapes indexed by shape identifier.
+using ShapeChildren = std::vector<std::vector<DistanceProxy>>;
+
+/// @brief Gets the child distance proxies of the given shape.
+/// @note The proxies refer to the value of the given shape, and of any of its copies, so
+///   they're only valid while at least one of them still has that value.
+std::vector<DistanceProxy> GetChildren(const Shape& shape)
+{
+    const auto childCount = GetChildCount(shape);
+    auto children = std::vector<DistanceProxy>{};
+    children.reserve(childCount);
+    for (auto i = decltype(childCount){0}; i < childCount; ++i) {
+        children.push_back(GetChild(shape, i));
+    }
+    return children;
+}
+
 template <class Container, class U, class V, class Message>
 auto At(Container &&container, ::playrho::detail::IndexingNamedType<U, V> id, Message &&msg)
     -> decltype(OutOfRange{id, std::forward<Message>(msg)}, // NOLINT(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
@@ -173,13 +218,97 @@ auto At(Container &&container, ::playrho::detail::IndexingNamedType<U, V> id, Me
     }
 }
 
-inline void IntegratePositions(const Span<const BodyID>& bodies,
-                               const Span<BodyConstraint>& constraints,
-                               Time h)
+/// @brief Clock that the phases of steps are timed with.
+using StepClock = std::chrono::steady_clock;
+
+/// @brief Adds the time that passes while an instance of this class is timing to a duration.
+/// @note Does nothing, not even reading the clock, when not given a duration to add to.
+class PhaseTimer
+{
+public:
+    /// @brief Initializing constructor.
+    /// @param total Duration to add to, or <code>nullptr</code> to not time anything.
+    explicit PhaseTimer(StepTimes::duration* total) noexcept:
+        m_total{total}, m_start{total? StepClock::now(): StepClock::time_point{}}
+    {
+    }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    /// @brief Destructor.
+    /// @details Stops timing if not already stopped.
+    ~PhaseTimer() noexcept
+    {
+        Stop();
+    }
+
+    /// @brief Stops timing, adding the time that's passed to the duration.
+    void Stop() noexcept
+    {
+        if (m_total) {
+            *m_total += std::chrono::duration_cast<StepTimes::duration>(StepClock::now() - m_start);
+            m_total = nullptr;
+        }
+    }
+
+private:
+    StepTimes::duration* m_total; ///< Duration to add to or <code>nullptr</code>.
+    StepClock::time_point m_start; ///< When timing started.
+};
+
+/// @brief Releases the given step arena, if there is one, by the end of this instance's scope.
+/// @details This way the arena gets released even when stepping throws.
+class StepArenaReleaser
+{
+public:
+    /// @brief Initializing constructor.
+    /// @param arena Step arena to release, or <code>nullptr</code> to not release anything.
+    explicit StepArenaReleaser(pmr::MonotonicMemoryResource* arena) noexcept: m_arena{arena}
+    {
+    }
+
+    StepArenaReleaser(const StepArenaReleaser&) = delete;
+    StepArenaReleaser& operator=(const StepArenaReleaser&) = delete;
+
+    /// @brief Destructor.
+    /// @details Releases the arena if not already released. Any exception from that is
+    ///   swallowed since this may be running due to another one. The arena's still usable then.
+    ~StepArenaReleaser() noexcept
+    {
+        if (m_arena) {
+            try {
+                m_arena->Release();
+            }
+            catch (...) { // NOLINT(bugprone-empty-catch)
+            }
+        }
+    }
+
+    /// @brief Releases the arena now if not already released.
+    /// @throws std::bad_alloc if the arena's releasing does.
+    void Release()
+    {
+        if (m_arena) {
+            std::exchange(m_arena, nullptr)->Release();
+        }
+    }
+
+private:
+    pmr::MonotonicMemoryResource* m_arena; ///< Arena to release or <code>nullptr</code>.
+};
+
+/// @brief Gets the given phase duration if the given configuration asks for timing.
+/// @return Pointer to the given duration or <code>nullptr</code>.
+inline StepTimes::duration* GetTimed(const StepConf& conf, StepTimes::duration& phase) noexcept
+{
+    return conf.doTiming? &phase: nullptr;
+}
+
+inline void IntegratePositions(const Span<BodyConstraint>& constraints, Time h)
 {
     assert(IsValid(h));
-    for_each(cbegin(bodies), cend(bodies), [&](const auto& id) {
-        auto& bc = constraints[to_underlying(id)];
+    for_each(begin(constraints), end(constraints), [&](BodyConstraint& bc) {
         const auto velocity = bc.GetVelocity();
         const auto translation = h * velocity.linear;
         const auto rotation = h * velocity.angular;
@@ -205,6 +334,45 @@ inline void Report(const ContactImpulsesFunction& listener,
     }
 }
 
+/// @brief Records post-solve contact events for the given constraints.
+/// @see Report.
+void Record(std::vector<PostSolveContactEvent>& events,
+            const Span<const ContactID>& contacts,
+            const Span<const VelocityConstraint>& constraints,
+            StepConf::iteration_type solved,
+            const ObjectPool<Contact>& contactBuffer)
+{
+    const auto numContacts = size(contacts);
+    for (auto i = decltype(numContacts){0}; i < numContacts; ++i) {
+        const auto& contact = contactBuffer[to_underlying(contacts[i])];
+        events.push_back({contacts[i], contact.GetContactableA(), contact.GetContactableB(),
+                          GetContactImpulses(constraints[i]), solved});
+    }
+}
+
+/// @brief Gets the speed the given bodies are approaching each other at along the normal
+///   of the given manifold.
+/// @return Greatest approach speed of any of the manifold's points, or zero if none.
+LinearVelocity GetApproachSpeed(const Manifold& manifold,
+                                const Body& bodyA, Length radiusA,
+                                const Body& bodyB, Length radiusB)
+{
+    const auto worldManifold = GetWorldManifold(manifold,
+                                                GetTransformation(bodyA), radiusA,
+                                                GetTransformation(bodyB), radiusB);
+    const auto normal = worldManifold.GetNormal();
+    const auto count = worldManifold.GetPointCount();
+    auto speed = 0_mps;
+    for (auto i = decltype(count){0}; i < count; ++i) {
+        const auto point = worldManifold.GetPoint(i);
+        const auto dv = GetContactRelVelocity(GetVelocity(bodyA), point - GetWorldCenter(bodyA),
+                                              GetVelocity(bodyB), point - GetWorldCenter(bodyB));
+        const auto approach = -Dot(dv, normal);
+        speed = (i == 0u)? approach: std::max(speed, approach);
+    }
+    return speed;
+}
+
 inline void AssignImpulses(Manifold& var, const VelocityConstraint& vc)
 {
     assert(var.GetPointCount() >= vc.GetPointCount());
@@ -273,24 +441,298 @@ void WarmStartVelocities(const Span<const VelocityConstraint>& velConstraints,
     });
 }
 
+/// @brief Gets the island-local body constraints for the given bodies.
+/// @details Only allocates as many constraints as there are bodies in the island.
+///   The constraint for <code>bodies[i]</code> is at index <code>i</code> of the result.
+/// @param indices World-sized map of body identifiers to island-local ones. Only the
+///   elements for the given bodies are written to.
+/// @see BodyConstraintsMap.
 BodyConstraints GetBodyConstraints(pmr::memory_resource& resource,
                                    const Span<const BodyID>& bodies,
                                    const ObjectPool<Body>& bodyBuffer,
-                                   Time h, const MovementConf& conf)
+                                   Time h, const MovementConf& conf,
+                                   const Span<BodyID>& indices)
 {
     auto constraints = BodyConstraints{&resource};
-    constraints.resize(size(bodyBuffer)); // can't be size(bodies)!
+    constraints.reserve(size(bodies));
     for (const auto& id: bodies) {
-        constraints[to_underlying(id)] = GetBodyConstraint(bodyBuffer[to_underlying(id)], h, conf);
+        indices[to_underlying(id)] = BodyID(static_cast<BodyID::underlying_type>(size(constraints)));
+        constraints.push_back(GetBodyConstraint(bodyBuffer[to_underlying(id)], h, conf));
     }
     return constraints;
 }
 
+/// @brief Resets the elements of the given map for the given bodies to the invalid body ID.
+/// @details This is for after solving an island, so that the map's elements for the island's
+///   bodies can't be taken as being for bodies of the next island solved with the map.
+/// @see GetBodyConstraints.
+void ResetIndices(const Span<BodyID>& indices, const Span<const BodyID>& bodies) noexcept
+{
+    for (const auto& id: bodies) {
+        indices[to_underlying(id)] = InvalidBodyID;
+    }
+}
+
+/// @brief Batch of pointers to joints or joint configurations of the given type.
+template <class T>
+using JointBatch = std::vector<T*, pmr::polymorphic_allocator<T*>>;
+
+/// @brief Joints of an island grouped by the types of their configurations.
+/// @details Joints of the listed types are held as pointers to their configurations so
+///   solving them calls the configurations' solver functions directly instead of going
+///   through the type-erased <code>Joint</code> interface. Joints of any other type are
+///   held in <code>others</code> and solved through that interface.
+/// @note Joints keep their island relative order within each group.
+template <class... Types>
+struct JointBatches
+{
+    /// @brief Initializing constructor.
+    /// @param resource Memory resource the batches allocate from.
+    explicit JointBatches(pmr::memory_resource& resource):
+        typed{JointBatch<Types>{&resource}...}, others{&resource}
+    {
+        // Intentionally empty.
+    }
+
+    /// @brief Gets whether the given joint is of one of the grouped types.
+    static bool IsGrouped(const Joint& joint) noexcept
+    {
+        const auto type = GetType(joint);
+        return ((type == GetTypeID<Types>()) || ...);
+    }
+
+    std::tuple<JointBatch<Types>...> typed; ///< Joint configurations grouped by type.
+    JointBatch<Joint> others; ///< Joints not of any of the grouped types.
+};
+
+/// @brief Joint batches for all of the library provided joint types.
+using BuiltinJointBatches = JointBatches<DistanceJointConf, FrictionJointConf, GearJointConf,
+                                         MotorJointConf, PrismaticJointConf, PulleyJointConf,
+                                         RevoluteJointConf, RopeJointConf, TargetJointConf,
+                                         WeldJointConf, WheelJointConf>;
+
+/// @brief Appends the given joint's configuration to the given batch if of the batch's type.
+/// @return <code>true</code> if appended, <code>false</code> otherwise.
+template <class T>
+bool AppendIfType(JointBatch<T>& batch, Joint& joint)
+{
+    if (const auto conf = TypeCast<T>(&joint)) {
+        batch.push_back(conf);
+        return true;
+    }
+    return false;
+}
+
+/// @brief Appends the given joints to the given batches.
+/// @param grouped Whether to group the joints by type, or to append them all to the others
+///   so they're solved in island order through the type-erased interface.
+template <class... Types>
+void Append(JointBatches<Types...>& batches, const Span<const JointID>& joints,
+            ObjectPool<Joint>& jointBuffer, bool grouped)
+{
+    batches.others.reserve(grouped? 0u: size(joints));
+    for (const auto& id: joints) {
+        auto& joint = jointBuffer[to_underlying(id)];
+        if (!grouped || !(AppendIfType(std::get<JointBatch<Types>>(batches.typed), joint) || ...)) {
+            batches.others.push_back(&joint);
+        }
+    }
+}
+
+/// @brief Calls the given function with each of the joints of the given batches.
+/// @details The function is called with a reference to the joint's configuration for
+///   the typed batches, and with a reference to the joint for the others.
+template <class Function, class... Types>
+void ForEachJoint(const JointBatches<Types...>& batches, Function&& function)
+{
+    (std::for_each(begin(std::get<JointBatch<Types>>(batches.typed)),
+                   end(std::get<JointBatch<Types>>(batches.typed)),
+                   [&function](Types* conf) { function(*conf); }), ...);
+    for (const auto joint: batches.others) {
+        function(*joint);
+    }
+}
+
+/// @brief Minimum number of constraints a color needs for it to be solved concurrently.
+/// @note Handing smaller colors off to a task scheduler costs more than it saves.
+constexpr auto MinConcurrentColorSize = std::size_t{32};
+
+/// @brief Calls the given function with the index of each of the given colored constraints.
+/// @details Indices of each color are handed off to the given scheduler, one color after
+///   another, and then the indices of the uncolored constraints are gone through in order.
+template <class Function>
+void ForEachColored(TaskScheduler& scheduler, const ConstraintColors& colors,
+                    const Function& function)
+{
+    for (const auto& color: colors.colors) {
+        if (size(color) < MinConcurrentColorSize) {
+            std::for_each(begin(color), end(color), function);
+            continue;
+        }
+        scheduler.ParallelFor(size(color), [&color,&function](std::size_t first,
+                                                               std::size_t last) {
+            std::for_each(next(begin(color), static_cast<std::ptrdiff_t>(first)),
+                          next(begin(color), static_cast<std::ptrdiff_t>(last)), function);
+        });
+    }
+    std::for_each(begin(colors.uncolored), end(colors.uncolored), function);
+}
+
+/// @brief Solver of the constraints of an island partitioned into colors.
+/// @details Solves the constraints of each color concurrently via a task scheduler, one
+///   color after another, so even a single island can make use of multiple cores while still
+///   solving constraints Gauss-Seidel style.
+/// @note Contacts are colored by just their movable bodies, since the contact solver doesn't
+///   write to others. Joints are colored by all of their bodies. Joints of types that aren't
+///   provided by the library could be using any bodies so they're solved one at a time.
+class ColoredIslandSolver
+{
+public:
+    /// @brief Initializing constructor.
+    ColoredIslandSolver(TaskScheduler& scheduler,
+                        const Span<const JointID>& joints, ObjectPool<Joint>& jointBuffer,
+                        const Span<const VelocityConstraint>& velConstraints,
+                        const Span<const BodyConstraint>& bodies,
+                        const Span<const BodyID>& indices):
+        m_scheduler{scheduler}
+    {
+        const auto toIndex = [&indices](BodyID id) {
+            return IsValid(id)? indices[to_underlying(id)]: InvalidBodyID;
+        };
+        auto jointBodies = std::vector<ConstraintBodies>{};
+        for (const auto& id: joints) {
+            auto& joint = jointBuffer[to_underlying(id)];
+            if (!BuiltinJointBatches::IsGrouped(joint)) {
+                m_otherJoints.push_back(&joint);
+                continue;
+            }
+            auto jointBody = ConstraintBodies{toIndex(GetBodyA(joint)), toIndex(GetBodyB(joint)),
+                                              InvalidBodyID, InvalidBodyID};
+            if (const auto gear = TypeCast<const GearJointConf>(&joint)) {
+                jointBody[2] = toIndex(gear->bodyC);
+                jointBody[3] = toIndex(gear->bodyD);
+            }
+            m_joints.push_back(&joint);
+            jointBodies.push_back(jointBody);
+        }
+        m_jointColors = GetConstraintColors(jointBodies, size(bodies));
+        m_jointsOkay.resize(size(m_joints));
+
+        auto contactBodies = std::vector<ConstraintBodies>{};
+        contactBodies.reserve(size(velConstraints));
+        for (const auto& vc: velConstraints) {
+            const auto bodyA = vc.GetBodyA();
+            const auto bodyB = vc.GetBodyB();
+            contactBodies.push_back(ConstraintBodies{
+                IsMovable(bodies[to_underlying(bodyA)])? bodyA: InvalidBodyID,
+                IsMovable(bodies[to_underlying(bodyB)])? bodyB: InvalidBodyID,
+                InvalidBodyID, InvalidBodyID});
+        }
+        m_contactColors = GetConstraintColors(contactBodies, size(bodies));
+        m_incImpulses.resize(size(velConstraints));
+        m_separations.resize(size(velConstraints));
+    }
+
+    /// @brief Initializes the velocity constraints of the joints.
+    void InitJointVelocities(const BodyConstraintsMap& bodies, const StepConf& conf,
+                             const ConstraintSolverConf& psConf)
+    {
+        ForEachColored(m_scheduler, m_jointColors, [&](std::size_t i) {
+            InitVelocity(*m_joints[i], bodies, conf, psConf);
+        });
+        for (const auto joint: m_otherJoints) {
+            InitVelocity(*joint, bodies, conf, psConf);
+        }
+    }
+
+    /// @brief Solves the velocity constraints of the joints.
+    /// @return Whether all of the joints' velocity constraints were within tolerance.
+    bool SolveJointVelocities(const BodyConstraintsMap& bodies, const StepConf& conf)
+    {
+        ForEachColored(m_scheduler, m_jointColors, [&](std::size_t i) {
+            m_jointsOkay[i] = SolveVelocity(*m_joints[i], bodies, conf);
+        });
+        auto okay = std::all_of(begin(m_jointsOkay), end(m_jointsOkay),
+                                [](std::uint8_t value) { return value != 0u; });
+        for (const auto joint: m_otherJoints) {
+            okay &= SolveVelocity(*joint, bodies, conf);
+        }
+        return okay;
+    }
+
+    /// @brief Solves the given velocity constraints.
+    /// @return Maximum momentum used for solving both the tangential and normal portions of
+    ///   the velocity constraints.
+    /// @see SolveVelocityConstraintsViaGS.
+    Momentum SolveContactVelocities(const Span<VelocityConstraint>& velConstraints,
+                                    const Span<BodyConstraint>& bodies)
+    {
+        assert(size(velConstraints) == size(m_incImpulses));
+        ForEachColored(m_scheduler, m_contactColors, [&](std::size_t i) {
+            m_incImpulses[i] = GaussSeidel::SolveVelocityConstraint(velConstraints[i], bodies);
+        });
+        return empty(m_incImpulses)
+            ? 0_Ns: *std::max_element(begin(m_incImpulses), end(m_incImpulses));
+    }
+
+    /// @brief Solves the given position constraints.
+    /// @return Minimum separation.
+    /// @see SolvePositionConstraintsViaGS.
+    Length SolveContactPositions(const Span<const PositionConstraint>& posConstraints,
+                                 const Span<BodyConstraint>& bodies,
+                                 const ConstraintSolverConf& conf)
+    {
+        assert(size(posConstraints) == size(m_separations));
+        ForEachColored(m_scheduler, m_contactColors, [&](std::size_t i) {
+            const auto& pc = posConstraints[i];
+            const auto res = GaussSeidel::SolvePositionConstraint(pc, true, true, bodies, conf);
+            auto& bodyA = bodies[to_underlying(pc.bodyA)];
+            auto& bodyB = bodies[to_underlying(pc.bodyB)];
+            if (IsMovable(bodyA)) {
+                bodyA.SetPosition(res.pos_a);
+            }
+            if (IsMovable(bodyB)) {
+                bodyB.SetPosition(res.pos_b);
+            }
+            m_separations[i] = res.min_separation;
+        });
+        return empty(m_separations)
+            ? std::numeric_limits<Length>::infinity()
+            : *std::min_element(begin(m_separations), end(m_separations));
+    }
+
+    /// @brief Solves the position constraints of the joints.
+    /// @return Whether all of the joints' position constraints were within tolerance.
+    bool SolveJointPositions(const BodyConstraintsMap& bodies, const ConstraintSolverConf& conf)
+    {
+        ForEachColored(m_scheduler, m_jointColors, [&](std::size_t i) {
+            m_jointsOkay[i] = SolvePosition(*m_joints[i], bodies, conf);
+        });
+        auto okay = std::all_of(begin(m_jointsOkay), end(m_jointsOkay),
+                                [](std::uint8_t value) { return value != 0u; });
+        for (const auto joint: m_otherJoints) {
+            okay &= SolvePosition(*joint, bodies, conf);
+        }
+        return okay;
+    }
+
+private:
+    TaskScheduler& m_scheduler; ///< Scheduler to solve colors of constraints with.
+    std::vector<Joint*> m_joints; ///< Joints of the library provided types.
+    std::vector<Joint*> m_otherJoints; ///< Joints of other types.
+    ConstraintColors m_jointColors; ///< Colors of the joints of the library provided types.
+    ConstraintColors m_contactColors; ///< Colors of the contacts.
+    std::vector<std::uint8_t> m_jointsOkay; ///< Per joint results. Not bool to be thread-safe.
+    std::vector<Momentum> m_incImpulses; ///< Per contact velocity solving results.
+    std::vector<Length> m_separations; ///< Per contact position solving results.
+};
+
 PositionConstraints GetPositionConstraints(pmr::memory_resource& resource,
                                            const Span<const ContactID>& contacts,
                                            const ObjectPool<Contact>& contactBuffer,
                                            const ObjectPool<Manifold>& manifoldBuffer,
-                                           const ObjectPool<Shape>& shapeBuffer)
+                                           const ShapeChildren& shapeChildren,
+                                           const Span<const BodyID>& indices)
 {
     auto constraints = PositionConstraints{&resource};
     constraints.reserve(size(contacts));
@@ -301,10 +743,10 @@ PositionConstraints GetPositionConstraints(pmr::memory_resource& resource,
         const auto shapeB = GetShapeB(contact);
         const auto indexA = GetChildIndexA(contact);
         const auto indexB = GetChildIndexB(contact);
-        const auto bodyA = GetBodyA(contact);
-        const auto bodyB = GetBodyB(contact);
-        const auto radiusA = GetVertexRadius(shapeBuffer[to_underlying(shapeA)], indexA);
-        const auto radiusB = GetVertexRadius(shapeBuffer[to_underlying(shapeB)], indexB);
+        const auto bodyA = indices[to_underlying(GetBodyA(contact))];
+        const auto bodyB = indices[to_underlying(GetBodyB(contact))];
+        const auto radiusA = shapeChildren[to_underlying(shapeA)][indexA].GetVertexRadius();
+        const auto radiusB = shapeChildren[to_underlying(shapeB)][indexB].GetVertexRadius();
         const auto& manifold = manifoldBuffer[to_underlying(contactID)];
         return PositionConstraint{manifold, bodyA, bodyB, radiusA + radiusB};
     });
@@ -322,8 +764,9 @@ VelocityConstraints GetVelocityConstraints(pmr::memory_resource& resource,
                                            const Span<const ContactID>& contacts,
                                            const ObjectPool<Contact>& contactBuffer,
                                            const ObjectPool<Manifold>& manifoldBuffer,
-                                           const ObjectPool<Shape>& shapeBuffer,
+                                           const ShapeChildren& shapeChildren,
                                            const Span<const BodyConstraint>& bodies,
+                                           const Span<const BodyID>& indices,
                                            const VelocityConstraint::Conf conf)
 {
     auto velConstraints = VelocityConstraints{&resource};
@@ -331,8 +774,8 @@ VelocityConstraints GetVelocityConstraints(pmr::memory_resource& resource,
     transform(cbegin(contacts), cend(contacts), back_inserter(velConstraints),
               [&](const auto& contactID) {
         const auto& contact = contactBuffer[to_underlying(contactID)];
-        const auto bodyA = GetBodyA(contact);
-        const auto bodyB = GetBodyB(contact);
+        const auto bodyA = indices[to_underlying(GetBodyA(contact))];
+        const auto bodyB = indices[to_underlying(GetBodyB(contact))];
         const auto shapeIdA = GetShapeA(contact);
         const auto shapeIdB = GetShapeB(contact);
         const auto indexA = GetChildIndexA(contact);
@@ -342,8 +785,8 @@ VelocityConstraints GetVelocityConstraints(pmr::memory_resource& resource,
         const auto tangentSpeed = GetTangentSpeed(contact);
         const auto& bodyConstraintA = bodies[to_underlying(bodyA)];
         const auto& bodyConstraintB = bodies[to_underlying(bodyB)];
-        const auto radiusA = GetVertexRadius(shapeBuffer[to_underlying(shapeIdA)], indexA);
-        const auto radiusB = GetVertexRadius(shapeBuffer[to_underlying(shapeIdB)], indexB);
+        const auto radiusA = shapeChildren[to_underlying(shapeIdA)][indexA].GetVertexRadius();
+        const auto radiusB = shapeChildren[to_underlying(shapeIdB)][indexB].GetVertexRadius();
         const auto xfA = GetTransformation(bodyConstraintA.GetPosition(),
                                            bodyConstraintA.GetLocalCenter());
         const auto xfB = GetTransformation(bodyConstraintB.GetPosition(),
@@ -539,6 +982,48 @@ void ResetContactsForSolveTOI(ObjectPool<Contact>& buffer,
     });
 }
 
+/// @brief TOI event of a contact's time of impact and its position within the world's contacts.
+/// @note Ordering these by position after time of impact picks the same contact as
+///   <code>GetSoonestContact</code> does out of contacts having the same soonest TOI.
+using ToiEvent = std::pair<Real, KeyedContactIDs::size_type>;
+
+/// @brief Queue of TOI events with the soonest one on top.
+using ToiEventQueue = std::priority_queue<ToiEvent, std::vector<ToiEvent>, std::greater<>>;
+
+/// @brief Pushes TOI events for the identified contacts that have a TOI within the step.
+void PushToiEvents(ToiEventQueue& events, const Span<const ContactID>& ids,
+                   const Span<const KeyedContactIDs::size_type>& positions,
+                   const ObjectPool<Contact>& buffer)
+{
+    for (const auto& id: ids) {
+        if (const auto toi = buffer[to_underlying(id)].GetToi()) {
+            if (toi->get() < Real(1)) {
+                events.emplace(toi->get(), positions[to_underlying(id)]);
+            }
+        }
+    }
+}
+
+/// @brief Pops TOI events until finding one that's still current.
+/// @details Events for contacts whose TOI got reset or recomputed since being pushed are
+///   stale and just get dropped. This is cheaper than finding and removing them when the
+///   contacts' TOIs get reset.
+/// @return Identifier of the contact with the soonest TOI or <code>InvalidContactID</code>.
+ContactID PopSoonestContact(ToiEventQueue& events, const KeyedContactIDs& contacts,
+                            const ObjectPool<Contact>& buffer)
+{
+    while (!empty(events)) {
+        const auto event = events.top();
+        events.pop();
+        const auto contactID = std::get<ContactID>(contacts[std::get<1>(event)]);
+        const auto toi = buffer[to_underlying(contactID)].GetToi();
+        if (toi && (toi->get() == std::get<0>(event))) {
+            return contactID;
+        }
+    }
+    return InvalidContactID;
+}
+
 /// @brief Destroys proxies of all tree nodes with the given body and shape identifiers.
 void DestroyProxies(DynamicTree& tree, BodyID bodyId, ShapeID shapeId, ProxyIDs& proxies) noexcept
 {
@@ -554,26 +1039,30 @@ void DestroyProxies(DynamicTree& tree, BodyID bodyId, ShapeID shapeId, ProxyIDs&
     }
 }
 
-auto CreateProxies(DynamicTree& tree,
-                   BodyID bodyID, ShapeID shapeID, const Shape& shape,
-                   const Transformation& xfm0, const Transformation& xfm1,
-                   const StepConf& conf,
-                   ProxyIDs& fixtureProxies,
-                   ProxyIDs& otherProxies) -> ChildCounter
+/// @brief Gets the broad-phase tree partition for the proxies of the given body.
+DynamicTree::Partition GetPartition(const Body& body) noexcept
 {
-    // Reserve proxy space and create proxies in the broad-phase.
-    const auto childCount = GetChildCount(shape);
-    fixtureProxies.reserve(size(fixtureProxies) + childCount);
-    otherProxies.reserve(size(otherProxies) + childCount);
+    return (GetType(body) == BodyType::Static)
+        ? DynamicTree::Partition::Static: DynamicTree::Partition::Dynamic;
+}
+
+/// @brief Appends the broad-phase leaf AABBs and data for the identified shape's children.
+/// @see DynamicTree::CreateLeaves.
+auto AppendLeaves(BodyID bodyID, ShapeID shapeID, const std::vector<DistanceProxy>& children,
+                  const Transformation& xfm0, const Transformation& xfm1,
+                  const StepConf& conf,
+                  std::vector<AABB>& aabbs,
+                  std::vector<Contactable>& leafData) -> ChildCounter
+{
+    const auto childCount = static_cast<ChildCounter>(size(children));
+    aabbs.reserve(size(aabbs) + childCount);
+    leafData.reserve(size(leafData) + childCount);
     const auto displacement = conf.displaceMultiplier * (xfm1.p - xfm0.p);
     for (auto childID = decltype(childCount){0}; childID < childCount; ++childID) {
-        const auto dp = GetChild(shape, childID);
-        const auto baseAABB = ComputeAABB(dp, xfm0, xfm1);
+        const auto baseAABB = ComputeAABB(children[childID], xfm0, xfm1);
         const auto fattenedAABB = GetFattenedAABB(baseAABB, conf.aabbExtension);
-        const auto displacedAABB = GetDisplacedAABB(fattenedAABB, displacement);
-        const auto treeID = tree.CreateLeaf(displacedAABB, Contactable{bodyID, shapeID, childID});
-        fixtureProxies.push_back(treeID);
-        otherProxies.push_back(treeID);
+        aabbs.push_back(GetDisplacedAABB(fattenedAABB, displacement));
+        leafData.push_back(Contactable{bodyID, shapeID, childID});
     }
     return childCount;
 }
@@ -706,26 +1195,26 @@ RemoveUnspeedablesFromIslanded(const Span<const BodyID>& bodies,
     return numRemoved;
 }
 
-auto FindContacts(pmr::memory_resource& resource,
-                  const DynamicTree& tree,
-                  const ProxyIDs& proxies)
-    -> std::vector<AabbTreeWorld::ProxyKey, pmr::polymorphic_allocator<AabbTreeWorld::ProxyKey>>
+/// @brief Appends the keys of the proxies overlapping the given proxies.
+/// @param wideTree Optional collapsed equivalent of the given tree to query instead of it.
+/// @note This only reads from the given trees so it can be called concurrently.
+template <class Container>
+void AppendProxyKeys(Container& proxyKeys, const DynamicTree& tree,
+                     const WideDynamicTree* wideTree,
+                     const Span<const DynamicTree::Size>& proxies)
 {
-    std::vector<AabbTreeWorld::ProxyKey, pmr::polymorphic_allocator<AabbTreeWorld::ProxyKey>>
-        proxyKeys{&resource};
-    // Never need more than tree.GetLeafCount(), but in case big, use smaller default...
-    static constexpr auto DefaultReserveSize = 256u;
-    proxyKeys.reserve(std::min(tree.GetLeafCount(), DefaultReserveSize));
-
     // Accumalate contact keys for pairs of nodes that are overlapping and aren't identical.
     // Note that if the dynamic tree node provides the body index, it's assumed to be faster
     // to eliminate any node pairs that have the same body here before the key pairs are
     // sorted.
+    // Static proxies only need to be checked against the dynamic partition since contacts
+    // between two static bodies are never made.
     for_each(cbegin(proxies), cend(proxies), [&](DynamicTree::Size pid) {
         const auto &node = tree.GetNode(pid);
         const auto aabb = node.GetAABB();
         const auto leaf0 = node.AsLeaf();
-        Query(tree, aabb, [pid,leaf0,&proxyKeys,&tree](DynamicTree::Size nodeId) {
+        const auto isStatic = (tree.GetPartition(pid) == DynamicTree::Partition::Static);
+        const auto callback = [pid,leaf0,&proxyKeys,&tree](DynamicTree::Size nodeId) {
             const auto leaf1 = tree.GetLeafData(nodeId);
             // A proxy cannot form a pair with itself.
             if ((nodeId != pid) && (leaf0.bodyId != leaf1.bodyId)) {
@@ -738,14 +1227,96 @@ auto FindContacts(pmr::memory_resource& resource,
                 }
             }
             return DynamicTreeOpcode::Continue;
-        });
+        };
+        if (wideTree) {
+            Query(*wideTree, isStatic? wideTree->GetRootIndex(DynamicTree::Partition::Dynamic)
+                  : wideTree->GetRootIndex(), aabb, callback);
+        }
+        else {
+            Query(tree, isStatic? tree.GetRootIndex(DynamicTree::Partition::Dynamic)
+                  : tree.GetRootIndex(), aabb, callback);
+        }
     });
+}
 
-    // Sort and eliminate any duplicate contact keys.
-    sort(begin(proxyKeys), end(proxyKeys),
-         [](const AabbTreeWorld::ProxyKey& a, const AabbTreeWorld::ProxyKey& b) {
-        return std::get<0>(a) < std::get<0>(b);
-    });
+/// @brief Compares proxy keys by their contact keys.
+inline bool LessContactKey(const AabbTreeWorld::ProxyKey& a, const AabbTreeWorld::ProxyKey& b) noexcept
+{
+    return std::get<0>(a) < std::get<0>(b);
+}
+
+/// @brief Sorts and eliminates any duplicate proxy keys.
+/// @note Proxy keys having the same contact key are the same, so which of those is kept
+///   doesn't matter.
+template <class Container>
+void SortAndUnique(Container& proxyKeys)
+{
+    sort(begin(proxyKeys), end(proxyKeys), LessContactKey);
+    proxyKeys.erase(unique(begin(proxyKeys), end(proxyKeys)), end(proxyKeys));
+}
+
+/// @brief Leaves per proxy at or below which contacts are found with a collapsed tree.
+/// @details Collapsing takes time linear in the number of leaves, which is only made up for
+///   by the quicker queries when there are enough proxies to query for.
+/// @see AabbTreeWorld::GetWideTree.
+constexpr auto WideTreeLeavesPerProxy = std::size_t{8};
+
+/// @brief Finds the keys of the proxies overlapping the given proxies.
+/// @details If given a task scheduler, the given proxies are split up into contiguous ranges
+///   of proxies that get queried and sorted concurrently into their own buffers. These sorted
+///   buffers are then merged. Results are the same as without a task scheduler.
+/// @param wideTree Optional collapsed equivalent of the given tree to query instead of it.
+/// @return Sorted keys without any duplicates.
+auto FindContacts(pmr::memory_resource& resource,
+                  const DynamicTree& tree,
+                  const WideDynamicTree* wideTree,
+                  const ProxyIDs& proxies,
+                  TaskScheduler* scheduler = nullptr,
+                  Tracer* tracer = nullptr)
+    -> std::vector<AabbTreeWorld::ProxyKey, pmr::polymorphic_allocator<AabbTreeWorld::ProxyKey>>
+{
+    const auto trace = TraceScope{tracer, "FindContacts"};
+    std::vector<AabbTreeWorld::ProxyKey, pmr::polymorphic_allocator<AabbTreeWorld::ProxyKey>>
+        proxyKeys{&resource};
+    const auto numProxies = size(proxies);
+    const auto numTasks = (scheduler && (numProxies > 1u))
+        ? std::clamp(scheduler->GetConcurrency(), std::size_t{1}, numProxies): std::size_t{1};
+    if (numTasks == 1u) {
+        // Never need more than tree.GetLeafCount(), but in case big, use smaller default...
+        static constexpr auto DefaultReserveSize = 256u;
+        proxyKeys.reserve(std::min(tree.GetLeafCount(), DefaultReserveSize));
+        AppendProxyKeys(proxyKeys, tree, wideTree, proxies);
+        SortAndUnique(proxyKeys);
+        return proxyKeys;
+    }
+
+    auto buffers = std::vector<std::vector<AabbTreeWorld::ProxyKey>>(numTasks);
+    auto tasks = std::vector<TaskScheduler::Task>{};
+    tasks.reserve(numTasks);
+    const auto perTask = numProxies / numTasks;
+    const auto extra = numProxies % numTasks;
+    auto first = std::size_t{0};
+    for (auto i = std::size_t{0}; i < numTasks; ++i) {
+        const auto count = perTask + ((i < extra)? 1u: 0u);
+        tasks.emplace_back([&tree,wideTree,tracer,&buffer = buffers[i],range = Span<const DynamicTree::Size>{data(proxies) + first, count}]{
+            const auto taskTrace = TraceScope{tracer, "FindContactsTask"};
+            AppendProxyKeys(buffer, tree, wideTree, range);
+            SortAndUnique(buffer);
+        });
+        first += count;
+    }
+    scheduler->Run(tasks);
+
+    auto total = std::size_t{0};
+    for (const auto& buffer: buffers) {
+        total += size(buffer);
+    }
+    proxyKeys.reserve(total);
+    for (const auto& buffer: buffers) {
+        const auto middle = ToSigned(size(proxyKeys));
+        proxyKeys.insert(end(proxyKeys), cbegin(buffer), cend(buffer));
+        std::inplace_merge(begin(proxyKeys), begin(proxyKeys) + middle, end(proxyKeys), LessContactKey);
+    }
     proxyKeys.erase(unique(begin(proxyKeys), end(proxyKeys)), end(proxyKeys));
     return proxyKeys;
 }
@@ -775,6 +1346,21 @@ auto GetProxyKeysOpts(const WorldConf& conf) -> pmr::PoolMemoryOptions
     return {conf.reserveBuffers, conf.reserveContactKeys * sizeof(AabbTreeWorld::ProxyKey)};
 }
 
+auto GetStepArenaOpts(const WorldConf& conf) -> pmr::MonotonicMemoryOptions
+{
+    return {GetBodyStackOpts(conf).reserveBytes
+        + GetBodyConstraintOpts(conf).reserveBytes
+        + GetPositionConstraintsOpts(conf).reserveBytes
+        + GetVelocityConstraintsOpts(conf).reserveBytes
+        + GetProxyKeysOpts(conf).reserveBytes};
+}
+
+auto MakeStepArena(const pmr::MonotonicMemoryOptions& options, pmr::memory_resource* upstream)
+    -> std::unique_ptr<pmr::MonotonicMemoryResource>
+{
+    return std::make_unique<pmr::MonotonicMemoryResource>(options, upstream);
+}
+
 auto IsGeomChanged(const Shape& shape0, const Shape& shape1) -> bool
 {
     const auto numKids0 = GetChildCount(shape0);
@@ -815,6 +1401,39 @@ auto SetAwake(ObjectPool<Body>& bodies, const Contact& c) -> void
     SetAwake(bodies[to_underlying(GetBodyB(c))]);
 }
 
+/// @brief Gets the identified body from the given bodies for updating in place.
+/// @throws WrongState if the given world is locked.
+/// @throws std::out_of_range if given an invalid id.
+/// @throws InvalidArgument if the specified ID was destroyed.
+Body& AtUnlocked(const AabbTreeWorld& world, ObjectPool<Body>& bodies, BodyID id)
+{
+    if (IsLocked(world)) {
+        throw WrongState(worldIsLockedMsg);
+    }
+    auto& elem = At(bodies, id, noSuchBodyMsg);
+    if (bodies.FindFree(to_underlying(id))) {
+        throw WasDestroyed{id, idIsDestroyedMsg};
+    }
+    return elem;
+}
+
+/// @brief Throws if the given span isn't empty and doesn't have the given size.
+/// @throws InvalidArgument if the span isn't empty and doesn't have the given size.
+template <class T>
+void ValidateStateSize(const Span<T>& values, std::size_t size)
+{
+    if (!empty(values) && (values.size() != size)) {
+        throw InvalidArgument("state span size must match body identifiers size");
+    }
+}
+
+/// @brief Erases the given number of elements from the front of the given vector.
+template <class T>
+void EraseFront(std::vector<T>& values, std::size_t count)
+{
+    values.erase(begin(values), next(begin(values), static_cast<std::ptrdiff_t>(count)));
+}
+
 } // anonymous namespace
 
 AabbTreeWorld::AabbTreeWorld(const WorldConf& conf):
@@ -829,7 +1448,13 @@ AabbTreeWorld::AabbTreeWorld(const WorldConf& conf):
                                   conf.doStats? &m_statsResource: conf.upstream),
     m_proxyKeysResource(GetProxyKeysOpts(conf), conf.doStats? &m_statsResource: conf.upstream),
     m_islandResource({conf.reserveBuffers}, conf.doStats? &m_statsResource: conf.upstream),
+    m_stepArena(conf.doStepArena
+                ? MakeStepArena(GetStepArenaOpts(conf), conf.doStats? &m_statsResource: conf.upstream)
+                : nullptr),
     m_tree(conf.treeCapacity),
+    m_taskScheduler{conf.taskScheduler},
+    m_tracer{conf.tracer},
+    m_contactEvents{conf.doContactEvents? std::optional<ContactEvents>{std::in_place}: std::nullopt},
     m_vertexRadius{conf.vertexRadius}
 {
     m_proxiesForContacts.reserve(conf.proxyCapacity);
@@ -856,9 +1481,15 @@ AabbTreeWorld::AabbTreeWorld(const AabbTreeWorld& other):
     m_islandResource(other.m_islandResource.GetOptions(),
                      other.m_statsResource.upstream_resource()?
                      &m_statsResource: other.m_islandResource.GetUpstream()),
+    m_stepArena(other.m_stepArena
+                ? MakeStepArena(other.m_stepArena->GetOptions(),
+                                other.m_statsResource.upstream_resource()?
+                                &m_statsResource: other.m_stepArena->GetUpstream())
+                : nullptr),
     m_tree(other.m_tree),
     m_bodyBuffer(other.m_bodyBuffer),
     m_shapeBuffer(other.m_shapeBuffer),
+    m_shapeChildren(other.m_shapeChildren), // proxies refer to values shared by the copies
     m_jointBuffer(other.m_jointBuffer),
     m_contactBuffer(other.m_contactBuffer),
     m_manifoldBuffer(other.m_manifoldBuffer),
@@ -872,7 +1503,12 @@ AabbTreeWorld::AabbTreeWorld(const AabbTreeWorld& other):
     m_joints(other.m_joints),
     m_contacts(other.m_contacts),
     m_islanded(other.m_islanded),
+    m_islandSets(other.m_islandSets),
+    m_taskScheduler(other.m_taskScheduler),
+    m_tracer(other.m_tracer),
     m_listeners(other.m_listeners),
+    m_contactEvents(other.m_contactEvents),
+    m_stepContactEventCounts(other.m_stepContactEventCounts),
     m_flags(other.m_flags),
     m_inv_dt0(other.m_inv_dt0),
     m_vertexRadius(other.m_vertexRadius)
@@ -896,9 +1532,15 @@ AabbTreeWorld::AabbTreeWorld(AabbTreeWorld&& other) noexcept:
     m_islandResource(other.m_islandResource.GetOptions(),
                      other.m_statsResource.upstream_resource()?
                      &m_statsResource: other.m_islandResource.GetUpstream()),
+    m_stepArena(other.m_stepArena
+                ? MakeStepArena(other.m_stepArena->GetOptions(),
+                                other.m_statsResource.upstream_resource()?
+                                &m_statsResource: other.m_stepArena->GetUpstream())
+                : nullptr),
     m_tree(std::move(other.m_tree)),
     m_bodyBuffer(std::move(other.m_bodyBuffer)),
     m_shapeBuffer(std::move(other.m_shapeBuffer)),
+    m_shapeChildren(std::move(other.m_shapeChildren)),
     m_jointBuffer(std::move(other.m_jointBuffer)),
     m_contactBuffer(std::move(other.m_contactBuffer)),
     m_manifoldBuffer(std::move(other.m_manifoldBuffer)),
@@ -912,7 +1554,13 @@ AabbTreeWorld::AabbTreeWorld(AabbTreeWorld&& other) noexcept:
     m_joints(std::move(other.m_joints)),
     m_contacts(std::move(other.m_contacts)),
     m_islanded(std::move(other.m_islanded)),
+    m_islandSets(std::move(other.m_islandSets)),
+    m_islandBatchResources(std::move(other.m_islandBatchResources)),
+    m_taskScheduler(other.m_taskScheduler),
+    m_tracer(other.m_tracer),
     m_listeners(std::move(other.m_listeners)),
+    m_contactEvents(std::move(other.m_contactEvents)),
+    m_stepContactEventCounts(other.m_stepContactEventCounts),
     m_flags(other.m_flags),
     m_inv_dt0(other.m_inv_dt0),
     m_vertexRadius(other.m_vertexRadius)
@@ -984,6 +1632,7 @@ void Clear(AabbTreeWorld& world) noexcept
     world.m_islanded.bodies.clear();
     world.m_islanded.joints.clear();
     world.m_islanded.contacts.clear();
+    world.m_islandSets.clear();
     world.m_contacts.clear();
     world.m_joints.clear();
     world.m_bodies.clear();
@@ -996,9 +1645,20 @@ void Clear(AabbTreeWorld& world) noexcept
     world.m_jointBuffer.clear();
     world.m_bodyBuffer.clear();
     world.m_shapeBuffer.clear();
+    world.m_shapeChildren.clear();
     world.m_bodyProxies.clear();
     world.m_bodyContacts.clear();
     world.m_bodyJoints.clear();
+    if (world.m_contactEvents) {
+        Clear(*world.m_contactEvents);
+    }
+    world.m_stepContactEventCounts = {};
+}
+
+const ContactEvents& GetContactEvents(const AabbTreeWorld& world) noexcept
+{
+    static const auto none = ContactEvents{};
+    return world.m_contactEvents? *world.m_contactEvents: none;
 }
 
 BodyCounter GetBodyRange(const AabbTreeWorld& world) noexcept
@@ -1028,6 +1688,8 @@ BodyID CreateBody(AabbTreeWorld& world, Body body)
     const auto id = static_cast<BodyID>(
         static_cast<BodyID::underlying_type>(world.m_bodyBuffer.Allocate(std::move(body))));
     world.m_islanded.bodies.resize(size(world.m_bodyBuffer));
+    world.m_islandSets.resize(static_cast<IslandSets::size_type>(size(world.m_bodyBuffer)));
+    world.m_islandSets.Reset(id);
     const auto bodyContactsIndex = world.m_bodyContacts.Allocate();
     static constexpr auto DefaultBodyContactsReserveSize = 32u;
     world.m_bodyContacts[bodyContactsIndex].reserve(DefaultBodyContactsReserveSize);
@@ -1056,6 +1718,7 @@ void AabbTreeWorld::Remove(BodyID id)
         m_bodyContacts.Free(to_underlying(id));
         m_bodyBuffer.Free(to_underlying(id)).SetDestroyed();
         m_islanded.bodies.resize(size(m_bodyBuffer));
+        m_islandSets.resize(static_cast<IslandSets::size_type>(size(m_bodyBuffer)));
     }
 }
 
@@ -1102,6 +1765,8 @@ void Destroy(AabbTreeWorld& world, BodyID id)
             world.m_listeners.detach(std::make_pair(id, shapeId));
         }
     }
+    // Body no longer has any joints or contacts so this leaves it in a set of its own.
+    world.SplitIsland(id);
     world.Remove(id);
 }
 
@@ -1167,6 +1832,7 @@ void AabbTreeWorld::Add(JointID id, bool flagForFiltering)
     if (bodyB != InvalidBodyID) {
         m_bodyJoints[to_underlying(bodyB)].emplace_back(bodyA, id);
     }
+    LinkToIsland(id);
     if (flagForFiltering && (bodyA != InvalidBodyID) && (bodyB != InvalidBodyID)) {
         if (FlagForFiltering(m_contactBuffer, bodyA, m_bodyContacts[to_underlying(bodyB)], bodyB)) {
             m_flags |= e_needsContactFiltering;
@@ -1181,6 +1847,7 @@ void AabbTreeWorld::Remove(JointID id)
     const auto bodyIdA = GetBodyA(joint);
     const auto bodyIdB = GetBodyB(joint);
     const auto collideConnected = GetCollideConnected(joint);
+    UnlinkFromIsland(id);
 
     // If the joint prevented collisions, then flag any contacts for filtering.
     if ((!collideConnected) && (bodyIdA != InvalidBodyID) && (bodyIdB != InvalidBodyID)) {
@@ -1253,7 +1920,13 @@ ShapeID CreateShape(AabbTreeWorld& world, Shape def)
     if (size(world.m_shapeBuffer) >= MaxShapes) {
         throw LengthError("CreateShape: operation would exceed MaxShapes");
     }
-    return static_cast<ShapeID>(static_cast<ShapeID::underlying_type>(world.m_shapeBuffer.Allocate(std::move(def))));
+    auto children = GetChildren(def);
+    const auto index = world.m_shapeBuffer.Allocate(std::move(def));
+    if (index >= size(world.m_shapeChildren)) {
+        world.m_shapeChildren.resize(index + 1u);
+    }
+    world.m_shapeChildren[index] = std::move(children);
+    return static_cast<ShapeID>(static_cast<ShapeID::underlying_type>(index));
 }
 
 void Destroy(AabbTreeWorld& world, ShapeID id)
@@ -1274,6 +1947,7 @@ void Destroy(AabbTreeWorld& world, ShapeID id)
         }
     }
     world.m_shapeBuffer.Free(to_underlying(id));
+    world.m_shapeChildren[to_underlying(id)].clear();
 }
 
 const Shape& GetShape(const AabbTreeWorld& world, ShapeID id)
@@ -1352,13 +2026,11 @@ void SetShape(AabbTreeWorld& world, ShapeID id, Shape def) // NOLINT(readability
             }
         }
     }
+    world.m_shapeChildren[to_underlying(id)] = GetChildren(def);
     shape = std::move(def);
 }
 
-void AabbTreeWorld::AddToIsland(Island& island, BodyID seedID,
-                            BodyCounter& remNumBodies,
-                            ContactCounter& remNumContacts,
-                            JointCounter& remNumJoints)
+void AabbTreeWorld::AddToIsland(Island& island, BodyID seedID)
 {
 #ifndef NDEBUG
     assert(!m_islanded.bodies[to_underlying(seedID)]);
@@ -1366,179 +2038,274 @@ void AabbTreeWorld::AddToIsland(Island& island, BodyID seedID,
     assert(IsSpeedable(seed));
     assert(IsAwake(seed));
     assert(IsEnabled(seed));
-    assert(remNumBodies != 0);
-    assert(remNumBodies < MaxBodies);
 #endif
-    // Perform a depth first search (DFS) on the constraint graph.
-    // Create a stack for bodies to be is-in-island that aren't already in the island.
-    auto stack = BodyStack{&m_bodyStackResource};
-    stack.reserve(remNumBodies);
-    stack.push_back(seedID);
-    m_islanded.bodies[to_underlying(seedID)] = true;
-    AddToIsland(island, stack, remNumBodies, remNumContacts, remNumJoints);
-}
-
-void AabbTreeWorld::AddToIsland(Island& island, BodyStack& stack,
-                            BodyCounter& remNumBodies,
-                            ContactCounter& remNumContacts,
-                            JointCounter& remNumJoints)
-{
-    while (!empty(stack)) {
-        // Grab the next body off the stack and add it to the island.
-        const auto bodyID = stack.back();
-        stack.pop_back();
-
+    // Use the members and constraints of the seed's island set instead of searching the
+    // constraint graph for them. Sets only ever have speedable members and have all of the
+    // touching contacts and joints that connect any of their members.
+    island.bodies.reserve(m_islandSets.GetSize(seedID));
+    auto bodyID = seedID;
+    do {
         auto& body = m_bodyBuffer[to_underlying(bodyID)];
-
-        assert(IsEnabled(body));
-        island.bodies.push_back(bodyID);
-        assert(remNumBodies > 0);
-        --remNumBodies;
-
-        // Don't propagate islands across bodies that can't have a velocity (static bodies).
-        // This keeps islands smaller and helps with isolating separable collision clusters.
-        if (!IsSpeedable(body)) {
-            continue;
+        assert(IsSpeedable(body));
+        assert(!m_islanded.bodies[to_underlying(bodyID)]);
+        if (IsEnabled(body)) {
+            m_islanded.bodies[to_underlying(bodyID)] = true;
+            island.bodies.push_back(bodyID);
+            // Make sure the body is awake (without resetting sleep timer).
+            body.SetAwakeFlag();
         }
+        bodyID = m_islandSets.GetNext(bodyID);
+    } while (bodyID != seedID);
+    if (const auto first = m_islandSets.GetContact(seedID); IsValid(first)) {
+        auto contactID = first;
+        do {
+            const auto& contact = m_contactBuffer[to_underlying(contactID)];
+            assert(IsTouching(contact) && !IsSensor(contact));
+            if (IsEnabled(contact)) {
+                island.contacts.push_back(contactID);
+                AddStaticToIsland(island, GetBodyA(contact));
+                AddStaticToIsland(island, GetBodyB(contact));
+            }
+            contactID = m_islandSets.GetNext(contactID);
+        } while (contactID != first);
+    }
+    if (const auto first = m_islandSets.GetJoint(seedID); IsValid(first)) {
+        auto jointID = first;
+        do {
+            const auto& joint = m_jointBuffer[to_underlying(jointID)];
+            const auto bodyA = GetBodyA(joint);
+            const auto bodyB = GetBodyB(joint);
+            if ((!IsValid(bodyA) || IsEnabled(m_bodyBuffer[to_underlying(bodyA)])) &&
+                (!IsValid(bodyB) || IsEnabled(m_bodyBuffer[to_underlying(bodyB)]))) {
+                island.joints.push_back(jointID);
+                AddStaticToIsland(island, bodyA);
+                AddStaticToIsland(island, bodyB);
+            }
+            jointID = m_islandSets.GetNext(jointID);
+        } while (jointID != first);
+    }
+}
 
-        // Make sure the body is awake (without resetting sleep timer).
-        body.SetAwakeFlag();
-
-        const auto oldNumContacts = size(island.contacts);
-        // Adds appropriate contacts of current body and appropriate 'other' bodies of those contacts.
-        AddContactsToIsland(island, stack, m_bodyContacts[to_underlying(bodyID)], bodyID);
+void AabbTreeWorld::AddStaticToIsland(Island& island, BodyID bodyID)
+{
+    if (!IsValid(bodyID) || m_islanded.bodies[to_underlying(bodyID)]) {
+        return;
+    }
+    // Don't propagate islands across bodies that can't have a velocity (static bodies).
+    // This keeps islands smaller and helps with isolating separable collision clusters.
+    // Such bodies are never members of sets of more than themselves so they get added here.
+    assert(!IsSpeedable(m_bodyBuffer[to_underlying(bodyID)]));
+    m_islanded.bodies[to_underlying(bodyID)] = true;
+    island.bodies.push_back(bodyID);
+}
 
-        const auto newNumContacts = size(island.contacts);
-        assert(newNumContacts >= oldNumContacts);
-        const auto netNumContacts = newNumContacts - oldNumContacts;
-        assert(remNumContacts >= netNumContacts);
-        remNumContacts -= static_cast<ContactCounter>(netNumContacts);
+void AabbTreeWorld::LinkToIsland(ContactID id)
+{
+    const auto& contact = m_contactBuffer[to_underlying(id)];
+    const auto bodyA = GetBodyA(contact);
+    const auto bodyB = GetBodyB(contact);
+    const auto speedableA = IsSpeedable(m_bodyBuffer[to_underlying(bodyA)]);
+    const auto speedableB = IsSpeedable(m_bodyBuffer[to_underlying(bodyB)]);
+    if (speedableA && speedableB) {
+        m_islandSets.Join(bodyA, bodyB);
+    }
+    // Contacts are only made when at least one of the bodies is speedable.
+    assert(speedableA || speedableB);
+    m_islandSets.Link(id, speedableA? bodyA: bodyB);
+}
 
-        const auto numJoints = size(island.joints);
-        // Adds appropriate joints of current body and appropriate 'other' bodies of those joint.
-        AddJointsToIsland(island, stack, m_bodyJoints[to_underlying(bodyID)]);
+void AabbTreeWorld::LinkToIsland(JointID id)
+{
+    const auto& joint = m_jointBuffer[to_underlying(id)];
+    const auto bodyA = GetBodyA(joint);
+    const auto bodyB = GetBodyB(joint);
+    const auto speedableA = IsValid(bodyA) && IsSpeedable(m_bodyBuffer[to_underlying(bodyA)]);
+    const auto speedableB = IsValid(bodyB) && IsSpeedable(m_bodyBuffer[to_underlying(bodyB)]);
+    if (speedableA && speedableB) {
+        m_islandSets.Join(bodyA, bodyB);
+    }
+    // Joints between bodies that can't move are never solved.
+    if (speedableA || speedableB) {
+        m_islandSets.Link(id, speedableA? bodyA: bodyB);
+    }
+}
 
-        remNumJoints -= static_cast<JointCounter>(size(island.joints) - numJoints);
+void AabbTreeWorld::UnlinkFromIsland(ContactID id)
+{
+    if (m_islandSets.IsLinked(id)) {
+        m_islandSets.Unlink(id);
     }
 }
 
-void AabbTreeWorld::AddContactsToIsland(Island& island, BodyStack& stack,
-                                    const BodyContactIDs& contacts,
-                                    BodyID bodyID)
+void AabbTreeWorld::UnlinkFromIsland(JointID id)
 {
-    for_each(cbegin(contacts), cend(contacts), [&](const auto& ci) {
-        const auto contactID = std::get<ContactID>(ci);
-        if (!m_islanded.contacts[to_underlying(contactID)]) {
-            const auto& contact = m_contactBuffer[to_underlying(contactID)];
-            if (IsEnabled(contact) && IsTouching(contact) && !IsSensor(contact)) {
-                const auto other = GetOtherBody(contact, bodyID);
-                island.contacts.push_back(contactID);
-                m_islanded.contacts[to_underlying(contactID)] = true;
-                if (!m_islanded.bodies[to_underlying(other)]) {
-                    m_islanded.bodies[to_underlying(other)] = true;
-                    stack.push_back(other);
-                }
-            }
-        }
-    });
+    if (m_islandSets.IsLinked(id)) {
+        m_islandSets.Unlink(id);
+    }
 }
 
-void AabbTreeWorld::AddJointsToIsland(Island& island, BodyStack& stack,
-                                  const BodyJointIDs& joints)
+void AabbTreeWorld::SplitIsland(BodyID id)
 {
-    for_each(cbegin(joints), cend(joints), [this,&island,&stack](const auto& ji) {
-        const auto jointID = std::get<JointID>(ji);
-        assert(jointID != InvalidJointID);
-        if (!m_islanded.joints[to_underlying(jointID)]) {
-            const auto otherID = std::get<BodyID>(ji);
-            const auto other = (otherID == InvalidBodyID)
-                                   ? static_cast<Body*>(nullptr)
-                                   : &m_bodyBuffer[to_underlying(otherID)];
-            assert(!other || IsEnabled(*other) || !IsAwake(*other));
-            if (!other || IsEnabled(*other))
-            {
-                m_islanded.joints[to_underlying(jointID)] = true;
-                island.joints.push_back(jointID);
-                if ((otherID != InvalidBodyID) && !m_islanded.bodies[to_underlying(otherID)])
-                {
-                    m_islanded.bodies[to_underlying(otherID)] = true;
-                    stack.push_back(otherID);
-                }
-            }
-        }
-    });
+    // Take everything out of the set first since resetting its members breaks it up.
+    auto& resource = GetStepResource(m_islandResource);
+    auto set = Island{GetStepResource(m_bodyStackResource), resource, resource};
+    set.bodies.reserve(m_islandSets.GetSize(id));
+    auto member = id;
+    do {
+        set.bodies.push_back(member);
+        member = m_islandSets.GetNext(member);
+    } while (member != id);
+    for (auto contactID = m_islandSets.GetContact(id); IsValid(contactID);
+         contactID = m_islandSets.GetContact(id)) {
+        m_islandSets.Unlink(contactID);
+        set.contacts.push_back(contactID);
+    }
+    for (auto jointID = m_islandSets.GetJoint(id); IsValid(jointID);
+         jointID = m_islandSets.GetJoint(id)) {
+        m_islandSets.Unlink(jointID);
+        set.joints.push_back(jointID);
+    }
+    for (const auto& bodyID: set.bodies) {
+        m_islandSets.Reset(bodyID);
+    }
+    // Joining back up by the remaining constraints leaves just the sets that are islands.
+    for (const auto& contactID: set.contacts) {
+        LinkToIsland(contactID);
+    }
+    for (const auto& jointID: set.joints) {
+        LinkToIsland(jointID);
+    }
 }
 
-RegStepStats AabbTreeWorld::SolveReg(const StepConf& conf)
+RegStepStats AabbTreeWorld::SolveReg(const StepConf& conf, StepTimes& times)
 {
+    const auto trace = TraceScope{m_tracer, "SolveReg"};
     assert(IsStepComplete(*this));
     assert(IsLocked(*this));
 
+    assert(size(m_islandSets) == size(m_bodyBuffer));
+
     auto stats = RegStepStats{};
-    auto remNumBodies = static_cast<BodyCounter>(size(m_bodies)); // Remaining # of bodies.
-    auto remNumContacts = static_cast<ContactCounter>(size(m_contacts)); // Remaining # of contacts.
-    auto remNumJoints = static_cast<JointCounter>(size(m_joints)); // Remaining # of joints.
 
     // Clear all the island flags.
     // This builds the logical set of bodies, contacts, and joints eligible for resolution.
     // As bodies, contacts, or joints get added to resolution islands, they're essentially
     // removed from this eligible set.
+    // Contacts and joints don't need this since each is linked to only one island set.
     ResizeAndReset(m_islanded.bodies, size(m_bodyBuffer), false);
-    ResizeAndReset(m_islanded.contacts, size(m_contactBuffer), false);
-    ResizeAndReset(m_islanded.joints, size(m_jointBuffer), false);
 
-#if defined(DO_THREADED)
-    std::vector<std::future<IslandStats>> futures;
-    futures.reserve(remNumBodies);
-#endif
-    // Build and simulate all awake islands.
+    // Map of body identifiers to island-local body constraint indices. Only entries for
+    // an island's bodies get set while solving that island and they're reset after.
+    m_bodyConstraintIndices.resize(size(m_bodyBuffer), InvalidBodyID);
+
+    // Build all awake islands before solving any, so that solving them can be done in any
+    // order or concurrently without changing which islands there are.
+    auto islandTimer = PhaseTimer{GetTimed(conf, times.islandBuilding)};
+    auto numIslands = std::size_t{0};
     for (const auto& bodyId: m_bodies) {
         if (!m_islanded.bodies[to_underlying(bodyId)]) {
             auto& body = m_bodyBuffer[to_underlying(bodyId)];
             assert(!IsAwake(body) || IsSpeedable(body));
             if (IsAwake(body) && IsEnabled(body)) {
                 ++stats.islandsFound;
-                Island island{m_islandResource, m_islandResource, m_islandResource};
-                // Size the island for the remaining un-evaluated contacts.
-                island.bodies.reserve(remNumBodies);
-                island.contacts.reserve(remNumContacts);
-                island.joints.reserve(remNumJoints);
-                AddToIsland(island, bodyId, remNumBodies, remNumContacts, remNumJoints);
+                if (size(m_islands) == numIslands) {
+                    m_islands.emplace_back(m_islandResource, m_islandResource, m_islandResource);
+                }
+                auto& island = m_islands[numIslands++];
+                Clear(island);
+                AddToIsland(island, bodyId);
 #if defined(DO_SORT_ISLANDS)
                 Sort(island);
 #endif
                 stats.maxIslandBodies = std::max(stats.maxIslandBodies,
                                                  static_cast<BodyCounter>(size(island.bodies)));
-                const auto numRemoved = RemoveUnspeedablesFromIslanded(island.bodies, m_bodyBuffer, m_islanded.bodies);
-                remNumBodies += static_cast<BodyCounter>(numRemoved);
-#if defined(DO_THREADED)
-                // Updates bodies' sweep.pos0 to current sweep.pos1 and bodies' sweep.pos1 to new positions
-                futures.push_back(std::async(std::launch::async, &AabbTreeWorld::SolveRegIslandViaGS,
-                                             this, conf, island));
-#else
-                ::playrho::Update(stats, SolveRegIslandViaGS(conf, island));
-#endif
+                RemoveUnspeedablesFromIslanded(island.bodies, m_bodyBuffer, m_islanded.bodies);
+                // Update bodies' pos0 values. Done here since static bodies can be in more
+                // than one island.
+                for_each(cbegin(island.bodies), cend(island.bodies), [&](const auto& bodyID) {
+                    auto& b = m_bodyBuffer[to_underlying(bodyID)];
+                    SetPosition0(b, GetPosition1(b));
+                    // XXX/TODO figure out why the following causes Gears Test to stutter!!!
+                    // SetSweep(b, GetNormalized(GetSweep(b)));
+                    // SetSweep(b, Sweep{GetNormalized(GetPosition0(b)), GetLocalCenter(b)});
+                });
             }
         }
     }
 
-#if defined(DO_THREADED)
-    for (auto&& future: futures) {
-        const auto solverResults = future.get();
-        ::playrho::Update(stats, solverResults);
+    islandTimer.Stop();
+
+    const auto islands = Span<const Island>{data(m_islands), numIslands};
+    const auto numBatches = m_taskScheduler
+        ? std::clamp(m_taskScheduler->GetConcurrency(), std::size_t{1}, std::max(numIslands, std::size_t{1}))
+        : std::size_t{1};
+    if (numBatches == 1u) {
+        const auto resources = GetIslandSolverResources(0u);
+        for (const auto& island: islands) {
+            const auto islandTrace = TraceScope{m_tracer, "SolveRegIsland"};
+            // Islands aren't being solved concurrently so each can be solved by color.
+            const auto solution = (conf.regSubSteps > 0u)
+                ? SolveRegIslandViaSoftStep(conf, island, resources)
+                : SolveRegIslandViaGS(conf, island, resources, m_taskScheduler);
+            times.velocitySolve += solution.velocityTime;
+            times.positionSolve += solution.positionTime;
+            ::playrho::Update(stats, FinishRegIsland(conf, island, solution));
+        }
+    }
+    else {
+        // Batch islands by size onto the least loaded batch, biggest islands first.
+        auto order = std::vector<std::size_t>(numIslands);
+        std::iota(begin(order), end(order), std::size_t{0});
+        const auto weight = [&islands](std::size_t i) {
+            return size(islands[i].bodies) + size(islands[i].contacts) + size(islands[i].joints);
+        };
+        std::stable_sort(begin(order), end(order), [&weight](std::size_t a, std::size_t b) {
+            return weight(a) > weight(b);
+        });
+        auto batches = std::vector<std::vector<std::size_t>>(numBatches);
+        auto loads = std::vector<std::size_t>(numBatches);
+        for (const auto& i: order) {
+            const auto batch = static_cast<std::size_t>(
+                std::distance(begin(loads), std::min_element(begin(loads), end(loads))));
+            loads[batch] += weight(i);
+            batches[batch].push_back(i);
+        }
+        auto solutions = std::vector<std::optional<RegIslandSolution>>(numIslands);
+        auto tasks = std::vector<TaskScheduler::Task>{};
+        tasks.reserve(numBatches);
+        for (auto batch = std::size_t{0}; batch < numBatches; ++batch) {
+            tasks.emplace_back([this,&conf,&islands,&solutions,&indices = batches[batch],
+                                resources = GetIslandSolverResources(batch)]{
+                for (const auto& i: indices) {
+                    const auto islandTrace = TraceScope{m_tracer, "SolveRegIsland"};
+                    solutions[i].emplace((conf.regSubSteps > 0u)
+                                         ? SolveRegIslandViaSoftStep(conf, islands[i], resources)
+                                         : SolveRegIslandViaGS(conf, islands[i], resources));
+                }
+            });
+        }
+        m_taskScheduler->Run(tasks);
+        // Write back in island order to get the same results as solving serially.
+        for (auto i = std::size_t{0}; i < numIslands; ++i) {
+            times.velocitySolve += solutions[i]->velocityTime;
+            times.positionSolve += solutions[i]->positionTime;
+            ::playrho::Update(stats, FinishRegIsland(conf, islands[i], *solutions[i]));
+        }
     }
-#endif
 
-    for (const auto& bodyId: m_bodies) {
-        if (m_islanded.bodies[to_underlying(bodyId)]) {
-            // A non-static body that was in an island may have moved.
-            const auto& body = m_bodyBuffer[to_underlying(bodyId)];
-            if (IsSpeedable(body)) {
-                // Update fixtures (for broad-phase).
-                stats.proxiesMoved += Synchronize(m_bodyProxies[to_underlying(bodyId)],
-                                                  GetTransform0(GetSweep(body)),
-                                                  GetTransformation(body),
-                                                  conf);
+    {
+        const auto timer = PhaseTimer{GetTimed(conf, times.proxySync)};
+        for (const auto& bodyId: m_bodies) {
+            if (m_islanded.bodies[to_underlying(bodyId)]) {
+                // A non-static body that was in an island may have moved.
+                const auto& body = m_bodyBuffer[to_underlying(bodyId)];
+                if (IsSpeedable(body)) {
+                    // Update fixtures (for broad-phase).
+                    stats.proxiesMoved += Synchronize(m_bodyProxies[to_underlying(bodyId)],
+                                                      GetTransform0(GetSweep(body)),
+                                                      GetTransformation(body),
+                                                      conf);
+                }
             }
         }
     }
@@ -1547,68 +2314,145 @@ RegStepStats AabbTreeWorld::SolveReg(const StepConf& conf)
     ResizeAndReset(m_islanded.contacts, size(m_contactBuffer), false);
     ResizeAndReset(m_islanded.joints, size(m_jointBuffer), false);
 
-    const auto updateStats = UpdateContacts(conf);
-    stats.contactsUpdated += updateStats.updated;
-    stats.contactsSkipped += updateStats.skipped;
+    {
+        const auto timer = PhaseTimer{GetTimed(conf, times.contactUpdate)};
+        const auto updateStats = UpdateContacts(conf);
+        stats.contactsUpdated += updateStats.updated;
+        stats.contactsSkipped += updateStats.skipped;
+    }
 
-    // Look for new contacts.
-    stats.contactsAdded = AddContacts(
-        FindContacts(m_proxyKeysResource, m_tree, std::exchange(m_proxiesForContacts, {})),
-        conf);
+    {
+        // Look for new contacts.
+        const auto timer = PhaseTimer{GetTimed(conf, times.pairFinding)};
+        const auto proxies = std::exchange(m_proxiesForContacts, {});
+        stats.contactsAdded = AddContacts(
+            FindContacts(GetStepResource(m_proxyKeysResource), m_tree, GetWideTree(size(proxies)),
+                         proxies, m_taskScheduler, m_tracer),
+            conf);
+    }
 
     assert(!NeedsUpdating(m_contactBuffer));
     return stats;
 }
 
-IslandStats AabbTreeWorld::SolveRegIslandViaGS(const StepConf& conf, const Island& island)
+const WideDynamicTree* AabbTreeWorld::GetWideTree(std::size_t numProxies)
+{
+    if ((numProxies * WideTreeLeavesPerProxy) < m_tree.GetLeafCount()) {
+        return nullptr;
+    }
+    const auto modifications = m_tree.GetModificationCount();
+    if (m_wideTreeModifications != modifications) {
+        m_wideTreeModifications.reset();
+        m_wideTree.Rebuild(m_tree);
+        m_wideTreeModifications = modifications;
+    }
+    return &m_wideTree;
+}
+
+AabbTreeWorld::IslandSolverResources AabbTreeWorld::GetIslandSolverResources(std::size_t batch)
+{
+    if (batch == 0u) {
+        return {&GetStepResource(m_bodyConstraintsResource),
+            &GetStepResource(m_positionConstraintsResource),
+            &GetStepResource(m_velocityConstraintsResource), m_bodyConstraintIndices};
+    }
+    if (size(m_islandBatchResources) < batch) {
+        m_islandBatchResources.resize(batch);
+    }
+    auto& resources = m_islandBatchResources[batch - 1u];
+    if (!resources) {
+        // Bypasses the stats resource which isn't thread-safe.
+        const auto upstream = m_statsResource.upstream_resource()
+            ? m_statsResource.upstream_resource(): m_bodyConstraintsResource.GetUpstream();
+        resources.reset(new IslandBatchResources{
+            {m_bodyConstraintsResource.GetOptions(), upstream},
+            {m_positionConstraintsResource.GetOptions(), upstream},
+            {m_velocityConstraintsResource.GetOptions(), upstream},
+            {}
+        });
+    }
+    resources->bodyConstraintIndices.resize(size(m_bodyBuffer), InvalidBodyID);
+    return {&resources->bodyConstraints, &resources->positionConstraints,
+        &resources->velocityConstraints, resources->bodyConstraintIndices};
+}
+
+AabbTreeWorld::RegIslandSolution
+AabbTreeWorld::SolveRegIslandViaGS(const StepConf& conf, const Island& island,
+                                   const IslandSolverResources& resources,
+                                   TaskScheduler* scheduler)
 {
     assert(!empty(island.bodies) || !empty(island.contacts) || !empty(island.joints));
     assert(IsStepComplete(*this));
     assert(IsLocked(*this));
 
+    auto velocityTime = StepTimes::duration{};
+    auto positionTime = StepTimes::duration{};
+    auto velocityTimer = PhaseTimer{GetTimed(conf, velocityTime)};
+
     auto results = IslandStats{};
     results.positionIters = conf.regPositionIters;
     const auto h = conf.deltaTime; ///< Time step.
-
-    // Update bodies' pos0 values.
-    for_each(cbegin(island.bodies), cend(island.bodies), [&](const auto& bodyID) {
-        auto& body = m_bodyBuffer[to_underlying(bodyID)];
-        SetPosition0(body, GetPosition1(body));
-        // XXX/TODO figure out why the following causes Gears Test to stutter!!!
-        // SetSweep(body, GetNormalized(GetSweep(body)));
-        // SetSweep(body, Sweep{GetNormalized(GetPosition0(body)), GetLocalCenter(body)});
-    });
+    const auto& indices = resources.bodyConstraintIndices;
 
     // Copy bodies' pos1 and velocity data into local arrays.
-    auto bodyConstraints = GetBodyConstraints(m_bodyConstraintsResource,
-                                              island.bodies, m_bodyBuffer, h, GetMovementConf(conf));
-    auto posConstraints = GetPositionConstraints(m_positionConstraintsResource, island.contacts,
-                                                 m_contactBuffer, m_manifoldBuffer, m_shapeBuffer);
-    auto velConstraints = GetVelocityConstraints(m_velocityConstraintsResource, island.contacts,
-                                                 m_contactBuffer, m_manifoldBuffer, m_shapeBuffer,
-                                                 bodyConstraints,
+    auto bodyConstraints = GetBodyConstraints(*resources.bodyConstraints,
+                                              island.bodies, m_bodyBuffer, h, GetMovementConf(conf),
+                                              indices);
+    auto posConstraints = GetPositionConstraints(*resources.positionConstraints, island.contacts,
+                                                 m_contactBuffer, m_manifoldBuffer, m_shapeChildren,
+                                                 indices);
+    auto velConstraints = GetVelocityConstraints(*resources.velocityConstraints, island.contacts,
+                                                 m_contactBuffer, m_manifoldBuffer, m_shapeChildren,
+                                                 bodyConstraints, indices,
                                                  GetRegVelocityConstraintConf(conf));
+    const auto bodyConstraintsMap = BodyConstraintsMap{bodyConstraints, indices};
     if (conf.doWarmStart) {
         WarmStartVelocities(velConstraints, bodyConstraints);
     }
 
     const auto psConf = GetRegConstraintSolverConf(conf);
 
-    for_each(cbegin(island.joints), cend(island.joints), [&](const auto& id) {
-        auto& joint = m_jointBuffer[to_underlying(id)];
-        InitVelocity(joint, bodyConstraints, conf, psConf);
-    });
+    auto colored = std::optional<ColoredIslandSolver>{};
+    if (scheduler && conf.doColoredIslandSolve) {
+        colored.emplace(*scheduler, island.joints, m_jointBuffer, velConstraints,
+                        bodyConstraints, indices);
+    }
+    const auto doWideVelocitySolve = conf.doWideVelocitySolve && !colored;
+
+    auto joints = BuiltinJointBatches{*resources.bodyConstraints};
+    if (colored) {
+        colored->InitJointVelocities(bodyConstraintsMap, conf, psConf);
+    }
+    else {
+        Append(joints, island.joints, m_jointBuffer, conf.doJointBatching);
+        ForEachJoint(joints, [&](auto& joint) {
+            InitVelocity(joint, bodyConstraintsMap, conf, psConf);
+        });
+    }
+
+    auto wideVelConstraints = WideVelocityConstraints{};
+    if (doWideVelocitySolve) {
+        wideVelConstraints.Assign(velConstraints, bodyConstraints);
+    }
 
     results.velocityIters = conf.regVelocityIters;
     for (auto i = decltype(conf.regVelocityIters){0}; i < conf.regVelocityIters; ++i) {
         auto jointsOkay = true;
-        for_each(cbegin(island.joints), cend(island.joints), [&](const auto& id) {
-            auto& joint = m_jointBuffer[to_underlying(id)];
-            jointsOkay &= SolveVelocity(joint, bodyConstraints, conf);
-        });
+        if (colored) {
+            jointsOkay = colored->SolveJointVelocities(bodyConstraintsMap, conf);
+        }
+        else {
+            ForEachJoint(joints, [&](auto& joint) {
+                jointsOkay &= SolveVelocity(joint, bodyConstraintsMap, conf);
+            });
+        }
         // Note that the new incremental impulse can potentially be orders of magnitude
         // greater than the last incremental impulse used in this loop.
-        const auto newIncImpulse = SolveVelocityConstraintsViaGS(velConstraints, bodyConstraints);
+        const auto newIncImpulse = colored
+            ? colored->SolveContactVelocities(velConstraints, bodyConstraints)
+            : doWideVelocitySolve
+            ? wideVelConstraints.Solve(bodyConstraints)
+            : SolveVelocityConstraintsViaGS(velConstraints, bodyConstraints);
         results.maxIncImpulse = std::max(results.maxIncImpulse, newIncImpulse);
         if (jointsOkay && (newIncImpulse <= conf.regMinMomentum)) {
             // No joint related velocity constraints were out of tolerance.
@@ -1620,21 +2464,32 @@ IslandStats AabbTreeWorld::SolveRegIslandViaGS(const StepConf& conf, const Islan
             break;
         }
     }
+    if (doWideVelocitySolve) {
+        wideVelConstraints.Store(velConstraints);
+    }
+    velocityTimer.Stop();
+
+    auto positionTimer = PhaseTimer{GetTimed(conf, positionTime)};
 
     // updates array of tentative new body positions per the velocities as if there were no obstacles...
-    IntegratePositions(island.bodies, bodyConstraints, h);
+    IntegratePositions(bodyConstraints, h);
 
     // Solve position constraints
     for (auto i = decltype(conf.regPositionIters){0}; i < conf.regPositionIters; ++i) {
-        const auto minSeparation = SolvePositionConstraintsViaGS(posConstraints, bodyConstraints,
-                                                                 psConf);
+        const auto minSeparation = colored
+            ? colored->SolveContactPositions(posConstraints, bodyConstraints, psConf)
+            : SolvePositionConstraintsViaGS(posConstraints, bodyConstraints, psConf);
         results.minSeparation = std::min(results.minSeparation, minSeparation);
         const auto contactsOkay = (minSeparation >= conf.regMinSeparation);
         auto jointsOkay = true;
-        for_each(cbegin(island.joints), cend(island.joints), [&](const auto& id) {
-            auto& joint = m_jointBuffer[to_underlying(id)];
-            jointsOkay &= SolvePosition(joint, bodyConstraints, psConf);
-        });
+        if (colored) {
+            jointsOkay = colored->SolveJointPositions(bodyConstraintsMap, psConf);
+        }
+        else {
+            ForEachJoint(joints, [&](const auto& joint) {
+                jointsOkay &= SolvePosition(joint, bodyConstraintsMap, psConf);
+            });
+        }
         if (contactsOkay && jointsOkay) {
             // Reached tolerance, early out...
             results.positionIters = i + 1;
@@ -1642,6 +2497,151 @@ IslandStats AabbTreeWorld::SolveRegIslandViaGS(const StepConf& conf, const Islan
             break;
         }
     }
+    positionTimer.Stop();
+
+    ResetIndices(indices, island.bodies);
+    return RegIslandSolution{std::move(bodyConstraints), std::move(velConstraints), results,
+        velocityTime, positionTime};
+}
+
+AabbTreeWorld::RegIslandSolution
+AabbTreeWorld::SolveRegIslandViaSoftStep(const StepConf& conf, const Island& island,
+                                         const IslandSolverResources& resources)
+{
+    assert(conf.regSubSteps > 0u);
+    assert(!empty(island.bodies) || !empty(island.contacts) || !empty(island.joints));
+    assert(IsStepComplete(*this));
+    assert(IsLocked(*this));
+
+    // Without a separate position pass, all of this is timed as velocity solving.
+    auto velocityTime = StepTimes::duration{};
+    auto velocityTimer = PhaseTimer{GetTimed(conf, velocityTime)};
+
+    auto results = IslandStats{};
+    const auto h = conf.deltaTime; ///< Time step.
+    const auto subSteps = conf.regSubSteps;
+    const auto& indices = resources.bodyConstraintIndices;
+
+    auto bodyConstraints = GetBodyConstraints(*resources.bodyConstraints,
+                                              island.bodies, m_bodyBuffer, h, GetMovementConf(conf),
+                                              indices);
+    const auto posConstraints = GetPositionConstraints(*resources.positionConstraints,
+                                                       island.contacts, m_contactBuffer,
+                                                       m_manifoldBuffer, m_shapeChildren, indices);
+    auto velConstraints = GetVelocityConstraints(*resources.velocityConstraints, island.contacts,
+                                                 m_contactBuffer, m_manifoldBuffer, m_shapeChildren,
+                                                 bodyConstraints, indices,
+                                                 GetRegVelocityConstraintConf(conf));
+    const auto bodyConstraintsMap = BodyConstraintsMap{bodyConstraints, indices};
+
+    // Body constraints start out with velocities accelerated for the whole step. Spread that
+    // acceleration over the sub-steps instead.
+    auto velocityDeltas = std::vector<Velocity, pmr::polymorphic_allocator<Velocity>>{
+        resources.bodyConstraints};
+    velocityDeltas.reserve(size(bodyConstraints));
+    for (auto i = BodyConstraints::size_type{0}; i < size(bodyConstraints); ++i) {
+        auto& bc = bodyConstraints[i];
+        const auto velocity = GetVelocity(m_bodyBuffer[to_underlying(island.bodies[i])]);
+        velocityDeltas.push_back((bc.GetVelocity() - velocity) / Real(subSteps));
+        bc.SetVelocity(velocity);
+    }
+
+    auto joints = BuiltinJointBatches{*resources.bodyConstraints};
+    Append(joints, island.joints, m_jointBuffer, conf.doJointBatching);
+
+    const auto psConf = GetRegConstraintSolverConf(conf);
+    auto subConf = conf;
+    subConf.deltaTime = h / Real(subSteps);
+    const auto frequency = std::min(conf.softContactFrequency,
+                                    Real(0.25f) * Real(subSteps) / h);
+    auto contactConf = SoftStep::SoftContactConf{
+        SoftStep::GetSoftness(frequency, conf.softContactDampingRatio, subConf.deltaTime),
+        subConf.deltaTime, conf.linearSlop, conf.softContactPushSpeed, true
+    };
+
+    auto jointsOkay = true;
+    for (auto subStep = decltype(subSteps){0}; subStep < subSteps; ++subStep) {
+        for (auto i = BodyConstraints::size_type{0}; i < size(bodyConstraints); ++i) {
+            auto& bc = bodyConstraints[i];
+            bc.SetVelocity(bc.GetVelocity() + velocityDeltas[i]);
+        }
+
+        // Sub-steps after the first are all of the same duration. Whether they're warm
+        // started is still up to the caller.
+        if (subStep > 0u) {
+            subConf.dtRatio = 1;
+        }
+        if (subConf.doWarmStart) {
+            WarmStartVelocities(velConstraints, bodyConstraints);
+        }
+        else if (subStep > 0u) {
+            // Impulses weren't applied at the start of this sub-step so they mustn't be
+            // accumulated on top of either.
+            for (auto& vc: velConstraints) {
+                for (auto j = VelocityConstraint::size_type{0}; j < vc.GetPointCount(); ++j) {
+                    SetNormalImpulseAtPoint(vc, j, 0_Ns);
+                    SetTangentImpulseAtPoint(vc, j, 0_Ns);
+                }
+            }
+        }
+        ForEachJoint(joints, [&](auto& joint) {
+            InitVelocity(joint, bodyConstraintsMap, subConf, psConf);
+        });
+
+        contactConf.usePush = true;
+        ForEachJoint(joints, [&](auto& joint) {
+            SolveVelocity(joint, bodyConstraintsMap, subConf);
+        });
+        for (auto i = VelocityConstraints::size_type{0}; i < size(velConstraints); ++i) {
+            const auto incImpulse = SoftStep::SolveVelocityConstraint(velConstraints[i],
+                                                                      posConstraints[i],
+                                                                      bodyConstraints,
+                                                                      contactConf);
+            results.maxIncImpulse = std::max(results.maxIncImpulse, incImpulse);
+        }
+
+        IntegratePositions(bodyConstraints, subConf.deltaTime);
+
+        jointsOkay = true;
+        ForEachJoint(joints, [&](const auto& joint) {
+            jointsOkay &= SolvePosition(joint, bodyConstraintsMap, psConf);
+        });
+
+        // Relax away the velocity that pushing overlapping shapes apart added.
+        contactConf.usePush = false;
+        ForEachJoint(joints, [&](auto& joint) {
+            SolveVelocity(joint, bodyConstraintsMap, subConf);
+        });
+        for (auto i = VelocityConstraints::size_type{0}; i < size(velConstraints); ++i) {
+            SoftStep::SolveVelocityConstraint(velConstraints[i], posConstraints[i],
+                                              bodyConstraints, contactConf);
+        }
+    }
+
+    for (auto& vc: velConstraints) {
+        results.maxIncImpulse = std::max(results.maxIncImpulse,
+                                         SoftStep::ApplyRestitution(vc, bodyConstraints));
+    }
+    for (const auto& pc: posConstraints) {
+        results.minSeparation = std::min(results.minSeparation,
+                                         SoftStep::GetMinSeparation(pc, bodyConstraints));
+    }
+
+    results.velocityIters = subSteps;
+    results.positionIters = subSteps;
+    results.solved = jointsOkay && (results.minSeparation >= conf.regMinSeparation);
+    velocityTimer.Stop();
+    ResetIndices(indices, island.bodies);
+    return RegIslandSolution{std::move(bodyConstraints), std::move(velConstraints), results,
+        velocityTime};
+}
+
+IslandStats AabbTreeWorld::FinishRegIsland(const StepConf& conf, const Island& island,
+                                           const RegIslandSolution& solution)
+{
+    auto results = solution.stats;
+    const auto& bodyConstraints = solution.bodyConstraints;
+    const auto& velConstraints = solution.velConstraints;
 
     // Update normal and tangent impulses of contacts' manifold points
     for_each(cbegin(velConstraints), cend(velConstraints), [&](const VelocityConstraint& vc) {
@@ -1649,17 +2649,17 @@ IslandStats AabbTreeWorld::SolveRegIslandViaGS(const StepConf& conf, const Islan
         AssignImpulses(m_manifoldBuffer[to_underlying(island.contacts[i])], vc);
     });
 
-    for (const auto& id: island.bodies) {
-        const auto i = to_underlying(id);
+    for (auto i = BodyConstraints::size_type{0}; i < size(bodyConstraints); ++i) {
+        const auto id = to_underlying(island.bodies[i]);
         const auto& bc = bodyConstraints[i];
-        auto& body = m_bodyBuffer[i];
+        auto& body = m_bodyBuffer[id];
         // Could normalize position here to avoid unbounded angles but angular
         // normalization isn't handled correctly by joints that constrain rotation.
         body.JustSetVelocity(bc.GetVelocity());
         // XXX/TODO figure out why calling GetNormalized here causes Gears Test to stutter!!!
         if (const auto pos = /*GetNormalized*/(bc.GetPosition()); GetPosition1(body) != pos) {
             SetPosition1(body, pos);
-            FlagForUpdating(m_contactBuffer, m_bodyContacts[i]);
+            FlagForUpdating(m_contactBuffer, m_bodyContacts[id]);
         }
     }
 
@@ -1672,9 +2672,19 @@ IslandStats AabbTreeWorld::SolveRegIslandViaGS(const StepConf& conf, const Islan
         Report(m_listeners.postSolveContact, island.contacts, velConstraints,
                results.solved? results.positionIters - 1: StepConf::InvalidIteration);
     }
+    if (m_contactEvents) {
+        Record(m_contactEvents->postSolves, island.contacts, velConstraints,
+               results.solved? results.positionIters - 1: StepConf::InvalidIteration,
+               m_contactBuffer);
+    }
 
     const auto minUnderActiveTime = UpdateUnderActiveTimes(island.bodies, m_bodyBuffer, conf);
     if ((minUnderActiveTime >= conf.minStillTimeToSleep) && results.solved) {
+        // Splitting is deferred till now so sets only get re-partitioned when they're still.
+        // Then only the actual island of a body gets woken up along with it.
+        if (const auto seedID = island.bodies.front(); m_islandSets.NeedsSplitting(seedID)) {
+            SplitIsland(seedID);
+        }
         results.bodiesSlept = Sleepem(island.bodies, m_bodyBuffer);
     }
 
@@ -1682,13 +2692,13 @@ IslandStats AabbTreeWorld::SolveRegIslandViaGS(const StepConf& conf, const Islan
 }
 
 AabbTreeWorld::UpdateContactsData
-AabbTreeWorld::UpdateContactTOIs(const StepConf& conf)
+AabbTreeWorld::UpdateContactTOIs(const Span<const ContactID>& contacts, const StepConf& conf)
 {
     auto results = UpdateContactsData{};
 
     const auto toiConf = GetToiConf(conf);
-    for (const auto& contact: m_contacts) {
-        auto& c = m_contactBuffer[to_underlying(std::get<ContactID>(contact))];
+    for (const auto& contactID: contacts) {
+        auto& c = m_contactBuffer[to_underlying(contactID)];
         if (HasValidToi(c)) {
             ++results.numValidTOI;
             continue;
@@ -1724,8 +2734,8 @@ AabbTreeWorld::UpdateContactTOIs(const StepConf& conf)
 
         // Compute the TOI for this contact (one or both bodies are awake and impenetrable).
         // Computes the time of impact in interval [0, 1]
-        const auto proxyA = GetChild(m_shapeBuffer[to_underlying(GetShapeA(c))], GetChildIndexA(c));
-        const auto proxyB = GetChild(m_shapeBuffer[to_underlying(GetShapeB(c))], GetChildIndexB(c));
+        const auto& proxyA = m_shapeChildren[to_underlying(GetShapeA(c))][GetChildIndexA(c)];
+        const auto& proxyB = m_shapeChildren[to_underlying(GetShapeB(c))][GetChildIndexB(c)];
 
         // Large rotations can make the root finder of TimeOfImpact fail, so normalize sweep angles.
         const auto sweepA = GetNormalized(GetSweep(bA));
@@ -1751,21 +2761,42 @@ AabbTreeWorld::UpdateContactTOIs(const StepConf& conf)
 
 ToiStepStats AabbTreeWorld::SolveToi(const StepConf& conf)
 {
+    const auto trace = TraceScope{m_tracer, "SolveToi"};
     assert(IsLocked(*this));
 
     auto stats = ToiStepStats{};
     const auto subStepping = GetSubStepping(*this);
+    m_bodyConstraintIndices.resize(size(m_bodyBuffer), InvalidBodyID);
+
+    // Contacts only get appended to m_contacts while solving TOIs, so their positions in it
+    // stay the same throughout. These positions are what keep contacts getting gone through,
+    // and TOI events getting picked, in the same order as if all the contacts were gone
+    // through every time.
+    auto positions = std::vector<KeyedContactIDs::size_type>(size(m_contactBuffer));
+    auto contactIDs = std::vector<ContactID>{};
+    contactIDs.reserve(size(m_contacts));
+    for (auto i = KeyedContactIDs::size_type{0}; i < size(m_contacts); ++i) {
+        const auto contactID = std::get<ContactID>(m_contacts[i]);
+        positions[to_underlying(contactID)] = i;
+        contactIDs.push_back(contactID);
+    }
+    auto events = ToiEventQueue{};
+
+    // One island gets reused for every event, so it only ever takes as much memory as the
+    // biggest island. It's not from the step arena which would hold onto every event's memory.
+    auto island = Island{m_islandResource, m_islandResource, m_islandResource};
 
     // Find TOI events and solve them.
     for (;;) {
-        const auto updateData = UpdateContactTOIs(conf);
+        const auto updateData = UpdateContactTOIs(contactIDs, conf);
         stats.contactsAtMaxSubSteps += updateData.numAtMaxSubSteps;
         stats.contactsUpdatedToi += updateData.numUpdatedTOI;
         stats.maxDistIters = std::max(stats.maxDistIters, updateData.maxDistIters);
         stats.maxRootIters = std::max(stats.maxRootIters, updateData.maxRootIters);
         stats.maxToiIters = std::max(stats.maxToiIters, updateData.maxToiIters);
+        PushToiEvents(events, contactIDs, positions, m_contactBuffer);
 
-        const auto next = GetSoonestContact(m_contacts, m_contactBuffer);
+        const auto next = PopSoonestContact(events, m_contacts, m_contactBuffer);
         if (next == InvalidContactID) {
             // No more TOI events to handle within the current time step. Done!
             m_flags |= e_stepComplete;
@@ -1778,8 +2809,9 @@ ToiStepStats AabbTreeWorld::SolveToi(const StepConf& conf)
 
         ++stats.contactsFound;
         auto islandsFound = 0u;
+        Clear(island);
         if (!m_islanded.contacts[to_underlying(next)]) {
-            const auto solverResults = SolveToi(next, conf);
+            const auto solverResults = SolveToi(next, island, conf);
             stats.minSeparation = std::min(stats.minSeparation, solverResults.minSeparation);
             stats.maxIncImpulse = std::max(stats.maxIncImpulse, solverResults.maxIncImpulse);
             stats.islandsSolved += solverResults.solved;
@@ -1793,8 +2825,13 @@ ToiStepStats AabbTreeWorld::SolveToi(const StepConf& conf)
         }
         stats.islandsFound += islandsFound;
 
+        // The only TOIs that can have changed now are those of the contact just solved for,
+        // those of the moved bodies' contacts, and those of any contacts that get added.
+        contactIDs.clear();
+        contactIDs.push_back(next);
+
         // Reset island flags and synchronize broad-phase proxies.
-        for (const auto& bodyId: m_bodies) {
+        for (const auto& bodyId: island.bodies) {
             if (m_islanded.bodies[to_underlying(bodyId)]) {
                 m_islanded.bodies[to_underlying(bodyId)] = false;
                 const auto& body = m_bodyBuffer[to_underlying(bodyId)];
@@ -1806,20 +2843,37 @@ ToiStepStats AabbTreeWorld::SolveToi(const StepConf& conf)
                     const auto& bodyContacts = m_bodyContacts[to_underlying(bodyId)];
                     ResetBodyContactsForSolveTOI(m_contactBuffer, bodyContacts);
                     Unset(m_islanded.contacts, bodyContacts);
+                    for (const auto& bodyContact: bodyContacts) {
+                        contactIDs.push_back(std::get<ContactID>(bodyContact));
+                    }
                 }
             }
         }
 
         // Commit fixture proxy movements to the broad-phase so that new contacts are created.
         // Also, some contacts can be destroyed.
+        const auto numContactsBefore = size(m_contacts);
+        const auto proxies = std::exchange(m_proxiesForContacts, {});
         stats.contactsAdded += AddContacts(
-            FindContacts(m_proxyKeysResource, m_tree, std::exchange(m_proxiesForContacts, {})),
+            FindContacts(GetStepResource(m_proxyKeysResource), m_tree, GetWideTree(size(proxies)),
+                         proxies, m_taskScheduler, m_tracer),
             conf);
+        positions.resize(size(m_contactBuffer));
+        for (auto i = numContactsBefore; i < size(m_contacts); ++i) {
+            const auto contactID = std::get<ContactID>(m_contacts[i]);
+            positions[to_underlying(contactID)] = i;
+            contactIDs.push_back(contactID);
+        }
 
         if (subStepping) {
             m_flags &= ~e_stepComplete;
             break;
         }
+
+        sort(begin(contactIDs), end(contactIDs), [&positions](ContactID a, ContactID b) {
+            return positions[to_underlying(a)] < positions[to_underlying(b)];
+        });
+        contactIDs.erase(unique(begin(contactIDs), end(contactIDs)), end(contactIDs));
     }
 
     const auto updateStats = UpdateContacts(conf);
@@ -1830,9 +2884,10 @@ ToiStepStats AabbTreeWorld::SolveToi(const StepConf& conf)
     return stats;
 }
 
-IslandStats AabbTreeWorld::SolveToi(ContactID contactID, const StepConf& conf)
+IslandStats AabbTreeWorld::SolveToi(ContactID contactID, Island& island, const StepConf& conf)
 {
     assert(IsLocked(*this));
+    const auto trace = TraceScope{m_tracer, "SolveToiIsland"};
 
     // Note:
     //   This function is what used to be b2World::SolveToi(const b2TimeStep& step).
@@ -1914,10 +2969,6 @@ IslandStats AabbTreeWorld::SolveToi(ContactID contactID, const StepConf& conf)
     }
 
     // Build the island
-    Island island{m_islandResource, m_islandResource, m_islandResource};
-    island.bodies.reserve(size(m_bodies));
-    island.contacts.reserve(used(m_contactBuffer));
-
      // These asserts get triggered sometimes if contacts within TOI are iterated over.
     assert(!m_islanded.bodies[to_underlying(bodyIdA)]);
     assert(!m_islanded.bodies[to_underlying(bodyIdB)]);
@@ -1967,12 +3018,15 @@ IslandStats AabbTreeWorld::SolveToiViaGS(const Island& island, const StepConf& c
      * the body constraint doesn't need to pass an elapsed time (and doesn't need to
      * update the velocity from what it already is).
      */
+    // Constraints are taken from the pool resources rather than from the step arena so
+    // that the memory of one event's constraints gets reused by the next event's.
     auto bodyConstraints = GetBodyConstraints(m_bodyConstraintsResource,
-                                              island.bodies, m_bodyBuffer, 0_s, GetMovementConf(conf));
+                                              island.bodies, m_bodyBuffer, 0_s, GetMovementConf(conf),
+                                              m_bodyConstraintIndices);
 
     // Initialize the body state.
     auto posConstraints = GetPositionConstraints(m_positionConstraintsResource, island.contacts, m_contactBuffer,
-                                                 m_manifoldBuffer, m_shapeBuffer);
+                                                 m_manifoldBuffer, m_shapeChildren, m_bodyConstraintIndices);
 
     // Solve TOI-based position constraints.
     assert(results.minSeparation == std::numeric_limits<Length>::infinity());
@@ -2007,15 +3061,15 @@ IslandStats AabbTreeWorld::SolveToiViaGS(const Island& island, const StepConf& c
     // Not doing this results in slower simulations.
     // Originally this update was only done to island.bodies 0 and 1.
     // Unclear whether rest of bodies should also be updated. No difference noticed.
-    for (const auto& id: island.bodies) {
-        const auto& bc = bodyConstraints[to_underlying(id)];
-        SetPosition0(m_bodyBuffer[to_underlying(id)], bc.GetPosition());
+    for (auto i = BodyConstraints::size_type{0}; i < size(bodyConstraints); ++i) {
+        SetPosition0(m_bodyBuffer[to_underlying(island.bodies[i])], bodyConstraints[i].GetPosition());
     }
 
     auto velConstraints = GetVelocityConstraints(m_velocityConstraintsResource, island.contacts,
-                                                 m_contactBuffer, m_manifoldBuffer, m_shapeBuffer,
-                                                 bodyConstraints,
+                                                 m_contactBuffer, m_manifoldBuffer, m_shapeChildren,
+                                                 bodyConstraints, m_bodyConstraintIndices,
                                                  GetToiVelocityConstraintConf(conf));
+    ResetIndices(m_bodyConstraintIndices, island.bodies);
 
     // No warm starting is needed for TOI events because warm
     // starting impulses were applied in the discrete solver.
@@ -2038,21 +3092,25 @@ IslandStats AabbTreeWorld::SolveToiViaGS(const Island& island, const StepConf& c
 
     // Don't store TOI contact forces for warm starting because they can be quite large.
 
-    IntegratePositions(island.bodies, bodyConstraints, conf.deltaTime);
-    for (const auto& id: island.bodies) {
-        const auto i = to_underlying(id);
-        auto& body = m_bodyBuffer[i];
-        auto& bc = bodyConstraints[i];
+    IntegratePositions(bodyConstraints, conf.deltaTime);
+    for (auto i = BodyConstraints::size_type{0}; i < size(bodyConstraints); ++i) {
+        const auto id = to_underlying(island.bodies[i]);
+        auto& body = m_bodyBuffer[id];
+        const auto& bc = bodyConstraints[i];
         body.JustSetVelocity(bc.GetVelocity());
         if (const auto pos = bc.GetPosition(); GetPosition1(body) != pos) {
             SetPosition1(body, pos);
-            FlagForUpdating(m_contactBuffer, m_bodyContacts[i]);
+            FlagForUpdating(m_contactBuffer, m_bodyContacts[id]);
         }
     }
 
     if (m_listeners.postSolveContact) {
         Report(m_listeners.postSolveContact, island.contacts, velConstraints, results.positionIters);
     }
+    if (m_contactEvents) {
+        Record(m_contactEvents->postSolves, island.contacts, velConstraints, results.positionIters,
+               m_contactBuffer);
+    }
 
     return results;
 }
@@ -2152,22 +3210,58 @@ StepStats Step(AabbTreeWorld& world, const StepConf& conf)
 
     // "Named return value optimization" (NRVO) will make returning this more efficient.
     auto stepStats = StepStats{};
+    // Nothing allocated from the step arena is in use anymore once the following block's done.
+    auto arenaReleaser = StepArenaReleaser{world.m_stepArena.get()};
     {
+        const auto trace = TraceScope{world.m_tracer, "Step"};
         const FlagGuard<decltype(world.m_flags)> flagGaurd(world.m_flags, AabbTreeWorld::e_locked);
 
+        if (world.m_contactEvents) {
+            // Erase the events the last step left for the caller. Keeps any recorded since
+            // then, like end events from destroying bodies, so they don't get lost unread.
+            auto& events = *world.m_contactEvents;
+            const auto& counts = world.m_stepContactEventCounts;
+            EraseFront(events.begins, counts.begins);
+            EraseFront(events.ends, counts.ends);
+            EraseFront(events.preSolves, counts.preSolves);
+            EraseFront(events.postSolves, counts.postSolves);
+        }
+
+        auto& times = stepStats.times;
+
         // Create proxies herein for access to StepConf info!
-        for (const auto& [bodyID, shapeID]: world.m_fixturesForProxies) {
-            const auto &body = world.m_bodyBuffer[to_underlying(bodyID)];
-            const auto xfm0 = GetTransform0(GetSweep(body));
-            const auto xfm1 = GetTransformation(body);
-            stepStats.pre.proxiesCreated +=
-                CreateProxies(world.m_tree, bodyID, shapeID, world.m_shapeBuffer[to_underlying(shapeID)],
-                              xfm0, xfm1, conf,
-                              world.m_bodyProxies[to_underlying(bodyID)], world.m_proxiesForContacts);
+        // Creates them all at once so lots of new ones (like on loading a level) get
+        // bulk loaded into the tree instead of being inserted one at a time. Proxies of
+        // static bodies go into the tree's static partition.
+        if (!empty(world.m_fixturesForProxies)) {
+            const auto timer = PhaseTimer{GetTimed(conf, times.proxyCreation)};
+            auto aabbs = std::array<std::vector<AABB>, 2u>{};
+            auto leafData = std::array<std::vector<Contactable>, 2u>{};
+            for (const auto& [bodyID, shapeID]: world.m_fixturesForProxies) {
+                const auto &body = world.m_bodyBuffer[to_underlying(bodyID)];
+                const auto xfm0 = GetTransform0(GetSweep(body));
+                const auto xfm1 = GetTransformation(body);
+                const auto i = to_underlying(GetPartition(body));
+                stepStats.pre.proxiesCreated +=
+                    AppendLeaves(bodyID, shapeID, world.m_shapeChildren[to_underlying(shapeID)],
+                                 xfm0, xfm1, conf, aabbs[i], leafData[i]);
+            }
+            for (const auto partition: {DynamicTree::Partition::Static,
+                                        DynamicTree::Partition::Dynamic}) {
+                const auto i = to_underlying(partition);
+                auto treeIDs = std::vector<DynamicTree::Size>(size(aabbs[i]));
+                world.m_tree.CreateLeaves(aabbs[i], leafData[i], treeIDs, partition);
+                world.m_proxiesForContacts.insert(end(world.m_proxiesForContacts),
+                                                  begin(treeIDs), end(treeIDs));
+                for (auto j = decltype(size(treeIDs)){0}; j < size(treeIDs); ++j) {
+                    world.m_bodyProxies[to_underlying(leafData[i][j].bodyId)].push_back(treeIDs[j]);
+                }
+            }
         }
         world.m_fixturesForProxies = {};
 
-        stepStats.pre.proxiesMoved = [&world](const StepConf& cfg){
+        stepStats.pre.proxiesMoved = [&world,&times](const StepConf& cfg){
+            const auto timer = PhaseTimer{GetTimed(cfg, times.proxySync)};
             auto proxiesMoved = PreStepStats::counter_type{0};
             for_each(begin(world.m_bodiesForSync), end(world.m_bodiesForSync),
                      [&world,&cfg,&proxiesMoved](const auto& bodyID) {
@@ -2183,22 +3277,30 @@ StepStats Step(AabbTreeWorld& world, const StepConf& conf)
 
         {
             // Note: this may update bodies (in addition to the contacts container).
+            const auto timer = PhaseTimer{GetTimed(conf, times.contactDestroy)};
             const auto destroyStats = world.DestroyContacts(world.m_contacts);
             stepStats.pre.contactsDestroyed = destroyStats.overlap + destroyStats.filter;
         }
 
         {
             // Could potentially run UpdateContacts multithreaded over split lists...
+            const auto timer = PhaseTimer{GetTimed(conf, times.contactUpdate)};
             const auto updateStats = world.UpdateContacts(conf);
             stepStats.pre.contactsUpdated = updateStats.updated;
             stepStats.pre.contactsSkipped = updateStats.skipped;
         }
 
-        // For any new fixtures added: need to find and create the new contacts.
-        // Note: this may update bodies (in addition to the contacts container).
-        stepStats.pre.contactsAdded = world.AddContacts(
-            FindContacts(world.m_proxyKeysResource, world.m_tree, std::exchange(world.m_proxiesForContacts, {})),
-            conf);
+        {
+            // For any new fixtures added: need to find and create the new contacts.
+            // Note: this may update bodies (in addition to the contacts container).
+            const auto timer = PhaseTimer{GetTimed(conf, times.pairFinding)};
+            const auto proxies = std::exchange(world.m_proxiesForContacts, {});
+            stepStats.pre.contactsAdded = world.AddContacts(
+                FindContacts(world.GetStepResource(world.m_proxyKeysResource), world.m_tree,
+                             world.GetWideTree(size(proxies)), proxies,
+                             world.m_taskScheduler, world.m_tracer),
+                conf);
+        }
 
         assert(!NeedsUpdating(world.m_contactBuffer));
 
@@ -2206,15 +3308,23 @@ StepStats Step(AabbTreeWorld& world, const StepConf& conf)
             world.m_inv_dt0 = Real(1) / conf.deltaTime;
             // Integrate velocities, solve velocity constraints, and integrate positions.
             if (IsStepComplete(world)) {
-                stepStats.reg = world.SolveReg(conf);
+                stepStats.reg = world.SolveReg(conf, times);
             }
 
             // Handle TOI events.
             if (conf.doToi) {
+                const auto timer = PhaseTimer{GetTimed(conf, times.toi)};
                 stepStats.toi = world.SolveToi(conf);
             }
         }
+
+        if (world.m_contactEvents) {
+            const auto& events = *world.m_contactEvents;
+            world.m_stepContactEventCounts = {size(events.begins), size(events.ends),
+                size(events.preSolves), size(events.postSolves)};
+        }
     }
+    arenaReleaser.Release();
     return stepStats;
 }
 
@@ -2251,8 +3361,13 @@ void AabbTreeWorld::InternalDestroy(ContactID contactID, const Body* from)
         //  so call it now
         m_listeners.endContact(contactID);
     }
+    if (m_contactEvents && contact.IsTouching()) {
+        m_contactEvents->ends.push_back({contactID, contact.GetContactableA(),
+                                         contact.GetContactableB()});
+    }
     const auto bodyIdA = GetBodyA(contact);
     const auto bodyIdB = GetBodyB(contact);
+    UnlinkFromIsland(contactID);
     const auto bodyA = &m_bodyBuffer[to_underlying(bodyIdA)];
     const auto bodyB = &m_bodyBuffer[to_underlying(bodyIdB)];
     if (bodyA != from) {
@@ -2332,6 +3447,7 @@ AabbTreeWorld::DestroyContactsStats AabbTreeWorld::DestroyContacts(KeyedContactI
 
 AabbTreeWorld::UpdateContactsStats AabbTreeWorld::UpdateContacts(const StepConf& conf)
 {
+    const auto trace = TraceScope{m_tracer, "UpdateContacts"};
 #ifdef DO_PAR_UNSEQ
     atomic<ContactCounter> updated;
     atomic<ContactCounter> skipped;
@@ -2342,12 +3458,10 @@ AabbTreeWorld::UpdateContactsStats AabbTreeWorld::UpdateContacts(const StepConf&
 
     const auto updateConf = GetUpdateConf(conf);
 
-#if defined(DO_THREADED)
     std::vector<ContactID> contactsNeedingUpdate;
-    contactsNeedingUpdate.reserve(size(m_contacts));
-    std::vector<std::future<void>> futures;
-    futures.reserve(size(m_contacts));
-#endif
+    if (m_taskScheduler) {
+        contactsNeedingUpdate.reserve(size(m_contacts));
+    }
 
     // Update awake contacts.
     for_each(/*execution::par_unseq,*/ begin(m_contacts), end(m_contacts), [&](const auto& c) {
@@ -2374,14 +3488,12 @@ AabbTreeWorld::UpdateContactsStats AabbTreeWorld::UpdateContacts(const StepConf&
         //   - The "maxDistanceIters" per-step configuration state if contact IS for sensor.
         //
         if (NeedsUpdating(contact)) {
-            // The following may call listener but is otherwise thread-safe.
-#if defined(DO_THREADED)
-            contactsNeedingUpdate.push_back(contactID);
-            //futures.push_back(async(&Update, this, *contact, conf)));
-            //futures.push_back(async(launch::async, [=]{ Update(*contact, conf); }));
-#else
-            Update(contactID, updateConf);
-#endif
+            if (m_taskScheduler) {
+                contactsNeedingUpdate.push_back(contactID);
+            }
+            else {
+                Update(contactID, updateConf);
+            }
             ++updated;
         }
         else {
@@ -2389,30 +3501,28 @@ AabbTreeWorld::UpdateContactsStats AabbTreeWorld::UpdateContacts(const StepConf&
         }
     });
 
-#if defined(DO_THREADED)
-    auto numJobs = size(contactsNeedingUpdate);
-    const auto jobsPerCore = numJobs / 4;
-    for (auto i = decltype(numJobs){0}; numJobs > 0 && i < 3; ++i) {
-        futures.push_back(std::async(std::launch::async, [=]{
-            const auto offset = jobsPerCore * i;
-            for (auto j = decltype(jobsPerCore){0}; j < jobsPerCore; ++j) {
-                Update(contactsNeedingUpdate[offset + j], updateConf);
-            }
-        }));
-        numJobs -= jobsPerCore;
-    }
-    if (numJobs > 0) {
-        futures.push_back(std::async(std::launch::async, [=]{
-            const auto offset = jobsPerCore * 3;
-            for (auto j = decltype(numJobs){0}; j < numJobs; ++j) {
-                Update(contactsNeedingUpdate[offset + j], updateConf);
+    if (const auto numContacts = size(contactsNeedingUpdate); numContacts > 0u) {
+        // Only manifolds are written to concurrently. Listeners are called afterwards in the
+        // order the contacts were found in, so that they're called in the same order as when
+        // updating serially.
+        const auto needOldManifolds = m_listeners.preSolveContact || m_contactEvents;
+        auto oldManifolds = std::vector<Manifold>(needOldManifolds? numContacts: 0u);
+        auto newTouchings = std::vector<std::uint8_t>(numContacts);
+        m_taskScheduler->ParallelFor(numContacts, [&](std::size_t first, std::size_t last) {
+            const auto taskTrace = TraceScope{m_tracer, "UpdateContactsTask"};
+            for (auto i = first; i < last; ++i) {
+                const auto contactID = contactsNeedingUpdate[i];
+                if (needOldManifolds) {
+                    oldManifolds[i] = m_manifoldBuffer[to_underlying(contactID)];
+                }
+                newTouchings[i] = UpdateManifold(contactID, updateConf)? 1u: 0u;
             }
-        }));
-    }
-    for (auto&& future: futures) {
-        future.get();
+        });
+        for (auto i = decltype(numContacts){0}; i < numContacts; ++i) {
+            UpdateTouching(contactsNeedingUpdate[i], newTouchings[i] != 0u,
+                           needOldManifolds? oldManifolds[i]: Manifold{});
+        }
     }
-#endif
 
     return UpdateContactsStats{
         static_cast<ContactCounter>(updated),
@@ -2572,8 +3682,8 @@ ContactCounter AabbTreeWorld::Synchronize(const ProxyIDs& bodyProxies,
     for (auto&& e: bodyProxies) {
         const auto& node = m_tree.GetNode(e);
         const auto leafData = node.AsLeaf();
-        const auto aabb = ComputeAABB(GetChild(m_shapeBuffer[to_underlying(leafData.shapeId)],
-                                               leafData.childId), xfm0, xfm1);
+        const auto aabb = ComputeAABB(m_shapeChildren[to_underlying(leafData.shapeId)][leafData.childId],
+                                      xfm0, xfm1);
         // Note: updating leaf here is expensive, avoid when possible!
         if (!Contains(node.GetAABB(), aabb)) {
             m_tree.UpdateLeaf(e, GetDisplacedAABB(GetFattenedAABB(aabb, conf.aabbExtension), displacement));
@@ -2584,17 +3694,23 @@ ContactCounter AabbTreeWorld::Synchronize(const ProxyIDs& bodyProxies,
     return updatedCount;
 }
 
-void AabbTreeWorld::Update( // NOLINT(readability-function-cognitive-complexity)
+void AabbTreeWorld::Update(ContactID contactID, const ContactUpdateConf& conf)
+{
+    assert(IsLocked(*this));
+    const auto oldManifold = m_manifoldBuffer[to_underlying(contactID)];
+    UpdateTouching(contactID, UpdateManifold(contactID, conf), oldManifold);
+}
+
+bool AabbTreeWorld::UpdateManifold( // NOLINT(readability-function-cognitive-complexity)
     ContactID contactID, const ContactUpdateConf& conf)
 {
     assert(IsLocked(*this));
-    auto& c = m_contactBuffer[to_underlying(contactID)];
+    const auto& c = m_contactBuffer[to_underlying(contactID)];
     assert(c.NeedsUpdating());
     auto& manifold = m_manifoldBuffer[to_underlying(contactID)];
     const auto oldManifold = manifold;
 
     // Note: do not assume the fixture AABBs are overlapping or are valid.
-    const auto oldTouching = c.IsTouching();
     auto newTouching = false;
 
     const auto bodyIdA = GetBodyA(c);
@@ -2603,14 +3719,12 @@ void AabbTreeWorld::Update( // NOLINT(readability-function-cognitive-complexity)
     const auto bodyIdB = GetBodyB(c);
     const auto shapeIdB = GetShapeB(c);
     const auto indexB = GetChildIndexB(c);
-    const auto& shapeA = m_shapeBuffer[to_underlying(shapeIdA)];
-    const auto& shapeB = m_shapeBuffer[to_underlying(shapeIdB)];
     const auto& bodyA = m_bodyBuffer[to_underlying(bodyIdA)];
     const auto& bodyB = m_bodyBuffer[to_underlying(bodyIdB)];
     const auto xfA = GetTransformation(bodyA);
     const auto xfB = GetTransformation(bodyB);
-    const auto childA = GetChild(shapeA, indexA);
-    const auto childB = GetChild(shapeB, indexB);
+    const auto& childA = m_shapeChildren[to_underlying(shapeIdA)][indexA];
+    const auto& childB = m_shapeChildren[to_underlying(shapeIdB)][indexB];
 
     // NOTE: Ideally, the touching state returned by the TestOverlap function
     //   agrees 100% of the time with that returned from the CollideShapes function.
@@ -2691,32 +3805,64 @@ void AabbTreeWorld::Update( // NOLINT(readability-function-cognitive-complexity)
          * Lastly, without this code, the step-statistics show a world getting to sleep in
          * less TOI position iterations.
          */
-        if (newTouching != oldTouching) {
+        if (newTouching != c.IsTouching()) {
             bodyA.SetAwake();
             bodyB.SetAwake();
         }
 #endif
     }
 
+    return newTouching;
+}
+
+void AabbTreeWorld::UpdateTouching(ContactID contactID, bool newTouching,
+                                   const Manifold& oldManifold)
+{
+    auto& c = m_contactBuffer[to_underlying(contactID)];
+    assert(c.NeedsUpdating());
+    const auto oldTouching = c.IsTouching();
+    const auto sensor = c.IsSensor();
+
     c.UnflagForUpdating();
 
     if (!oldTouching && newTouching) {
         c.SetTouching();
+        if (!sensor) {
+            LinkToIsland(contactID);
+        }
         if (m_listeners.beginContact) {
             m_listeners.beginContact(contactID);
         }
+        if (m_contactEvents) {
+            const auto& a = c.GetContactableA();
+            const auto& b = c.GetContactableB();
+            const auto speed = GetApproachSpeed(m_manifoldBuffer[to_underlying(contactID)],
+                m_bodyBuffer[to_underlying(a.bodyId)],
+                GetVertexRadius(m_shapeChildren[to_underlying(a.shapeId)][a.childId]),
+                m_bodyBuffer[to_underlying(b.bodyId)],
+                GetVertexRadius(m_shapeChildren[to_underlying(b.shapeId)][b.childId]));
+            m_contactEvents->begins.push_back({contactID, a, b, speed});
+        }
     }
     else if (oldTouching && !newTouching) {
         c.UnsetTouching();
+        UnlinkFromIsland(contactID);
         if (m_listeners.endContact) {
             m_listeners.endContact(contactID);
         }
+        if (m_contactEvents) {
+            m_contactEvents->ends.push_back({contactID, c.GetContactableA(), c.GetContactableB()});
+        }
     }
 
     if (!sensor && newTouching) {
         if (m_listeners.preSolveContact) {
             m_listeners.preSolveContact(contactID, oldManifold);
         }
+        if (m_contactEvents) {
+            m_contactEvents->preSolves.push_back({contactID, c.GetContactableA(),
+                                                  c.GetContactableB(), oldManifold});
+        }
     }
 }
 
@@ -2791,7 +3937,134 @@ void SetBody(AabbTreeWorld& world, BodyID id, Body value)
     if (addToBodiesForSync) {
         world.m_bodiesForSync.push_back(id);
     }
+    const auto typeChanged = GetType(elem) != GetType(value);
     elem = std::move(value);
+    if (typeChanged) {
+        // Proxies of static bodies are kept in the tree's static partition.
+        for (const auto& proxy: world.m_bodyProxies[to_underlying(id)]) {
+            world.m_tree.SetPartition(proxy, GetPartition(elem));
+        }
+        // Contacts got destroyed above. Only speedable bodies are members of sets of more
+        // than themselves, so the body's set gets re-partitioned now and its joints relinked.
+        const auto& joints = world.m_bodyJoints[to_underlying(id)];
+        for (const auto& ji: joints) {
+            world.UnlinkFromIsland(std::get<JointID>(ji));
+        }
+        world.SplitIsland(id);
+        for (const auto& ji: joints) {
+            world.LinkToIsland(std::get<JointID>(ji));
+        }
+    }
+}
+
+void SetTransformation(AabbTreeWorld& world, BodyID id, const Transformation& value)
+{
+    auto& elem = AtUnlocked(world, world.m_bodyBuffer, id);
+    const auto oldValue = GetTransformation(elem);
+    SetTransformation(elem, value);
+    if (GetTransformation(elem) != oldValue) {
+        FlagForUpdating(world.m_contactBuffer, world.m_bodyContacts[to_underlying(id)]);
+        world.m_bodiesForSync.push_back(id);
+    }
+}
+
+void SetVelocity(AabbTreeWorld& world, BodyID id, const Velocity& value)
+{
+    SetVelocity(AtUnlocked(world, world.m_bodyBuffer, id), value);
+}
+
+void SetAcceleration(AabbTreeWorld& world, BodyID id, const Acceleration& value)
+{
+    SetAcceleration(AtUnlocked(world, world.m_bodyBuffer, id), value);
+}
+
+void SetAwake(AabbTreeWorld& world, BodyID id, bool value)
+{
+    auto& elem = AtUnlocked(world, world.m_bodyBuffer, id);
+    value ? SetAwake(elem) : UnsetAwake(elem);
+}
+
+void SetImpenetrable(AabbTreeWorld& world, BodyID id, bool value)
+{
+    auto& elem = AtUnlocked(world, world.m_bodyBuffer, id);
+    value ? SetImpenetrable(elem) : UnsetImpenetrable(elem);
+}
+
+void SetSleepingAllowed(AabbTreeWorld& world, BodyID id, bool value)
+{
+    SetSleepingAllowed(AtUnlocked(world, world.m_bodyBuffer, id), value);
+}
+
+void ApplyLinearImpulse(AabbTreeWorld& world, BodyID id, const Momentum2& impulse,
+                        const Length2& point)
+{
+    ApplyLinearImpulse(AtUnlocked(world, world.m_bodyBuffer, id), impulse, point);
+}
+
+void ApplyAngularImpulse(AabbTreeWorld& world, BodyID id, AngularMomentum impulse)
+{
+    ApplyAngularImpulse(AtUnlocked(world, world.m_bodyBuffer, id), impulse);
+}
+
+void GetBodyStates(const AabbTreeWorld& world, Span<const BodyID> ids,
+                   const BodyStateSpans& states)
+{
+    const auto size = ids.size();
+    ValidateStateSize(states.locations, size);
+    ValidateStateSize(states.angles, size);
+    ValidateStateSize(states.velocities, size);
+    ValidateStateSize(states.accelerations, size);
+    for (auto i = std::size_t{0}; i < size; ++i) {
+        const auto& body = GetBody(world, ids[i]);
+        if (!empty(states.locations)) {
+            states.locations[i] = GetLocation(body);
+        }
+        if (!empty(states.angles)) {
+            states.angles[i] = GetAngle(body);
+        }
+        if (!empty(states.velocities)) {
+            states.velocities[i] = GetVelocity(body);
+        }
+        if (!empty(states.accelerations)) {
+            states.accelerations[i] = GetAcceleration(body);
+        }
+    }
+}
+
+void SetBodyStates(AabbTreeWorld& world, Span<const BodyID> ids,
+                   const ConstBodyStateSpans& states)
+{
+    const auto size = ids.size();
+    ValidateStateSize(states.locations, size);
+    ValidateStateSize(states.angles, size);
+    ValidateStateSize(states.velocities, size);
+    ValidateStateSize(states.accelerations, size);
+    for (const auto& id: ids) {
+        AtUnlocked(world, world.m_bodyBuffer, id);
+    }
+    const auto setLocations = !empty(states.locations);
+    const auto setAngles = !empty(states.angles);
+    for (auto i = std::size_t{0}; i < size; ++i) {
+        const auto id = ids[i];
+        auto& body = world.m_bodyBuffer[to_underlying(id)];
+        if (setLocations || setAngles) {
+            const auto oldValue = GetTransformation(body);
+            SetTransformation(body, Transformation{
+                setLocations? states.locations[i]: oldValue.p,
+                setAngles? UnitVec::Get(states.angles[i]): oldValue.q
+            });
+            if (GetTransformation(body) != oldValue) {
+                FlagForUpdating(world.m_contactBuffer, world.m_bodyContacts[to_underlying(id)]);
+                world.m_bodiesForSync.push_back(id);
+            }
+        }
+        if (!empty(states.velocities)) {
+            SetVelocity(body, states.velocities[i]);
+        }
+        if (!empty(states.accelerations)) {
+            SetAcceleration(body, states.accelerations[i]);
+        }
+    }
 }
 
 void SetContact(AabbTreeWorld& world, ContactID id, Contact value)
@@ -2828,7 +4101,14 @@ void SetContact(AabbTreeWorld& world, ContactID id, Contact value)
     if (GetToiCount(elem) != GetToiCount(value)) {
         throw InvalidArgument("user may not change the TOI count");
     }
+    const auto oldTouching = IsTouching(elem);
     elem = value;
+    if (!oldTouching && IsTouching(elem) && !IsSensor(elem)) {
+        world.LinkToIsland(id);
+    }
+    else if (oldTouching && !IsTouching(elem)) {
+        world.UnlinkFromIsland(id);
+    }
 }
 
 void SetManifold(AabbTreeWorld& world, ContactID id, const Manifold& value)
@@ -21,9 +21,11 @@
 
 #include <algorithm>
 #include <cassert> // for assert
+#include <limits> // for std::numeric_limits
 #include <optional>
 
 #include <playrho/ConstraintSolverConf.hpp>
+#include <playrho/RealConstants.hpp>
 #include <playrho/to_underlying.hpp>
 #include <playrho/StepConf.hpp>
 
@@ -67,6 +69,16 @@ struct ImpulseChange
     UnitVec direction; ///< Direction.
 };
 
+/// @brief Sets the given body's velocity unless solving can't change it.
+/// @note Not writing to bodies like the ground, that many constraints share, is what lets
+///   constraints that don't otherwise share a body be solved concurrently.
+inline void SetVelocityIfMovable(BodyConstraint& body, const Velocity& value) noexcept
+{
+    if (IsMovable(body)) {
+        body.SetVelocity(value);
+    }
+}
+
 VelocityPair GetVelocityDelta(const VelocityConstraint& vc, const Momentum2& impulses,
                               const Span<const BodyConstraint>& bodies)
 {
@@ -104,8 +116,8 @@ Momentum BlockSolveUpdate(VelocityConstraint& vc, const Momentum2& newImpulses,
     const auto delta_v = GetVelocityDelta(vc, newImpulses - GetNormalImpulses(vc), bodies);
     const auto bodyA = &bodies[to_underlying(vc.GetBodyA())];
     const auto bodyB = &bodies[to_underlying(vc.GetBodyB())];
-    bodyA->SetVelocity(bodyA->GetVelocity() + std::get<0>(delta_v));
-    bodyB->SetVelocity(bodyB->GetVelocity() + std::get<1>(delta_v));
+    SetVelocityIfMovable(*bodyA, bodyA->GetVelocity() + std::get<0>(delta_v));
+    SetVelocityIfMovable(*bodyB, bodyB->GetVelocity() + std::get<1>(delta_v));
     SetNormalImpulses(vc, newImpulses);
     return std::max(abs(newImpulses[0]), abs(newImpulses[1]));
 }
@@ -386,8 +398,8 @@ inline Momentum SeqSolveNormalConstraint(VelocityConstraint& vc,
     }
     solverProc(0);
     
-    bodyA->SetVelocity(newVelA);
-    bodyB->SetVelocity(newVelB);
+    SetVelocityIfMovable(*bodyA, newVelA);
+    SetVelocityIfMovable(*bodyB, newVelB);
     
     return maxIncImpulse;
 }
@@ -447,8 +459,8 @@ inline Momentum SolveTangentConstraint(VelocityConstraint& vc,
     }
     solverProc(0);
 
-    bodyA->SetVelocity(newVelA);
-    bodyB->SetVelocity(newVelB);
+    SetVelocityIfMovable(*bodyA, newVelA);
+    SetVelocityIfMovable(*bodyB, newVelB);
     
     return maxIncImpulse;
 }
@@ -644,4 +656,165 @@ d2::PositionSolution SolvePositionConstraint(const d2::PositionConstraint& pc,
 
 } // namespace GaussSeidel
 
+namespace SoftStep {
+namespace {
+
+/// @brief Gets the separation of the given position constraint's manifold point at the
+///   given index for the given body transformations.
+inline Length GetSeparation(const d2::PositionConstraint& pc, d2::Manifold::size_type index,
+                            const d2::Transformation& xfA, const d2::Transformation& xfB)
+{
+    return GetPSM(pc.manifold, index, xfA, xfB).m_separation - pc.totalRadius;
+}
+
+Momentum SolveNormalConstraint(d2::VelocityConstraint& vc, const d2::PositionConstraint& pc,
+                               const Span<d2::BodyConstraint>& bodies,
+                               const SoftContactConf& conf)
+{
+    assert(vc.GetPointCount() <= pc.manifold.GetPointCount());
+
+    auto maxIncImpulse = 0_Ns;
+
+    const auto direction = vc.GetNormal();
+    const auto count = vc.GetPointCount();
+    const auto bodyA = &bodies[to_underlying(vc.GetBodyA())];
+    const auto bodyB = &bodies[to_underlying(vc.GetBodyB())];
+
+    const auto invRotInertiaA = bodyA->GetInvRotInertia();
+    const auto invMassA = bodyA->GetInvMass();
+    const auto xfA = GetTransformation(bodyA->GetPosition(), bodyA->GetLocalCenter());
+
+    const auto invRotInertiaB = bodyB->GetInvRotInertia();
+    const auto invMassB = bodyB->GetInvMass();
+    const auto xfB = GetTransformation(bodyB->GetPosition(), bodyB->GetLocalCenter());
+
+    auto newVelA = bodyA->GetVelocity();
+    auto newVelB = bodyB->GetVelocity();
+
+    const auto inverseDeltaTime = Real(1) / conf.deltaTime;
+    for (auto index = decltype(count){0}; index < count; ++index) {
+        const auto vcp = vc.GetPointAt(index);
+        const auto C = GetSeparation(pc, index, xfA, xfB) + conf.linearSlop;
+        auto bias = 0_mps;
+        auto softness = Softness{};
+        if (C > 0_m) {
+            // Shapes are apart so let them close the gap within this sub-step.
+            bias = C * inverseDeltaTime;
+        }
+        else if (conf.usePush) {
+            bias = std::max(conf.softness.biasRate * C, -conf.maxPushSpeed);
+            softness = conf.softness;
+        }
+        const auto closingVel = d2::GetContactRelVelocity(newVelA, vcp.relA, newVelB, vcp.relB);
+        const auto directionalVel = LinearVelocity{Dot(closingVel, direction)};
+        const auto oldImpulse = vcp.normalImpulse;
+        const auto lambda = -vcp.normalMass * softness.massScale * (directionalVel + bias)
+            - softness.impulseScale * oldImpulse;
+        const auto newImpulse = std::max(oldImpulse + lambda, 0_Ns);
+        const auto incImpulse = newImpulse - oldImpulse;
+        const auto P = incImpulse * direction;
+        const auto LA = AngularMomentum{Cross(vcp.relA, P) / Radian};
+        const auto LB = AngularMomentum{Cross(vcp.relB, P) / Radian};
+        newVelA -= d2::Velocity{invMassA * P, invRotInertiaA * LA};
+        newVelB += d2::Velocity{invMassB * P, invRotInertiaB * LB};
+        maxIncImpulse = std::max(maxIncImpulse, abs(incImpulse));
+        vc.SetNormalImpulseAtPoint(index, newImpulse);
+    }
+
+    d2::SetVelocityIfMovable(*bodyA, newVelA);
+    d2::SetVelocityIfMovable(*bodyB, newVelB);
+
+    return maxIncImpulse;
+}
+
+} // anonymous namespace
+
+Softness GetSoftness(Frequency frequency, Real dampingRatio, Time h) noexcept
+{
+    if (frequency == 0_Hz) {
+        return Softness{};
+    }
+    const auto omega = Real(2) * Pi * frequency;
+    const auto a1 = Real(2) * dampingRatio + Real{h * omega};
+    const auto a2 = Real{h * omega} * a1;
+    const auto a3 = Real(1) / (Real(1) + a2);
+    return Softness{omega / a1, a2 * a3, a3};
+}
+
+Momentum SolveVelocityConstraint(d2::VelocityConstraint& vc, const d2::PositionConstraint& pc,
+                                 const Span<d2::BodyConstraint>& bodies,
+                                 const SoftContactConf& conf)
+{
+    auto maxIncImpulse = 0_Ns;
+
+    // Applies frictional changes to velocity.
+    maxIncImpulse = std::max(maxIncImpulse, d2::SolveTangentConstraint(vc, bodies));
+
+    // Applies the soft normal changes to velocity.
+    maxIncImpulse = std::max(maxIncImpulse, SolveNormalConstraint(vc, pc, bodies, conf));
+
+    return maxIncImpulse;
+}
+
+Momentum ApplyRestitution(d2::VelocityConstraint& vc, const Span<d2::BodyConstraint>& bodies)
+{
+    auto maxIncImpulse = 0_Ns;
+
+    const auto direction = vc.GetNormal();
+    const auto count = vc.GetPointCount();
+    const auto bodyA = &bodies[to_underlying(vc.GetBodyA())];
+    const auto bodyB = &bodies[to_underlying(vc.GetBodyB())];
+
+    const auto invRotInertiaA = bodyA->GetInvRotInertia();
+    const auto invMassA = bodyA->GetInvMass();
+    const auto invRotInertiaB = bodyB->GetInvRotInertia();
+    const auto invMassB = bodyB->GetInvMass();
+
+    auto newVelA = bodyA->GetVelocity();
+    auto newVelB = bodyB->GetVelocity();
+
+    for (auto index = decltype(count){0}; index < count; ++index) {
+        const auto vcp = vc.GetPointAt(index);
+        if (vcp.velocityBias <= 0_mps) {
+            // Point wasn't closing fast enough to bounce.
+            continue;
+        }
+        const auto closingVel = d2::GetContactRelVelocity(newVelA, vcp.relA, newVelB, vcp.relB);
+        const auto directionalVel = LinearVelocity{Dot(closingVel, direction)};
+        const auto lambda = Momentum{vcp.normalMass * (vcp.velocityBias - directionalVel)};
+        const auto oldImpulse = vcp.normalImpulse;
+        const auto newImpulse = std::max(oldImpulse + lambda, 0_Ns);
+        const auto incImpulse = newImpulse - oldImpulse;
+        const auto P = incImpulse * direction;
+        const auto LA = AngularMomentum{Cross(vcp.relA, P) / Radian};
+        const auto LB = AngularMomentum{Cross(vcp.relB, P) / Radian};
+        newVelA -= d2::Velocity{invMassA * P, invRotInertiaA * LA};
+        newVelB += d2::Velocity{invMassB * P, invRotInertiaB * LB};
+        maxIncImpulse = std::max(maxIncImpulse, abs(incImpulse));
+        vc.SetNormalImpulseAtPoint(index, newImpulse);
+    }
+
+    d2::SetVelocityIfMovable(*bodyA, newVelA);
+    d2::SetVelocityIfMovable(*bodyB, newVelB);
+
+    return maxIncImpulse;
+}
+
+Length GetMinSeparation(const d2::PositionConstraint& pc,
+                        const Span<const d2::BodyConstraint>& bodies)
+{
+    const auto& bodyA = bodies[to_underlying(pc.bodyA)];
+    const auto& bodyB = bodies[to_underlying(pc.bodyB)];
+    const auto xfA = GetTransformation(bodyA.GetPosition(), bodyA.GetLocalCenter());
+    const auto xfB = GetTransformation(bodyB.GetPosition(), bodyB.GetLocalCenter());
+    auto minSeparation = std::numeric_limits<Length>::infinity();
+    const auto count = pc.manifold.GetPointCount();
+    for (auto index = decltype(count){0}; index < count; ++index) {
+        minSeparation = std::min(minSeparation, GetSeparation(pc, index, xfA, xfB));
+    }
+    return minSeparation;
+}
+
+} // namespace SoftStep
+
 } // namespace playrho
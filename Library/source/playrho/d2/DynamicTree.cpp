@@ -20,12 +20,13 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <cassert> // for assert
 #include <limits> // for std::numeric_limits
 #include <utility>
 #include <type_traits> // for std::is_nothrow_default_constructible_v, etc
+#include <vector>
 
-#include <playrho/GrowableStack.hpp>
 #include <playrho/DynamicMemory.hpp>
 #include <playrho/Templates.hpp>
 
@@ -384,6 +385,97 @@ DynamicTree::Size UpdateNonRoot(DynamicTree::TreeNode nodes[], DynamicTree::Size
     return UpdateUpwardFrom(nodes, parent);
 }
 
+/// @brief Number of bins used by <code>PartitionLeaves</code>.
+constexpr auto SahBinCount = std::size_t{16};
+
+/// @brief Partitions the given leaves in two for building a tree top-down.
+/// @details Bins the leaves by their centers along the widest axis of the centers and then
+///   splits them at the bin boundary having the lowest surface area heuristic (SAH) cost.
+///   In 2-D, this cost is the sum of each side's perimeter times its count of leaves.
+///   Falls back to splitting at the median center when binning can't separate the leaves.
+/// @pre @p count is greater than one.
+/// @return Count of leaves partitioned to the front of @p leaves. This is always greater
+///   than zero and less than @p count.
+DynamicTree::Size PartitionLeaves(const DynamicTree::TreeNode nodes[], DynamicTree::Size leaves[],
+                                  DynamicTree::Size count)
+{
+    assert(count > 1);
+    auto centers = AABB{};
+    for (auto i = decltype(count){0}; i < count; ++i) {
+        Include(centers, GetCenter(nodes[leaves[i]].GetAABB()));
+    }
+    const auto dimensions = GetDimensions(centers);
+    const auto axis = (dimensions[1] > dimensions[0])? std::size_t{1}: std::size_t{0};
+    const auto extent = dimensions[axis];
+    const auto lowest = centers.ranges[axis].GetMin();
+    const auto centerOf = [nodes,axis](DynamicTree::Size leaf) {
+        return GetCenter(nodes[leaf].GetAABB())[axis];
+    };
+    const auto splitAtMedian = [&]() {
+        const auto half = count / 2;
+        std::nth_element(leaves, leaves + half, leaves + count,
+                         [&](DynamicTree::Size a, DynamicTree::Size b) {
+            return centerOf(a) < centerOf(b);
+        });
+        return half;
+    };
+    if (!(extent > 0_m)) {
+        return splitAtMedian();
+    }
+
+    const auto binOf = [&](DynamicTree::Size leaf) {
+        const auto offset = static_cast<Real>((centerOf(leaf) - lowest) / extent);
+        const auto bin = static_cast<std::size_t>(offset * static_cast<Real>(SahBinCount));
+        return std::min(bin, SahBinCount - 1u);
+    };
+    auto binAABBs = std::array<AABB, SahBinCount>{};
+    auto binCounts = std::array<DynamicTree::Size, SahBinCount>{};
+    for (auto i = decltype(count){0}; i < count; ++i) {
+        const auto bin = binOf(leaves[i]);
+        Include(binAABBs[bin], nodes[leaves[i]].GetAABB());
+        ++binCounts[bin];
+    }
+
+    // Sweep from the right to get the cost of everything right of each boundary...
+    auto rightCosts = std::array<Length, SahBinCount>{};
+    {
+        auto aabb = AABB{};
+        auto n = DynamicTree::Size{0};
+        for (auto i = SahBinCount - 1u; i > 0u; --i) {
+            Include(aabb, binAABBs[i]);
+            n += binCounts[i];
+            rightCosts[i] = (n > 0u)? GetPerimeter(aabb) * static_cast<Real>(n): 0_m;
+        }
+    }
+
+    // Then sweep from the left to find the cheapest boundary splitting the leaves...
+    auto bestCost = std::numeric_limits<Length>::infinity();
+    auto bestBin = SahBinCount;
+    {
+        auto aabb = AABB{};
+        auto n = DynamicTree::Size{0};
+        for (auto i = std::size_t{0}; i < (SahBinCount - 1u); ++i) {
+            Include(aabb, binAABBs[i]);
+            n += binCounts[i];
+            if ((n == 0u) || (n == count)) {
+                continue;
+            }
+            const auto cost = GetPerimeter(aabb) * static_cast<Real>(n) + rightCosts[i + 1u];
+            if (bestCost > cost) {
+                bestCost = cost;
+                bestBin = i;
+            }
+        }
+    }
+    if (bestBin == SahBinCount) {
+        return splitAtMedian();
+    }
+    const auto last = std::partition(leaves, leaves + count, [&](DynamicTree::Size leaf) {
+        return binOf(leaf) <= bestBin;
+    });
+    return static_cast<DynamicTree::Size>(last - leaves);
+}
+
 } // anonymous namespace
 
 DynamicTree::DynamicTree() noexcept = default;
@@ -403,13 +495,34 @@ DynamicTree::DynamicTree(Size nodeCapacity)
     }
 }
 
+DynamicTree::DynamicTree(const Span<const AABB>& aabbs, const Span<const Contactable>& data)
+{
+    assert(size(aabbs) == size(data));
+    const auto count = static_cast<Size>(size(aabbs));
+    if (count > 0u) {
+        Reserve((count * 2u) - 1u);
+        auto leaves = std::vector<Size>(count);
+        for (auto i = decltype(count){0}; i < count; ++i) {
+            leaves[i] = AllocateNode();
+            m_nodes[leaves[i]] = TreeNode{data[i], aabbs[i]};
+        }
+        m_leafCount = count;
+        m_dynamicRootIndex = BuildTopDown(leaves.data(), count);
+        m_rootIndex = m_dynamicRootIndex;
+    }
+}
+
 DynamicTree::DynamicTree(const DynamicTree& other)
     : m_nodeCount{other.m_nodeCount},
       m_leafCount{other.m_leafCount},
       m_rootIndex{other.m_rootIndex},
+      m_staticRootIndex{other.m_staticRootIndex},
+      m_dynamicRootIndex{other.m_dynamicRootIndex},
+      m_staticLeafCount{other.m_staticLeafCount},
       m_freeIndex{other.m_freeIndex},
       m_nodeCapacity{other.m_nodeCapacity},
-      m_nodes{AllocArray<TreeNode>(other.m_nodeCapacity)}
+      m_nodes{AllocArray<TreeNode>(other.m_nodeCapacity)},
+      m_modifications{other.m_modifications}
 {
     std::copy(&other.m_nodes[0], &other.m_nodes[other.m_nodeCapacity], &m_nodes[0]);
 }
@@ -478,9 +591,13 @@ void DynamicTree::FreeNode(Size index) noexcept
 
 void DynamicTree::Clear() noexcept
 {
+    ++m_modifications;
     m_nodeCount = Size{0u};
     m_leafCount = Size{0u};
     m_rootIndex = InvalidSize;
+    m_staticRootIndex = InvalidSize;
+    m_dynamicRootIndex = InvalidSize;
+    m_staticLeafCount = Size{0u};
     if (m_nodeCapacity && m_nodes) {
         m_freeIndex = Size{0u};
         const auto endCapacity = m_nodeCapacity - 1;
@@ -514,41 +631,130 @@ DynamicTree::Size DynamicTree::FindReference(Size index) const noexcept
     return (it != m_nodes + m_nodeCapacity) ? static_cast<Size>(it - m_nodes) : InvalidSize;
 }
 
-DynamicTree::Size DynamicTree::CreateLeaf(const AABB& aabb, const Contactable& data)
+DynamicTree::Size& DynamicTree::RootIndex(Partition partition) noexcept
 {
+    return (partition == Partition::Static)? m_staticRootIndex: m_dynamicRootIndex;
+}
+
+void DynamicTree::SplitPartitions() noexcept
+{
+    if ((m_staticRootIndex == InvalidSize) || (m_dynamicRootIndex == InvalidSize)) {
+        m_rootIndex = InvalidSize;
+        return;
+    }
+    assert(m_rootIndex != m_staticRootIndex);
+    assert(m_rootIndex != m_dynamicRootIndex);
+    m_nodes[m_staticRootIndex].SetOther(InvalidSize);
+    m_nodes[m_dynamicRootIndex].SetOther(InvalidSize);
+    m_nodes[m_rootIndex] = TreeNode{};
+}
+
+void DynamicTree::JoinPartitions() noexcept
+{
+    const auto joinIndex = std::exchange(m_rootIndex, InvalidSize);
+    if ((m_staticRootIndex == InvalidSize) || (m_dynamicRootIndex == InvalidSize)) {
+        if (joinIndex != InvalidSize) {
+            // Not FreeNode since the joining node was already cleared by SplitPartitions.
+            m_nodes[joinIndex] = TreeNode{m_freeIndex};
+            m_freeIndex = joinIndex;
+            --m_nodeCount;
+        }
+        m_rootIndex = (m_staticRootIndex == InvalidSize)? m_dynamicRootIndex: m_staticRootIndex;
+        return;
+    }
+    const auto index = (joinIndex != InvalidSize)? joinIndex: AllocateNode();
+    const auto& staticRoot = m_nodes[m_staticRootIndex];
+    const auto& dynamicRoot = m_nodes[m_dynamicRootIndex];
+    m_nodes[index] = MakeNode(m_staticRootIndex, staticRoot.GetAABB(), staticRoot.GetHeight(),
+                              m_dynamicRootIndex, dynamicRoot.GetAABB(), dynamicRoot.GetHeight(),
+                              InvalidSize);
+    m_nodes[m_staticRootIndex].SetOther(index);
+    m_nodes[m_dynamicRootIndex].SetOther(index);
+    m_rootIndex = index;
+}
+
+DynamicTree::Size DynamicTree::CreateLeaf(const AABB& aabb, const Contactable& data,
+                                          Partition partition)
+{
+    ++m_modifications;
     assert(m_leafCount < std::numeric_limits<Size>::max());
     assert(IsValid(aabb));
-    if (m_rootIndex == InvalidSize) {
-        assert(GetNodeCount() < std::numeric_limits<Size>::max());
-        Reserve(GetNodeCount() + 1u); // Note: may change m_nodes!
-        const auto index = AllocateNode();
-        m_nodes[index] = TreeNode{data, aabb};
-        m_rootIndex = index;
-        ++m_leafCount;
-        return index;
-    }
-    assert(GetNodeCount() < (std::numeric_limits<Size>::max() - 1u));
-    Reserve(GetNodeCount() + 2u); // Note: may change m_nodes!
+    auto& rootIndex = RootIndex(partition);
+    const auto otherIndex = (partition == Partition::Static)? m_dynamicRootIndex: m_staticRootIndex;
+    // Reserve room for the leaf, its parent if it needs one, and for a node to join this
+    // partition to the other if this partition is empty but the other isn't.
+    // Note: JoinPartitions reuses any existing joining node.
+    const auto joining = (rootIndex == InvalidSize) && (otherIndex != InvalidSize);
+    assert(GetNodeCount() < (std::numeric_limits<Size>::max() - 2u));
+    Reserve(GetNodeCount() + ((rootIndex == InvalidSize)? 1u: 2u) +
+            (joining? 1u: 0u)); // Note: may change m_nodes!
+    SplitPartitions();
     const auto index = AllocateNode();
-    m_nodes[index] = TreeNode{data, aabb};
-    m_rootIndex = InsertParent(m_nodes, AllocateNode(), aabb, index, m_rootIndex);
+    m_nodes[index] = TreeNode{data, aabb, InvalidSize, partition};
+    rootIndex = (rootIndex == InvalidSize)
+        ? index: InsertParent(m_nodes, AllocateNode(), aabb, index, rootIndex);
     ++m_leafCount;
+    if (partition == Partition::Static) {
+        ++m_staticLeafCount;
+    }
+    JoinPartitions();
     return index;
 }
 
+void DynamicTree::CreateLeaves(const Span<const AABB>& aabbs, const Span<const Contactable>& data,
+                               const Span<Size>& indices, Partition partition)
+{
+    ++m_modifications;
+    assert(size(aabbs) == size(data));
+    assert(size(aabbs) == size(indices));
+    const auto count = static_cast<Size>(size(aabbs));
+    if (count == 0u) {
+        return;
+    }
+    if (count < GetLeafCount(partition)) {
+        for (auto i = decltype(count){0}; i < count; ++i) {
+            indices[i] = CreateLeaf(aabbs[i], data[i], partition);
+        }
+        return;
+    }
+    Reserve(GetNodeCount() + (count * 2u) + 1u); // Note: may change m_nodes!
+    for (auto i = decltype(count){0}; i < count; ++i) {
+        assert(IsValid(aabbs[i]));
+        indices[i] = AllocateNode();
+        m_nodes[indices[i]] = TreeNode{data[i], aabbs[i], InvalidSize, partition};
+    }
+    SplitPartitions();
+    auto& rootIndex = RootIndex(partition);
+    auto leaves = TakeLeaves(rootIndex);
+    leaves.insert(end(leaves), indices.begin(), indices.end());
+    rootIndex = BuildTopDown(leaves.data(), static_cast<Size>(size(leaves)));
+    m_leafCount += count;
+    if (partition == Partition::Static) {
+        m_staticLeafCount += count;
+    }
+    JoinPartitions();
+}
+
 void DynamicTree::DestroyLeaf(Size index) noexcept
 {
+    ++m_modifications;
     assert(index != InvalidSize);
     assert(index < m_nodeCapacity);
     assert(!IsUnused(m_nodes[index].GetHeight()));
     assert(IsLeaf(m_nodes[index].GetHeight()));
     assert(m_leafCount > 0);
 
+    const auto partition = GetPartition(index);
+    auto& rootIndex = RootIndex(partition);
+    SplitPartitions();
     --m_leafCount;
+    if (partition == Partition::Static) {
+        --m_staticLeafCount;
+    }
 
-    if (m_rootIndex != index) {
+    if (rootIndex != index) {
         const auto result = RemoveParent(m_nodes, index);
-        m_rootIndex = std::get<0>(result);
+        rootIndex = std::get<0>(result);
         const auto parent = std::get<1>(result);
 #ifndef NDEBUG
         const auto found = FindReference(parent);
@@ -558,7 +764,7 @@ void DynamicTree::DestroyLeaf(Size index) noexcept
     }
     else {
         assert(m_nodes[index].GetOther() == InvalidSize);
-        m_rootIndex = InvalidSize;
+        rootIndex = InvalidSize;
     }
 
 #ifndef NDEBUG
@@ -566,42 +772,113 @@ void DynamicTree::DestroyLeaf(Size index) noexcept
     assert(found == InvalidSize);
 #endif
     FreeNode(index);
+    JoinPartitions();
 }
 
 void DynamicTree::UpdateLeaf(Size index, const AABB& aabb)
 {
+    ++m_modifications;
     assert(index != InvalidSize);
     assert(index < m_nodeCapacity);
     assert(IsLeaf(m_nodes[index].GetHeight()));
 
-    if (m_rootIndex != index) {
-        m_rootIndex = UpdateNonRoot(m_nodes, index, aabb);
+    auto& rootIndex = RootIndex(GetPartition(index));
+    SplitPartitions();
+    if (rootIndex != index) {
+        rootIndex = UpdateNonRoot(m_nodes, index, aabb);
     }
     else {
         assert(m_nodes[index].GetOther() == InvalidSize);
         m_nodes[index].SetAABB(aabb);
     }
+    JoinPartitions();
 }
 
-void DynamicTree::RebuildBottomUp()
+void DynamicTree::SetPartition(Size index, Partition partition) noexcept
 {
-    const auto nodes = AllocArray<Size>(m_nodeCount);
-    auto count = Size{0};
+    assert(index != InvalidSize);
+    assert(index < m_nodeCapacity);
+    assert(IsLeaf(m_nodes[index].GetHeight()));
 
-    // Build array of leaves. Free the rest.
-    for (auto i = decltype(m_nodeCapacity){0}; i < m_nodeCapacity; ++i) {
-        const auto height = m_nodes[i].GetHeight();
-        if (IsLeaf(height)) {
-            m_nodes[i].SetOther(InvalidSize);
-            nodes[count] = i;
-            ++count;
+    const auto oldPartition = GetPartition(index);
+    if (oldPartition == partition) {
+        return;
+    }
+    ++m_modifications;
+    auto& oldRootIndex = RootIndex(oldPartition);
+    auto& newRootIndex = RootIndex(partition);
+    SplitPartitions();
+
+    // Any branch node freed by removing the leaf from its old partition, or the joining node
+    // when that partition's left empty, is what's reused for inserting it into the new
+    // partition. So this never needs more capacity.
+    auto parent = InvalidSize;
+    if (oldRootIndex != index) {
+        const auto result = RemoveParent(m_nodes, index);
+        oldRootIndex = std::get<0>(result);
+        parent = std::get<1>(result);
+    }
+    else {
+        oldRootIndex = InvalidSize;
+    }
+    if (newRootIndex == InvalidSize) {
+        if (parent != InvalidSize) {
+            FreeNode(parent);
         }
-        else if (IsBranch(height)) {
-            m_nodes[i].SetOther(InvalidSize);
-            FreeNode(i);
+        newRootIndex = index;
+    }
+    else {
+        if (parent == InvalidSize) {
+            // Both partitions had leaves so there's a joining node which isn't needed anymore.
+            parent = std::exchange(m_rootIndex, InvalidSize);
+            assert(parent != InvalidSize);
         }
+        newRootIndex = InsertParent(m_nodes, parent, m_nodes[index].GetAABB(), index,
+                                    newRootIndex);
+    }
+    m_nodes[index].SetPartition(partition);
+    if (partition == Partition::Static) {
+        ++m_staticLeafCount;
     }
+    else {
+        --m_staticLeafCount;
+    }
+    JoinPartitions();
+}
 
+DynamicTree::Partition DynamicTree::GetPartition(Size index) const noexcept
+{
+    assert(index < m_nodeCapacity);
+    assert(IsLeaf(m_nodes[index].GetHeight()));
+    return m_nodes[index].GetPartition();
+}
+
+std::vector<DynamicTree::Size> DynamicTree::TakeLeaves(Size index)
+{
+    auto leaves = std::vector<Size>{};
+    auto stack = std::vector<Size>{};
+    if (index != InvalidSize) {
+        stack.push_back(index);
+    }
+    while (!empty(stack)) {
+        const auto i = stack.back();
+        stack.pop_back();
+        m_nodes[i].SetOther(InvalidSize);
+        if (IsLeaf(m_nodes[i].GetHeight())) {
+            leaves.push_back(i);
+            continue;
+        }
+        const auto bd = m_nodes[i].AsBranch();
+        stack.push_back(bd.child1);
+        stack.push_back(bd.child2);
+        FreeNode(i);
+    }
+    return leaves;
+}
+
+DynamicTree::Size DynamicTree::BuildBottomUp(Size* nodes, Size count)
+{
+    assert(count > 0u);
     while (count > 1) {
         auto minCost = std::numeric_limits<Length>::infinity();
         auto iMin = InvalidSize;
@@ -642,13 +919,106 @@ void DynamicTree::RebuildBottomUp()
         nodes[iMin] = parent;
         --count;
     }
+    return nodes[0];
+}
+
+void DynamicTree::RebuildBottomUp()
+{
+    ++m_modifications;
+    SplitPartitions();
+    for (const auto partition: {Partition::Static, Partition::Dynamic}) {
+        auto& rootIndex = RootIndex(partition);
+        auto leaves = TakeLeaves(rootIndex);
+        if (!empty(leaves)) {
+            rootIndex = BuildBottomUp(data(leaves), static_cast<Size>(size(leaves)));
+        }
+    }
+    JoinPartitions();
+}
+
+DynamicTree::Size DynamicTree::BuildTopDown(Size* leaves, Size count)
+{
+    assert(count > 0u);
+    assert((GetNodeCount() + count - 1u) <= GetNodeCapacity());
+
+    // Range of leaves to be the descendants of a node...
+    struct Work {
+        Size first; ///< Index of first leaf of range in leaves.
+        Size count; ///< Count of leaves in range.
+        Size node; ///< Index of node for the range.
+        Size parent; ///< Index of parent of node.
+    };
+
+    // Branch node, its children, and its parent, in the order it was created...
+    struct Branch {
+        Size node; ///< Index of branch node.
+        Size child1; ///< Index of first child.
+        Size child2; ///< Index of second child.
+        Size parent; ///< Index of parent.
+    };
 
-    m_rootIndex = nodes[0];
-    Free(nodes);
+    auto branches = std::vector<Branch>{};
+    branches.reserve(count - 1u);
+    auto stack = std::vector<Work>{};
+    const auto root = (count == 1u)? leaves[0]: AllocateNode();
+    m_nodes[root].SetOther(InvalidSize);
+    stack.push_back(Work{0u, count, root, InvalidSize});
+    while (!empty(stack)) {
+        const auto work = stack.back();
+        stack.pop_back();
+        if (work.count == 1u) {
+            continue;
+        }
+        const auto split = PartitionLeaves(m_nodes, leaves + work.first, work.count);
+        const auto count1 = split;
+        const auto count2 = work.count - split;
+        const auto child1 = (count1 == 1u)? leaves[work.first]: AllocateNode();
+        const auto child2 = (count2 == 1u)? leaves[work.first + split]: AllocateNode();
+        // Branch nodes get their parent set when they're finalized below.
+        if (count1 == 1u) {
+            m_nodes[child1].SetOther(work.node);
+        }
+        if (count2 == 1u) {
+            m_nodes[child2].SetOther(work.node);
+        }
+        branches.push_back(Branch{work.node, child1, child2, work.parent});
+        stack.push_back(Work{work.first, count1, child1, work.node});
+        stack.push_back(Work{work.first + split, count2, child2, work.node});
+    }
+
+    // Children are always created after their parents, so finalizing in reverse order of
+    // creation means every branch's children are complete by the time the branch is.
+    for (auto it = rbegin(branches); it != rend(branches); ++it) {
+        const auto& node1 = m_nodes[it->child1];
+        const auto& node2 = m_nodes[it->child2];
+        m_nodes[it->node] = MakeNode(it->child1, node1.GetAABB(), node1.GetHeight(),
+                                     it->child2, node2.GetAABB(), node2.GetHeight(), it->parent);
+    }
+    return root;
+}
+
+void DynamicTree::Rebuild()
+{
+    Rebuild(Partition::Static);
+    Rebuild(Partition::Dynamic);
+}
+
+void DynamicTree::Rebuild(Partition partition)
+{
+    ++m_modifications;
+    SplitPartitions();
+    auto& rootIndex = RootIndex(partition);
+    auto leaves = TakeLeaves(rootIndex);
+    if (!empty(leaves)) {
+        // Branches just freed by TakeLeaves leave enough capacity for the new ones.
+        rootIndex = BuildTopDown(data(leaves), static_cast<Size>(size(leaves)));
+    }
+    JoinPartitions();
 }
 
 void DynamicTree::ShiftOrigin(const Length2& newOrigin) noexcept
 {
+    ++m_modifications;
     // Build array of leaves. Free the rest.
     for (auto i = decltype(m_nodeCapacity){0}; i < m_nodeCapacity; ++i) {
         if (!IsUnused(m_nodes[i].GetHeight())) {
@@ -664,39 +1034,25 @@ void swap(DynamicTree& lhs, DynamicTree& rhs) noexcept
     using playrho::swap;
     swap(lhs.m_nodes, rhs.m_nodes);
     swap(lhs.m_rootIndex, rhs.m_rootIndex);
+    swap(lhs.m_staticRootIndex, rhs.m_staticRootIndex);
+    swap(lhs.m_dynamicRootIndex, rhs.m_dynamicRootIndex);
+    swap(lhs.m_staticLeafCount, rhs.m_staticLeafCount);
     swap(lhs.m_freeIndex, rhs.m_freeIndex);
     swap(lhs.m_nodeCount, rhs.m_nodeCount);
     swap(lhs.m_nodeCapacity, rhs.m_nodeCapacity);
     swap(lhs.m_leafCount, rhs.m_leafCount);
+    swap(lhs.m_modifications, rhs.m_modifications);
 }
 
 void Query(const DynamicTree& tree, const AABB& aabb, const DynamicTreeSizeCB& callback)
 {
-    static constexpr auto InitialStackCapacity = 256;
-    GrowableStack<DynamicTree::Size, InitialStackCapacity> stack;
-    stack.push(tree.GetRootIndex());
+    Query(tree, tree.GetRootIndex(), aabb, callback);
+}
 
-    while (!empty(stack)) {
-        const auto index = stack.top();
-        stack.pop();
-        if (index != DynamicTree::InvalidSize) {
-            if (TestOverlap(tree.GetAABB(index), aabb)) {
-                const auto height = tree.GetHeight(index);
-                if (DynamicTree::IsBranch(height)) {
-                    const auto branchData = tree.GetBranchData(index);
-                    stack.push(branchData.child1);
-                    stack.push(branchData.child2);
-                }
-                else {
-                    assert(DynamicTree::IsLeaf(height));
-                    const auto sc = callback(index);
-                    if (sc == DynamicTreeOpcode::End) {
-                        return;
-                    }
-                }
-            }
-        }
-    }
+void Query(const DynamicTree& tree, DynamicTree::Size root, const AABB& aabb,
+           const DynamicTreeSizeCB& callback)
+{
+    QueryLeafs(tree, root, aabb, callback);
 }
 
 void Query(const DynamicTree& tree, const AABB& aabb, QueryShapeCallback callback)
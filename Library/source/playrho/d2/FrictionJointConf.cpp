@@ -74,7 +74,7 @@ FrictionJointConf GetFrictionJointConf(const World& world, BodyID bodyA, BodyID
                              GetLocalPoint(world, bodyB, anchor)};
 }
 
-void InitVelocity(FrictionJointConf& object, const Span<BodyConstraint>& bodies,
+void InitVelocity(FrictionJointConf& object, const BodyConstraintsMap& bodies,
                   const StepConf& step, const ConstraintSolverConf&)
 {
     if ((GetBodyA(object) == InvalidBodyID) || (GetBodyB(object) == InvalidBodyID)) {
@@ -154,7 +154,7 @@ void InitVelocity(FrictionJointConf& object, const Span<BodyConstraint>& bodies,
     bodyConstraintB.SetVelocity(velB);
 }
 
-bool SolveVelocity(FrictionJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(FrictionJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step)
 {
     if ((GetBodyA(object) == InvalidBodyID) || (GetBodyB(object) == InvalidBodyID)) {
@@ -231,7 +231,7 @@ bool SolveVelocity(FrictionJointConf& object, const Span<BodyConstraint>& bodies
     return solved;
 }
 
-bool SolvePosition(const FrictionJointConf&, const Span<BodyConstraint>&,
+bool SolvePosition(const FrictionJointConf&, const BodyConstraintsMap&,
                    const ConstraintSolverConf&)
 {
     return true;
@@ -53,13 +53,23 @@ static_assert(std::is_nothrow_destructible_v<Joint>, "Joint must be nothrow dest
 
 // Free functions...
 
-BodyConstraint& At(const Span<BodyConstraint>& container, BodyID key)
-{
-    const auto index = to_underlying(key);
-    if (index >= container.size()) {
+BodyConstraint& At(const BodyConstraintsMap& container, BodyID key)
+{
+    auto index = to_underlying(key);
+    if (const auto indices = container.GetIndices(); !empty(indices)) {
+        if (index >= indices.size()) {
+            throw std::out_of_range{"invalid key"};
+        }
+        if (indices[index] == InvalidBodyID) {
+            throw std::out_of_range{"unmapped key"};
+        }
+        index = to_underlying(indices[index]);
+    }
+    const auto constraints = container.GetConstraints();
+    if (index >= constraints.size()) {
         throw std::out_of_range{"invalid index"};
     }
-    return container[index];
+    return constraints[index];
 }
 
 Length2 GetLocalAnchorA(const Joint& object)
@@ -152,7 +152,7 @@ AngularMomentum GetAngularReaction(const PrismaticJointConf& conf)
     return GetY(conf.impulse) * SquareMeter * Kilogram / (Second * Radian);
 }
 
-void InitVelocity(PrismaticJointConf& object, const Span<BodyConstraint>& bodies,
+void InitVelocity(PrismaticJointConf& object, const BodyConstraintsMap& bodies,
                   const StepConf& step, const ConstraintSolverConf& conf)
 {
     if ((GetBodyA(object) == InvalidBodyID) || (GetBodyB(object) == InvalidBodyID)) {
@@ -284,7 +284,7 @@ void InitVelocity(PrismaticJointConf& object, const Span<BodyConstraint>& bodies
     bodyConstraintB.SetVelocity(velB);
 }
 
-bool SolveVelocity(PrismaticJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(PrismaticJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step)
 {
     if ((GetBodyA(object) == InvalidBodyID) || (GetBodyB(object) == InvalidBodyID)) {
@@ -406,7 +406,7 @@ bool SolveVelocity(PrismaticJointConf& object, const Span<BodyConstraint>& bodie
 // We could take the active state from the velocity solver. However, the joint might push past the
 // limit when the velocity solver indicates the limit is inactive.
 //
-bool SolvePosition(const PrismaticJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const PrismaticJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf)
 {
     if ((GetBodyA(object) == InvalidBodyID) || (GetBodyB(object) == InvalidBodyID)) {
@@ -19,17 +19,25 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 
-#include <algorithm> // for std::min
+#include <algorithm> // for std::min, std::count_if, std::lower_bound
 #include <cassert> // for assert
+#include <optional>
+#include <utility> // for std::pair
+#include <vector>
 
 #include <playrho/GrowableStack.hpp>
+#include <playrho/InvalidArgument.hpp>
+#include <playrho/TaskScheduler.hpp>
 
 #include <playrho/d2/AABB.hpp>
+#include <playrho/d2/Body.hpp>
 #include <playrho/d2/DistanceProxy.hpp>
 #include <playrho/d2/DynamicTree.hpp>
 #include <playrho/d2/Math.hpp>
 #include <playrho/d2/RayCastInput.hpp>
 #include <playrho/d2/RayCastOutput.hpp>
+#include <playrho/d2/Shape.hpp>
+#include <playrho/d2/WideDynamicTree.hpp>
 #include <playrho/d2/World.hpp>
 #include <playrho/d2/WorldBody.hpp>
 #include <playrho/d2/WorldMisc.hpp>
@@ -38,6 +46,168 @@
 namespace playrho {
 namespace d2 {
 
+namespace {
+
+/// @brief Gets the bit mask of the children of the given node that the given ray might hit.
+/// @details This is the same test that ray casting a <code>DynamicTree</code> does for
+///   each node, but done for all of the node's children in one go.
+unsigned GetRayCastMask(const WideDynamicTree::Node& node, const RayCastInput& input,
+                        const AABB& segmentAABB, const UnitVec& v) noexcept
+{
+    const auto minX = StripUnit(segmentAABB.ranges[0].GetMin());
+    const auto minY = StripUnit(segmentAABB.ranges[1].GetMin());
+    const auto maxX = StripUnit(segmentAABB.ranges[0].GetMax());
+    const auto maxY = StripUnit(segmentAABB.ranges[1].GetMax());
+    const auto p1x = StripUnit(GetX(input.p1));
+    const auto p1y = StripUnit(GetY(input.p1));
+    const auto vx = GetX(v);
+    const auto vy = GetY(v);
+    const auto absVx = abs(vx);
+    const auto absVy = abs(vy);
+    auto mask = 0u;
+    for (auto i = std::size_t{0}; i < WideDynamicTree::Width; ++i) {
+        const auto overlap = (node.minX[i] <= maxX) & (node.maxX[i] >= minX) &
+                             (node.minY[i] <= maxY) & (node.maxY[i] >= minY);
+        // Separating axis for segment (Gino, p80).
+        const auto centerX = (node.minX[i] + node.maxX[i]) / 2;
+        const auto centerY = (node.minY[i] + node.maxY[i]) / 2;
+        const auto extentX = (node.maxX[i] - node.minX[i]) / 2;
+        const auto extentY = (node.maxY[i] - node.minY[i]) / 2;
+        const auto separation = abs(vx * (p1x - centerX) + vy * (p1y - centerY))
+                              - (absVx * extentX + absVy * extentY);
+        mask |= static_cast<unsigned>(overlap & (separation <= 0)) << i;
+    }
+    return mask & ((1u << node.count) - 1u);
+}
+
+/// @brief Casts the given ray against the leafs in the given tree.
+/// @details This is the implementation of ray casting a <code>DynamicTree</code> that's
+///   templated on the callback so that internal uses can avoid <code>std::function</code>.
+template <class Callback>
+bool RayCastLeafs(const DynamicTree& tree, RayCastInput input, Callback&& callback)
+{
+    const auto v = GetRevPerpendicular(GetUnitVector(input.p2 - input.p1, UnitVec::GetZero()));
+    const auto abs_v = abs(v);
+    auto segmentAABB = d2::GetAABB(input);
+    static constexpr auto InitialStackCapacity = 256;
+    GrowableStack<ContactCounter, InitialStackCapacity> stack;
+    stack.push(tree.GetRootIndex());
+    while (!empty(stack))
+    {
+        const auto index = stack.top();
+        stack.pop();
+        if (index == DynamicTree::InvalidSize)
+        {
+            continue;
+        }
+        
+        const auto aabb = tree.GetAABB(index);
+        if (!TestOverlap(aabb, segmentAABB))
+        {
+            continue;
+        }
+        
+        // Separating axis for segment (Gino, p80).
+        // |dot(v, p1 - ctr)| > dot(|v|, extents)
+        const auto center = GetCenter(aabb);
+        const auto extents = GetExtents(aabb);
+        const auto separation = abs(Dot(v, input.p1 - center)) - Dot(abs_v, extents);
+        if (separation > 0_m)
+        {
+            continue;
+        }
+        
+        if (DynamicTree::IsBranch(tree.GetHeight(index)))
+        {
+            const auto branchData = tree.GetBranchData(index);
+            stack.push(branchData.child1);
+            stack.push(branchData.child2);
+        }
+        else
+        {
+            assert(DynamicTree::IsLeaf(tree.GetHeight(index)));
+            const auto leafData = tree.GetLeafData(index);
+            const auto value = callback(leafData.bodyId, leafData.shapeId, leafData.childId,
+                                        input);
+            if (value == 0)
+            {
+                return true; // Callback has terminated the ray cast.
+            }
+            if (value > 0)
+            {
+                // Update segment bounding box.
+                input.maxFraction = value;
+                segmentAABB = d2::GetAABB(input);
+            }
+        }
+    }
+    return false;
+}
+
+/// @brief Lazily filled, sparse cache of the shapes of a world.
+/// @details Ray casts tend to hit the same shapes over and over again. This only looks up
+///   a shape from the world the first time it's asked for, and only holds the shapes that
+///   have been asked for, sorted by their identifiers.
+class ShapeCache
+{
+public:
+    /// @brief Initializing constructor.
+    explicit ShapeCache(const World& world) noexcept: m_world{world}
+    {
+        // Intentionally empty.
+    }
+
+    /// @brief Gets the identified shape.
+    /// @note The returned reference is only good till the next call to this function.
+    const Shape& Get(ShapeID id)
+    {
+        const auto it = std::lower_bound(begin(m_shapes), end(m_shapes), id,
+                                         [](const auto& element, ShapeID value) {
+            return element.first < value;
+        });
+        if ((it != end(m_shapes)) && (it->first == id)) {
+            return it->second;
+        }
+        return m_shapes.emplace(it, id, GetShape(m_world, id))->second;
+    }
+
+private:
+    const World& m_world; ///< World to get shapes from.
+    std::vector<std::pair<ShapeID, Shape>> m_shapes; ///< Shapes gotten so far.
+};
+
+/// @brief Ray-casts the world for the closest shape hit by each of the identified rays.
+void RayCastClosest(const World& world, const Span<const RayCastInput>& inputs,
+                    const Span<ShapeRayCastOutput>& outputs, const Span<const Filter>& filters,
+                    std::size_t first, std::size_t last)
+{
+    const auto& tree = GetTree(world);
+    auto shapes = ShapeCache{world};
+    for (auto i = first; i < last; ++i) {
+        const auto filter = filters.empty()? std::optional<Filter>{}: filters[i];
+        auto closest = ShapeRayCastOutput{};
+        RayCastLeafs(tree, inputs[i], [&](BodyID bodyId, ShapeID shapeId, ChildCounter index,
+                                         const RayCastInput& rci) {
+            const auto& shape = shapes.Get(shapeId);
+            if (filter && !ShouldCollide(*filter, GetFilter(shape))) {
+                return Real{-1};
+            }
+            const auto output = RayCast(GetChild(shape, index), rci,
+                                        GetTransformation(GetBody(world, bodyId)));
+            if (!output.has_value()) {
+                return Real{-1};
+            }
+            const auto point = rci.p1 + (rci.p2 - rci.p1) * output->fraction;
+            closest = ShapeRayCastHit{bodyId, shapeId, index, point,
+                                      output->normal, output->fraction};
+            return Real{output->fraction};
+        });
+        outputs[i] = closest;
+    }
+}
+
+} // anonymous namespace
+
 RayCastOutput RayCast(Length radius, const Length2& location, const RayCastInput& input) noexcept
 {
     // Collision Detection in Interactive 3D Environments by Gino van den Bergen
@@ -239,48 +409,40 @@ RayCastOutput RayCast(const Shape& shape, ChildCounter childIndex,
 }
 
 bool RayCast(const DynamicTree& tree, RayCastInput input, const DynamicTreeRayCastCB& callback)
-{    
+{
+    return RayCastLeafs(tree, input, callback);
+}
+
+bool RayCast(const WideDynamicTree& tree, RayCastInput input, const DynamicTreeRayCastCB& callback)
+{
+    const auto root = tree.GetRootIndex();
+    if (root == WideDynamicTree::InvalidSize)
+    {
+        return false;
+    }
     const auto v = GetRevPerpendicular(GetUnitVector(input.p2 - input.p1, UnitVec::GetZero()));
-    const auto abs_v = abs(v);
     auto segmentAABB = d2::GetAABB(input);
-    static constexpr auto InitialStackCapacity = 256;
-    GrowableStack<ContactCounter, InitialStackCapacity> stack;
-    stack.push(tree.GetRootIndex());
+    static constexpr auto InitialStackCapacity = 64;
+    GrowableStack<WideDynamicTree::Size, InitialStackCapacity> stack;
+    stack.push(root);
     while (!empty(stack))
     {
-        const auto index = stack.top();
+        const auto& node = tree.GetNode(stack.top());
         stack.pop();
-        if (index == DynamicTree::InvalidSize)
+        auto mask = GetRayCastMask(node, input, segmentAABB, v);
+        for (auto slot = std::size_t{0}; slot < node.count; ++slot)
         {
-            continue;
-        }
-        
-        const auto aabb = tree.GetAABB(index);
-        if (!TestOverlap(aabb, segmentAABB))
-        {
-            continue;
-        }
-        
-        // Separating axis for segment (Gino, p80).
-        // |dot(v, p1 - ctr)| > dot(|v|, extents)
-        const auto center = GetCenter(aabb);
-        const auto extents = GetExtents(aabb);
-        const auto separation = abs(Dot(v, input.p1 - center)) - Dot(abs_v, extents);
-        if (separation > 0_m)
-        {
-            continue;
-        }
-        
-        if (DynamicTree::IsBranch(tree.GetHeight(index)))
-        {
-            const auto branchData = tree.GetBranchData(index);
-            stack.push(branchData.child1);
-            stack.push(branchData.child2);
-        }
-        else
-        {
-            assert(DynamicTree::IsLeaf(tree.GetHeight(index)));
-            const auto leafData = tree.GetLeafData(index);
+            if ((mask & (1u << slot)) == 0u)
+            {
+                continue;
+            }
+            const auto child = node.children[slot];
+            if ((node.leafMask & (1u << slot)) == 0u)
+            {
+                stack.push(child);
+                continue;
+            }
+            const auto leafData = tree.GetLeaf(child).data;
             const auto value = callback(leafData.bodyId, leafData.shapeId, leafData.childId,
                                         input);
             if (value == 0)
@@ -289,9 +451,10 @@ bool RayCast(const DynamicTree& tree, RayCastInput input, const DynamicTreeRayCa
             }
             if (value > 0)
             {
-                // Update segment bounding box.
+                // Update segment bounding box and recheck the remaining children against it.
                 input.maxFraction = value;
                 segmentAABB = d2::GetAABB(input);
+                mask &= GetRayCastMask(node, input, segmentAABB, v);
             }
         }
     }
@@ -336,5 +499,29 @@ bool RayCast(const World& world, const RayCastInput& input, const ShapeRayCastCB
     });
 }
 
+std::size_t RayCast(const World& world, const Span<const RayCastInput>& inputs,
+                    const Span<ShapeRayCastOutput>& outputs,
+                    const Span<const Filter>& filters, TaskScheduler* scheduler)
+{
+    if (outputs.size() < inputs.size()) {
+        throw InvalidArgument("RayCast: outputs smaller than inputs");
+    }
+    if (!filters.empty() && (filters.size() != inputs.size())) {
+        throw InvalidArgument("RayCast: filters not empty nor same size as inputs");
+    }
+    if (scheduler) {
+        scheduler->ParallelFor(inputs.size(), [&](std::size_t first, std::size_t last) {
+            RayCastClosest(world, inputs, outputs, filters, first, last);
+        });
+    }
+    else {
+        RayCastClosest(world, inputs, outputs, filters, 0u, inputs.size());
+    }
+    return static_cast<std::size_t>(std::count_if(outputs.begin(), outputs.begin() + inputs.size(),
+                                                   [](const ShapeRayCastOutput& output) {
+        return output.has_value();
+    }));
+}
+
 } // namespace d2
 } // namespace playrho
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <cassert> // for assert
+
+#include <playrho/GrowableStack.hpp>
+
+#include <playrho/d2/AABB.hpp>
+#include <playrho/d2/Body.hpp>
+#include <playrho/d2/Distance.hpp>
+#include <playrho/d2/DistanceProxy.hpp>
+#include <playrho/d2/DynamicTree.hpp>
+#include <playrho/d2/Math.hpp>
+#include <playrho/d2/Shape.hpp>
+#include <playrho/d2/ShapeCast.hpp>
+#include <playrho/d2/Sweep.hpp>
+#include <playrho/d2/TimeOfImpact.hpp>
+#include <playrho/d2/World.hpp>
+
+namespace playrho::d2 {
+
+namespace {
+
+/// @brief Gets the hit point and normal of the two given proxies that are touching.
+/// @return Point on the surface of proxy B and the normal of that surface pointing
+///   towards proxy A.
+std::pair<Length2, UnitVec> GetPointAndNormal(const DistanceProxy& proxyA,
+                                              const Transformation& xfA,
+                                              const DistanceProxy& proxyB,
+                                              const Transformation& xfB,
+                                              const UnitVec& fallback)
+{
+    const auto witnessPoints = GetWitnessPoints(Distance(proxyA, xfA, proxyB, xfB).simplex);
+    const auto normal = GetUnitVector(std::get<0>(witnessPoints) - std::get<1>(witnessPoints),
+                                      fallback);
+    return {std::get<1>(witnessPoints) + normal * proxyB.GetVertexRadius(), normal};
+}
+
+} // anonymous namespace
+
+ShapeCastOutput ShapeCast(const World& world, const DistanceProxy& proxy,
+                          const Transformation& from, const Length2& to,
+                          const std::optional<Filter>& filter, const ToiConf& conf)
+{
+    const auto angle = GetAngle(from.q);
+    const auto sweep = Sweep{Position{from.p, angle}, Position{to, angle}};
+    const auto delta = to - from.p;
+    const auto aabb = ComputeAABB(proxy, from);
+    auto toiConf = conf;
+    auto sweptAABB = GetDisplacedAABB(aabb, delta * Real{toiConf.timeMax});
+    auto closest = ShapeCastOutput{};
+
+    const auto& tree = GetTree(world);
+    static constexpr auto InitialStackCapacity = 256;
+    GrowableStack<DynamicTree::Size, InitialStackCapacity> stack;
+    stack.push(tree.GetRootIndex());
+    while (!empty(stack)) {
+        const auto index = stack.top();
+        stack.pop();
+        if ((index == DynamicTree::InvalidSize) || !TestOverlap(tree.GetAABB(index), sweptAABB)) {
+            continue;
+        }
+        if (DynamicTree::IsBranch(tree.GetHeight(index))) {
+            // Visit the child nearer to the start first, so closer hits tend to be found
+            // sooner and shrink the swept AABB for the rest of the walk.
+            const auto branchData = tree.GetBranchData(index);
+            const auto center1 = GetCenter(tree.GetAABB(branchData.child1));
+            const auto center2 = GetCenter(tree.GetAABB(branchData.child2));
+            const auto dist1 = GetMagnitudeSquared(center1 - from.p);
+            const auto dist2 = GetMagnitudeSquared(center2 - from.p);
+            const auto nearer = (dist1 <= dist2)? branchData.child1: branchData.child2;
+            const auto farther = (dist1 <= dist2)? branchData.child2: branchData.child1;
+            stack.push(farther);
+            stack.push(nearer);
+            continue;
+        }
+        assert(DynamicTree::IsLeaf(tree.GetHeight(index)));
+        const auto leafData = tree.GetLeafData(index);
+        const auto shape = GetShape(world, leafData.shapeId);
+        if (filter && !ShouldCollide(*filter, GetFilter(shape))) {
+            continue;
+        }
+        const auto child = GetChild(shape, leafData.childId);
+        const auto& xf = GetTransformation(GetBody(world, leafData.bodyId));
+        const auto output = GetToiViaSat(proxy, sweep, child,
+                                         Sweep{Position{xf.p, GetAngle(xf.q)}}, toiConf);
+        if ((output.state != ToiOutput::e_touching) ||
+            (closest && (output.time >= closest->fraction))) {
+            continue;
+        }
+        const auto xfA = Transformation{from.p + delta * Real{output.time}, from.q};
+        const auto [point, normal] = GetPointAndNormal(proxy, xfA, child, xf,
+                                                       -GetUnitVector(delta, UnitVec::GetZero()));
+        closest = ShapeCastHit{leafData.bodyId, leafData.shapeId, leafData.childId,
+                               output.time, point, normal, output};
+        toiConf.timeMax = output.time;
+        sweptAABB = GetDisplacedAABB(aabb, delta * Real{output.time});
+    }
+    return closest;
+}
+
+} // namespace playrho::d2
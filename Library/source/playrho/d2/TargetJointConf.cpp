@@ -83,7 +83,7 @@ Mass22 GetEffectiveMassMatrix(const TargetJointConf& object, const BodyConstrain
 // Identity used:
 // w k % (rx i + ry j) = w * (-ry i + rx j)
 
-void InitVelocity(TargetJointConf& object, const Span<BodyConstraint>& bodies,
+void InitVelocity(TargetJointConf& object, const BodyConstraintsMap& bodies,
                   const StepConf& step, const ConstraintSolverConf&)
 {
     if (GetBodyB(object) == InvalidBodyID) {
@@ -147,7 +147,7 @@ void InitVelocity(TargetJointConf& object, const Span<BodyConstraint>& bodies,
     bodyConstraintB.SetVelocity(velB);
 }
 
-bool SolveVelocity(TargetJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(TargetJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step)
 {
     if (GetBodyB(object) == InvalidBodyID) {
@@ -182,7 +182,7 @@ bool SolveVelocity(TargetJointConf& object, const Span<BodyConstraint>& bodies,
     return incImpulse == Momentum2{0_Ns, 0_Ns};
 }
 
-bool SolvePosition(const TargetJointConf&, const Span<BodyConstraint>&,
+bool SolvePosition(const TargetJointConf&, const BodyConstraintsMap&,
                    const ConstraintSolverConf&)
 {
     return true;
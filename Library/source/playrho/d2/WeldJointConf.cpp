@@ -112,7 +112,7 @@ WeldJointConf GetWeldJointConf(const World& world, BodyID bodyA, BodyID bodyB, c
                          GetAngle(world, bodyB) - GetAngle(world, bodyA)};
 }
 
-void InitVelocity(WeldJointConf& object, const Span<BodyConstraint>& bodies, const StepConf& step,
+void InitVelocity(WeldJointConf& object, const BodyConstraintsMap& bodies, const StepConf& step,
                   const ConstraintSolverConf&)
 {
     if ((GetBodyA(object) == InvalidBodyID) || (GetBodyB(object) == InvalidBodyID)) {
@@ -214,7 +214,7 @@ void InitVelocity(WeldJointConf& object, const Span<BodyConstraint>& bodies, con
     bodyConstraintB.SetVelocity(velB);
 }
 
-bool SolveVelocity(WeldJointConf& object, const Span<BodyConstraint>& bodies, const StepConf&)
+bool SolveVelocity(WeldJointConf& object, const BodyConstraintsMap& bodies, const StepConf&)
 {
     if ((GetBodyA(object) == InvalidBodyID) || (GetBodyB(object) == InvalidBodyID)) {
         return true;
@@ -300,7 +300,7 @@ bool SolveVelocity(WeldJointConf& object, const Span<BodyConstraint>& bodies, co
     return true;
 }
 
-bool SolvePosition(const WeldJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const WeldJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf)
 {
     if ((GetBodyA(object) == InvalidBodyID) || (GetBodyB(object) == InvalidBodyID)) {
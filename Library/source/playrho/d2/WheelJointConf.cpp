@@ -102,7 +102,7 @@ AngularVelocity GetAngularVelocity(const World& world, const WheelJointConf& con
     return GetVelocity(world, GetBodyB(conf)).angular - GetVelocity(world, GetBodyA(conf)).angular;
 }
 
-void InitVelocity(WheelJointConf& object, const Span<BodyConstraint>& bodies, const StepConf& step,
+void InitVelocity(WheelJointConf& object, const BodyConstraintsMap& bodies, const StepConf& step,
                   const ConstraintSolverConf&)
 {
     if ((GetBodyA(object) == InvalidBodyID) || (GetBodyB(object) == InvalidBodyID)) {
@@ -229,7 +229,7 @@ void InitVelocity(WheelJointConf& object, const Span<BodyConstraint>& bodies, co
     bodyConstraintB.SetVelocity(velB);
 }
 
-bool SolveVelocity(WheelJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolveVelocity(WheelJointConf& object, const BodyConstraintsMap& bodies,
                    const StepConf& step)
 {
     if ((GetBodyA(object) == InvalidBodyID) || (GetBodyB(object) == InvalidBodyID)) {
@@ -306,7 +306,7 @@ bool SolveVelocity(WheelJointConf& object, const Span<BodyConstraint>& bodies,
     return true;
 }
 
-bool SolvePosition(const WheelJointConf& object, const Span<BodyConstraint>& bodies,
+bool SolvePosition(const WheelJointConf& object, const BodyConstraintsMap& bodies,
                    const ConstraintSolverConf& conf)
 {
     if ((GetBodyA(object) == InvalidBodyID) || (GetBodyB(object) == InvalidBodyID)) {
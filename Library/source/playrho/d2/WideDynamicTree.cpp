@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <limits> // for std::numeric_limits
+#include <type_traits> // for std::is_nothrow_default_constructible_v, etc
+
+#include <playrho/GrowableStack.hpp>
+#include <playrho/Units.hpp> // for StripUnit
+
+#include <playrho/d2/WideDynamicTree.hpp>
+
+namespace playrho::d2 {
+
+static_assert(std::is_nothrow_default_constructible_v<WideDynamicTree>,
+              "WideDynamicTree must be nothrow default constructible!");
+static_assert(std::is_nothrow_move_constructible_v<WideDynamicTree>,
+              "WideDynamicTree must be nothrow move constructible!");
+static_assert(WideDynamicTree::Width <= 8u,
+              "WideDynamicTree::Width must fit the bits of its node's leaf mask!");
+
+namespace {
+
+/// @brief Makes a node having no children.
+WideDynamicTree::Node MakeEmptyNode() noexcept
+{
+    auto node = WideDynamicTree::Node{};
+    node.minX.fill(std::numeric_limits<Real>::max());
+    node.minY.fill(std::numeric_limits<Real>::max());
+    node.maxX.fill(std::numeric_limits<Real>::lowest());
+    node.maxY.fill(std::numeric_limits<Real>::lowest());
+    node.children.fill(WideDynamicTree::InvalidSize);
+    node.count = 0u;
+    node.leafMask = 0u;
+    return node;
+}
+
+/// @brief Sets the bounds of the given slot of the given node from the given AABB.
+void SetBounds(WideDynamicTree::Node& node, std::size_t slot, const AABB& aabb) noexcept
+{
+    node.minX[slot] = StripUnit(aabb.ranges[0].GetMin());
+    node.minY[slot] = StripUnit(aabb.ranges[1].GetMin());
+    node.maxX[slot] = StripUnit(aabb.ranges[0].GetMax());
+    node.maxY[slot] = StripUnit(aabb.ranges[1].GetMax());
+}
+
+/// @brief Gets the bit mask of the children of the given node that overlap the given bounds.
+/// @note This intentionally tests every slot without branching so the compiler can
+///   vectorize it. Bits for slots past the node's count are masked off after.
+unsigned GetOverlapMask(const WideDynamicTree::Node& node,
+                        Real minX, Real minY, Real maxX, Real maxY) noexcept
+{
+    auto mask = 0u;
+    for (auto i = std::size_t{0}; i < WideDynamicTree::Width; ++i) {
+        const auto overlap = (node.minX[i] <= maxX) & (node.maxX[i] >= minX) &
+                             (node.minY[i] <= maxY) & (node.maxY[i] >= minY);
+        mask |= static_cast<unsigned>(overlap) << i;
+    }
+    return mask & ((1u << node.count) - 1u);
+}
+
+} // anonymous namespace
+
+WideDynamicTree::WideDynamicTree(const DynamicTree& tree)
+{
+    Rebuild(tree);
+}
+
+void WideDynamicTree::Rebuild(const DynamicTree& tree)
+{
+    Clear();
+    const auto leafCount = tree.GetLeafCount();
+    if (leafCount == 0u) {
+        return;
+    }
+    m_leaves.reserve(leafCount);
+    m_nodes.reserve(leafCount / 2u + 1u);
+    const auto staticRoot = tree.GetRootIndex(Partition::Static);
+    const auto dynamicRoot = tree.GetRootIndex(Partition::Dynamic);
+    if ((staticRoot != InvalidSize) && (dynamicRoot != InvalidSize)) {
+        // Keep the partitions apart so each can still be queried on its own.
+        m_rootIndex = static_cast<Size>(m_nodes.size());
+        m_nodes.push_back(MakeEmptyNode());
+        m_staticRootIndex = Collapse(tree, staticRoot);
+        m_dynamicRootIndex = Collapse(tree, dynamicRoot);
+        auto& root = m_nodes[m_rootIndex];
+        SetBounds(root, 0u, tree.GetAABB(staticRoot));
+        SetBounds(root, 1u, tree.GetAABB(dynamicRoot));
+        root.children[0] = m_staticRootIndex;
+        root.children[1] = m_dynamicRootIndex;
+        root.count = 2u;
+        return;
+    }
+    if (staticRoot != InvalidSize) {
+        m_staticRootIndex = Collapse(tree, staticRoot);
+        m_rootIndex = m_staticRootIndex;
+        return;
+    }
+    m_dynamicRootIndex = Collapse(tree, dynamicRoot);
+    m_rootIndex = m_dynamicRootIndex;
+}
+
+void WideDynamicTree::Clear() noexcept
+{
+    m_nodes.clear();
+    m_leaves.clear();
+    m_rootIndex = InvalidSize;
+    m_staticRootIndex = InvalidSize;
+    m_dynamicRootIndex = InvalidSize;
+}
+
+WideDynamicTree::Size WideDynamicTree::Collapse(const DynamicTree& tree, Size index)
+{
+    struct Work {
+        Size source; ///< Index of a node of the dynamic tree.
+        Size node; ///< Index of the node to collapse the source into.
+    };
+
+    const auto rootIndex = static_cast<Size>(m_nodes.size());
+    m_nodes.push_back(MakeEmptyNode());
+    auto stack = std::vector<Work>{Work{index, rootIndex}};
+    while (!empty(stack)) {
+        const auto work = stack.back();
+        stack.pop_back();
+
+        auto slots = std::array<Size, Width>{};
+        auto count = std::size_t{0};
+        if (DynamicTree::IsBranch(tree.GetHeight(work.source))) {
+            const auto branchData = tree.GetBranchData(work.source);
+            slots[count++] = branchData.child1;
+            slots[count++] = branchData.child2;
+            // Pull up the grandchildren of the biggest branches until the slots are full.
+            // Bigger branches are the likelier ones to be overlapped, so testing their
+            // children right away is what saves the most node visits.
+            while (count < Width) {
+                auto biggest = count;
+                auto biggestPerimeter = 0_m;
+                for (auto i = std::size_t{0}; i < count; ++i) {
+                    if (DynamicTree::IsBranch(tree.GetHeight(slots[i]))) {
+                        const auto perimeter = GetPerimeter(tree.GetAABB(slots[i]));
+                        if ((biggest == count) || (perimeter > biggestPerimeter)) {
+                            biggest = i;
+                            biggestPerimeter = perimeter;
+                        }
+                    }
+                }
+                if (biggest == count) {
+                    break;
+                }
+                const auto grandchildren = tree.GetBranchData(slots[biggest]);
+                slots[biggest] = grandchildren.child1;
+                slots[count++] = grandchildren.child2;
+            }
+        }
+        else {
+            slots[count++] = work.source;
+        }
+
+        auto node = MakeEmptyNode();
+        node.count = static_cast<std::uint8_t>(count);
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            SetBounds(node, i, tree.GetAABB(slots[i]));
+            if (DynamicTree::IsLeaf(tree.GetHeight(slots[i]))) {
+                node.children[i] = static_cast<Size>(m_leaves.size());
+                node.leafMask |= static_cast<std::uint8_t>(1u << i);
+                m_leaves.push_back(Leaf{slots[i], tree.GetLeafData(slots[i])});
+            }
+            else {
+                node.children[i] = static_cast<Size>(m_nodes.size());
+                m_nodes.push_back(MakeEmptyNode());
+                stack.push_back(Work{slots[i], node.children[i]});
+            }
+        }
+        m_nodes[work.node] = node;
+    }
+    return rootIndex;
+}
+
+void Query(const WideDynamicTree& tree, const AABB& aabb, const DynamicTreeSizeCB& callback)
+{
+    Query(tree, tree.GetRootIndex(), aabb, callback);
+}
+
+void Query(const WideDynamicTree& tree, WideDynamicTree::Size root, const AABB& aabb,
+           const DynamicTreeSizeCB& callback)
+{
+    if (root == WideDynamicTree::InvalidSize) {
+        return;
+    }
+    const auto minX = StripUnit(aabb.ranges[0].GetMin());
+    const auto minY = StripUnit(aabb.ranges[1].GetMin());
+    const auto maxX = StripUnit(aabb.ranges[0].GetMax());
+    const auto maxY = StripUnit(aabb.ranges[1].GetMax());
+
+    static constexpr auto InitialStackCapacity = 64;
+    GrowableStack<WideDynamicTree::Size, InitialStackCapacity> stack;
+    stack.push(root);
+    while (!empty(stack)) {
+        const auto& node = tree.GetNode(stack.top());
+        stack.pop();
+        const auto mask = GetOverlapMask(node, minX, minY, maxX, maxY);
+        for (auto slot = std::size_t{0}; slot < node.count; ++slot) {
+            if ((mask & (1u << slot)) == 0u) {
+                continue;
+            }
+            const auto child = node.children[slot];
+            if ((node.leafMask & (1u << slot)) != 0u) {
+                if (callback(tree.GetLeaf(child).index) == DynamicTreeOpcode::End) {
+                    return;
+                }
+            }
+            else {
+                stack.push(child);
+            }
+        }
+    }
+}
+
+} // namespace playrho::d2
@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <algorithm> // for std::clamp, std::max, std::find_if
+#include <cmath> // for std::abs
+#include <type_traits> // for std::is_nothrow_default_constructible_v
+
+#include <playrho/to_underlying.hpp>
+
+#include <playrho/d2/BodyConstraint.hpp>
+#include <playrho/d2/VelocityConstraint.hpp>
+#include <playrho/d2/WideVelocityConstraints.hpp>
+
+namespace playrho::d2 {
+
+static_assert(std::is_nothrow_default_constructible_v<WideVelocityConstraints>,
+              "WideVelocityConstraints must be nothrow default constructible!");
+static_assert(WideVelocityConstraints::Width <= 8u,
+              "WideVelocityConstraints::Width must fit in a bundle's count!");
+
+namespace {
+
+using Bundle = WideVelocityConstraints::Bundle;
+using Lanes = WideVelocityConstraints::Lanes;
+
+/// @brief Maximum number of partially filled bundles to look in for room for a constraint.
+/// @note This bounds the time it takes to pack constraints that almost all share a body.
+constexpr auto MaxOpenBundles = std::size_t{16};
+
+/// @brief Velocities of the bodies of a bundle's lanes.
+struct Velocities
+{
+    Lanes linearAX; ///< X values of the linear velocities of the A bodies.
+    Lanes linearAY; ///< Y values of the linear velocities of the A bodies.
+    Lanes angularA; ///< Angular velocities of the A bodies.
+    Lanes linearBX; ///< X values of the linear velocities of the B bodies.
+    Lanes linearBY; ///< Y values of the linear velocities of the B bodies.
+    Lanes angularB; ///< Angular velocities of the B bodies.
+};
+
+/// @brief Gets whether solving can change the velocity of a body having the given values.
+bool IsMovable(Real invMass, Real invRotInertia) noexcept
+{
+    return (invMass != Real(0)) || (invRotInertia != Real(0));
+}
+
+/// @brief Gets whether a constraint of the given movable bodies can't go in the given bundle.
+/// @param movableA Identifier of the constraint's body A if movable, else the invalid value.
+/// @param movableB Identifier of the constraint's body B if movable, else the invalid value.
+bool IsConflicting(const Bundle& bundle, BodyID movableA, BodyID movableB) noexcept
+{
+    for (auto lane = std::size_t{0}; lane < bundle.count; ++lane) {
+        if (IsMovable(bundle.invMassA[lane], bundle.invRotInertiaA[lane]) &&
+            ((bundle.bodyA[lane] == movableA) || (bundle.bodyA[lane] == movableB))) {
+            return true;
+        }
+        if (IsMovable(bundle.invMassB[lane], bundle.invRotInertiaB[lane]) &&
+            ((bundle.bodyB[lane] == movableA) || (bundle.bodyB[lane] == movableB))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Adds the given constraint to the next lane of the given bundle.
+void AddLane(Bundle& bundle, std::size_t index, const VelocityConstraint& vc,
+             const Span<const BodyConstraint>& bodies)
+{
+    const auto lane = std::size_t{bundle.count};
+    assert(lane < WideVelocityConstraints::Width);
+    const auto& bodyA = bodies[to_underlying(vc.GetBodyA())];
+    const auto& bodyB = bodies[to_underlying(vc.GetBodyB())];
+    const auto pointCount = vc.GetPointCount();
+    const auto K = vc.GetK();
+    const auto normalMass = vc.GetNormalMass();
+    bundle.bodyA[lane] = vc.GetBodyA();
+    bundle.bodyB[lane] = vc.GetBodyB();
+    bundle.constraints[lane] = index;
+    bundle.invMassA[lane] = StripUnit(bodyA.GetInvMass());
+    bundle.invRotInertiaA[lane] = StripUnit(bodyA.GetInvRotInertia());
+    bundle.invMassB[lane] = StripUnit(bodyB.GetInvMass());
+    bundle.invRotInertiaB[lane] = StripUnit(bodyB.GetInvRotInertia());
+    bundle.normalX[lane] = vc.GetNormal().GetX();
+    bundle.normalY[lane] = vc.GetNormal().GetY();
+    bundle.friction[lane] = vc.GetFriction();
+    bundle.tangentSpeed[lane] = StripUnit(vc.GetTangentSpeed());
+    bundle.k11[lane] = StripUnit(get<0>(get<0>(K)));
+    bundle.k12[lane] = StripUnit(get<1>(get<0>(K)));
+    bundle.k22[lane] = StripUnit(get<1>(get<1>(K)));
+    bundle.normalMass11[lane] = StripUnit(get<0>(get<0>(normalMass)));
+    bundle.normalMass12[lane] = StripUnit(get<1>(get<0>(normalMass)));
+    bundle.normalMass22[lane] = StripUnit(get<1>(get<1>(normalMass)));
+    // Same condition that GaussSeidel::SolveVelocityConstraint block solves for.
+    bundle.blockSolve[lane] = ((pointCount == 2) && (K != InvMass22{}))? Real(1): Real(0);
+    for (auto i = VelocityConstraint::size_type{0}; i < pointCount; ++i) {
+        const auto& src = vc.GetPointAt(i);
+        auto& dst = bundle.points[i];
+        dst.relAX[lane] = StripUnit(get<0>(src.relA));
+        dst.relAY[lane] = StripUnit(get<1>(src.relA));
+        dst.relBX[lane] = StripUnit(get<0>(src.relB));
+        dst.relBY[lane] = StripUnit(get<1>(src.relB));
+        dst.normalMass[lane] = StripUnit(src.normalMass);
+        dst.tangentMass[lane] = StripUnit(src.tangentMass);
+        dst.velocityBias[lane] = StripUnit(src.velocityBias);
+        dst.normalImpulse[lane] = StripUnit(src.normalImpulse);
+        dst.tangentImpulse[lane] = StripUnit(src.tangentImpulse);
+        dst.active[lane] = Real(1);
+    }
+    ++bundle.count;
+}
+
+/// @brief Solves the tangent constraint of the given point of every lane of a bundle.
+/// @note Like the other lane loops, this intentionally has no branches so the compiler
+///   can vectorize it.
+void SolveTangentPoint(const Bundle& bundle, WideVelocityConstraints::Point& point,
+                       Velocities& v, Lanes& maxIncImpulse) noexcept
+{
+    for (auto lane = std::size_t{0}; lane < WideVelocityConstraints::Width; ++lane) {
+        const auto tangentX = bundle.normalY[lane];
+        const auto tangentY = -bundle.normalX[lane];
+        const auto dvX = v.linearBX[lane] - point.relBY[lane] * v.angularB[lane]
+                       - v.linearAX[lane] + point.relAY[lane] * v.angularA[lane];
+        const auto dvY = v.linearBY[lane] + point.relBX[lane] * v.angularB[lane]
+                       - v.linearAY[lane] - point.relAX[lane] * v.angularA[lane];
+        const auto vt = bundle.tangentSpeed[lane] - (dvX * tangentX + dvY * tangentY);
+        const auto lambda = point.tangentMass[lane] * vt;
+        const auto maxImpulse = bundle.friction[lane] * point.normalImpulse[lane];
+        const auto oldImpulse = point.tangentImpulse[lane];
+        const auto newImpulse = std::clamp(oldImpulse + lambda, -maxImpulse, maxImpulse);
+        const auto incImpulse = (newImpulse - oldImpulse) * point.active[lane];
+        const auto PX = incImpulse * tangentX;
+        const auto PY = incImpulse * tangentY;
+        const auto LA = point.relAX[lane] * PY - point.relAY[lane] * PX;
+        const auto LB = point.relBX[lane] * PY - point.relBY[lane] * PX;
+        v.linearAX[lane] -= bundle.invMassA[lane] * PX;
+        v.linearAY[lane] -= bundle.invMassA[lane] * PY;
+        v.angularA[lane] -= bundle.invRotInertiaA[lane] * LA;
+        v.linearBX[lane] += bundle.invMassB[lane] * PX;
+        v.linearBY[lane] += bundle.invMassB[lane] * PY;
+        v.angularB[lane] += bundle.invRotInertiaB[lane] * LB;
+        point.tangentImpulse[lane] = oldImpulse + incImpulse;
+        maxIncImpulse[lane] = std::max(maxIncImpulse[lane], std::abs(incImpulse));
+    }
+}
+
+/// @brief Solves the normal constraints of every lane of a bundle.
+/// @details Computes both the sequential and the block solution of every lane and then
+///   selects the one that <code>GaussSeidel::SolveVelocityConstraint</code> would've used.
+void SolveNormal(Bundle& bundle, Velocities& v, Lanes& maxIncImpulse) noexcept
+{
+    auto& p0 = bundle.points[0];
+    auto& p1 = bundle.points[1];
+    for (auto lane = std::size_t{0}; lane < WideVelocityConstraints::Width; ++lane) {
+        const auto nX = bundle.normalX[lane];
+        const auto nY = bundle.normalY[lane];
+        const auto invMassA = bundle.invMassA[lane];
+        const auto invRotInertiaA = bundle.invRotInertiaA[lane];
+        const auto invMassB = bundle.invMassB[lane];
+        const auto invRotInertiaB = bundle.invRotInertiaB[lane];
+        const auto old0 = p0.normalImpulse[lane];
+        const auto old1 = p1.normalImpulse[lane];
+
+        // Normal velocities at the points for the given velocities.
+        const auto getVn0 = [&](Real vAX, Real vAY, Real wA, Real vBX, Real vBY, Real wB) {
+            return (vBX - p0.relBY[lane] * wB - vAX + p0.relAY[lane] * wA) * nX
+                 + (vBY + p0.relBX[lane] * wB - vAY - p0.relAX[lane] * wA) * nY;
+        };
+        const auto getVn1 = [&](Real vAX, Real vAY, Real wA, Real vBX, Real vBY, Real wB) {
+            return (vBX - p1.relBY[lane] * wB - vAX + p1.relAY[lane] * wA) * nX
+                 + (vBY + p1.relBX[lane] * wB - vAY - p1.relAX[lane] * wA) * nY;
+        };
+
+        // Sequential solution: point 1, if active, then point 0.
+        auto sAX = v.linearAX[lane];
+        auto sAY = v.linearAY[lane];
+        auto sWA = v.angularA[lane];
+        auto sBX = v.linearBX[lane];
+        auto sBY = v.linearBY[lane];
+        auto sWB = v.angularB[lane];
+        const auto vn1 = getVn1(sAX, sAY, sWA, sBX, sBY, sWB);
+        const auto lambda1 = p1.normalMass[lane] * (p1.velocityBias[lane] - vn1);
+        const auto inc1 = (std::max(old1 + lambda1, Real(0)) - old1) * p1.active[lane];
+        sAX -= invMassA * inc1 * nX;
+        sAY -= invMassA * inc1 * nY;
+        sWA -= invRotInertiaA * inc1 * (p1.relAX[lane] * nY - p1.relAY[lane] * nX);
+        sBX += invMassB * inc1 * nX;
+        sBY += invMassB * inc1 * nY;
+        sWB += invRotInertiaB * inc1 * (p1.relBX[lane] * nY - p1.relBY[lane] * nX);
+        const auto vn0 = getVn0(sAX, sAY, sWA, sBX, sBY, sWB);
+        const auto lambda0 = p0.normalMass[lane] * (p0.velocityBias[lane] - vn0);
+        const auto inc0 = (std::max(old0 + lambda0, Real(0)) - old0) * p0.active[lane];
+        sAX -= invMassA * inc0 * nX;
+        sAY -= invMassA * inc0 * nY;
+        sWA -= invRotInertiaA * inc0 * (p0.relAX[lane] * nY - p0.relAY[lane] * nX);
+        sBX += invMassB * inc0 * nX;
+        sBY += invMassB * inc0 * nY;
+        sWB += invRotInertiaB * inc0 * (p0.relBX[lane] * nY - p0.relBY[lane] * nX);
+        const auto seqMax = std::max(std::abs(inc0), std::abs(inc1));
+
+        // Block solution: first valid case of the total enumeration of the mini LCP.
+        const auto b0 = getVn0(v.linearAX[lane], v.linearAY[lane], v.angularA[lane],
+                               v.linearBX[lane], v.linearBY[lane], v.angularB[lane])
+                      - p0.velocityBias[lane] - (bundle.k11[lane] * old0 + bundle.k12[lane] * old1);
+        const auto b1 = getVn1(v.linearAX[lane], v.linearAY[lane], v.angularA[lane],
+                               v.linearBX[lane], v.linearBY[lane], v.angularB[lane])
+                      - p1.velocityBias[lane] - (bundle.k12[lane] * old0 + bundle.k22[lane] * old1);
+        const auto case1X0 = -(bundle.normalMass11[lane] * b0 + bundle.normalMass12[lane] * b1);
+        const auto case1X1 = -(bundle.normalMass12[lane] * b0 + bundle.normalMass22[lane] * b1);
+        const auto case1 = (case1X0 >= Real(0)) && (case1X1 >= Real(0));
+        const auto case2X0 = -p0.normalMass[lane] * b0;
+        const auto case2 = (case2X0 >= Real(0)) && ((bundle.k12[lane] * case2X0 + b1) >= Real(0));
+        const auto case3X1 = -p1.normalMass[lane] * b1;
+        const auto case3 = (case3X1 >= Real(0)) && ((bundle.k12[lane] * case3X1 + b0) >= Real(0));
+        const auto case4 = (b0 >= Real(0)) && (b1 >= Real(0));
+        const auto solved = case1 || case2 || case3 || case4;
+        const auto x0 = case1? case1X0: case2? case2X0: case3? Real(0): case4? Real(0): old0;
+        const auto x1 = case1? case1X1: case2? Real(0): case3? case3X1: case4? Real(0): old1;
+        const auto d0 = x0 - old0;
+        const auto d1 = x1 - old1;
+        const auto PX = (d0 + d1) * nX;
+        const auto PY = (d0 + d1) * nY;
+        const auto LA = (p0.relAX[lane] * d0 + p1.relAX[lane] * d1) * nY
+                      - (p0.relAY[lane] * d0 + p1.relAY[lane] * d1) * nX;
+        const auto LB = (p0.relBX[lane] * d0 + p1.relBX[lane] * d1) * nY
+                      - (p0.relBY[lane] * d0 + p1.relBY[lane] * d1) * nX;
+        const auto blockMax = solved? std::max(std::abs(x0), std::abs(x1)): Real(0);
+
+        const auto useBlock = bundle.blockSolve[lane] != Real(0);
+        v.linearAX[lane] = useBlock? v.linearAX[lane] - invMassA * PX: sAX;
+        v.linearAY[lane] = useBlock? v.linearAY[lane] - invMassA * PY: sAY;
+        v.angularA[lane] = useBlock? v.angularA[lane] - invRotInertiaA * LA: sWA;
+        v.linearBX[lane] = useBlock? v.linearBX[lane] + invMassB * PX: sBX;
+        v.linearBY[lane] = useBlock? v.linearBY[lane] + invMassB * PY: sBY;
+        v.angularB[lane] = useBlock? v.angularB[lane] + invRotInertiaB * LB: sWB;
+        p0.normalImpulse[lane] = useBlock? x0: old0 + inc0;
+        p1.normalImpulse[lane] = useBlock? x1: old1 + inc1;
+        maxIncImpulse[lane] = std::max(maxIncImpulse[lane], useBlock? blockMax: seqMax);
+    }
+}
+
+} // anonymous namespace
+
+WideVelocityConstraints::WideVelocityConstraints(const Span<const VelocityConstraint>& constraints,
+                                                 const Span<const BodyConstraint>& bodies)
+{
+    Assign(constraints, bodies);
+}
+
+void WideVelocityConstraints::Assign(const Span<const VelocityConstraint>& constraints,
+                                     const Span<const BodyConstraint>& bodies)
+{
+    Clear();
+    m_bundles.reserve(size(constraints) / Width + 1u);
+    auto open = std::vector<std::size_t>{};
+    for (auto i = std::size_t{0}; i < size(constraints); ++i) {
+        const auto& vc = constraints[i];
+        const auto& bodyA = bodies[to_underlying(vc.GetBodyA())];
+        const auto& bodyB = bodies[to_underlying(vc.GetBodyB())];
+        const auto movableA = IsMovable(StripUnit(bodyA.GetInvMass()),
+                                        StripUnit(bodyA.GetInvRotInertia()))
+                            ? vc.GetBodyA(): InvalidBodyID;
+        const auto movableB = IsMovable(StripUnit(bodyB.GetInvMass()),
+                                        StripUnit(bodyB.GetInvRotInertia()))
+                            ? vc.GetBodyB(): InvalidBodyID;
+        auto found = std::find_if(begin(open), end(open), [&](std::size_t index) {
+            return !IsConflicting(m_bundles[index], movableA, movableB);
+        });
+        if (found == end(open)) {
+            if (size(open) == MaxOpenBundles) {
+                open.erase(begin(open));
+            }
+            m_bundles.push_back(Bundle{});
+            found = open.insert(end(open), size(m_bundles) - 1u);
+        }
+        auto& bundle = m_bundles[*found];
+        AddLane(bundle, i, vc, bodies);
+        if (bundle.count == Width) {
+            open.erase(found);
+        }
+    }
+}
+
+void WideVelocityConstraints::Clear() noexcept
+{
+    m_bundles.clear();
+}
+
+Momentum WideVelocityConstraints::Solve(const Span<BodyConstraint>& bodies)
+{
+    auto maxIncImpulse = Real(0);
+    for (auto& bundle: m_bundles) {
+        auto v = Velocities{};
+        for (auto lane = std::size_t{0}; lane < bundle.count; ++lane) {
+            const auto velA = bodies[to_underlying(bundle.bodyA[lane])].GetVelocity();
+            const auto velB = bodies[to_underlying(bundle.bodyB[lane])].GetVelocity();
+            v.linearAX[lane] = StripUnit(get<0>(velA.linear));
+            v.linearAY[lane] = StripUnit(get<1>(velA.linear));
+            v.angularA[lane] = StripUnit(velA.angular);
+            v.linearBX[lane] = StripUnit(get<0>(velB.linear));
+            v.linearBY[lane] = StripUnit(get<1>(velB.linear));
+            v.angularB[lane] = StripUnit(velB.angular);
+        }
+
+        // Same order as GaussSeidel::SolveVelocityConstraint: friction and then restitution.
+        auto laneMaxIncImpulse = Lanes{};
+        SolveTangentPoint(bundle, bundle.points[1], v, laneMaxIncImpulse);
+        SolveTangentPoint(bundle, bundle.points[0], v, laneMaxIncImpulse);
+        SolveNormal(bundle, v, laneMaxIncImpulse);
+
+        for (auto lane = std::size_t{0}; lane < bundle.count; ++lane) {
+            bodies[to_underlying(bundle.bodyA[lane])].SetVelocity(Velocity{
+                LinearVelocity2{v.linearAX[lane] * MeterPerSecond,
+                                v.linearAY[lane] * MeterPerSecond},
+                v.angularA[lane] * RadianPerSecond});
+            bodies[to_underlying(bundle.bodyB[lane])].SetVelocity(Velocity{
+                LinearVelocity2{v.linearBX[lane] * MeterPerSecond,
+                                v.linearBY[lane] * MeterPerSecond},
+                v.angularB[lane] * RadianPerSecond});
+            maxIncImpulse = std::max(maxIncImpulse, laneMaxIncImpulse[lane]);
+        }
+    }
+    return maxIncImpulse * NewtonSecond;
+}
+
+void WideVelocityConstraints::Store(const Span<VelocityConstraint>& constraints) const
+{
+    for (const auto& bundle: m_bundles) {
+        for (auto lane = std::size_t{0}; lane < bundle.count; ++lane) {
+            auto& vc = constraints[bundle.constraints[lane]];
+            const auto pointCount = vc.GetPointCount();
+            for (auto i = VelocityConstraint::size_type{0}; i < pointCount; ++i) {
+                const auto& point = bundle.points[i];
+                vc.SetNormalImpulseAtPoint(i, point.normalImpulse[lane] * NewtonSecond);
+                vc.SetTangentImpulseAtPoint(i, point.tangentImpulse[lane] * NewtonSecond);
+            }
+        }
+    }
+}
+
+} // namespace playrho::d2
@@ -115,51 +115,39 @@ AngularAcceleration GetAngularAcceleration(const World& world, BodyID id)
 
 Acceleration GetAcceleration(const World& world, BodyID id)
 {
-    const auto body = GetBody(world, id);
+    const auto& body = GetBody(world, id);
     return Acceleration{GetLinearAcceleration(body), GetAngularAcceleration(body)};
 }
 
 void SetAcceleration(World& world, BodyID id,
                      const LinearAcceleration2& linear, AngularAcceleration angular)
 {
-    auto body = GetBody(world, id);
-    SetAcceleration(body, linear, angular);
-    SetBody(world, id, body);
+    SetAcceleration(world, id, Acceleration{linear, angular});
 }
 
 void SetAcceleration(World& world, BodyID id, const LinearAcceleration2& value)
 {
-    auto body = GetBody(world, id);
-    SetAcceleration(body, value);
-    SetBody(world, id, body);
+    SetAcceleration(world, id, Acceleration{value, GetAngularAcceleration(world, id)});
 }
 
 void SetAcceleration(World& world, BodyID id, AngularAcceleration value)
 {
-    auto body = GetBody(world, id);
-    SetAcceleration(body, value);
-    SetBody(world, id, body);
+    SetAcceleration(world, id, Acceleration{GetLinearAcceleration(world, id), value});
 }
 
 void SetAcceleration(World& world, BodyID id, const Acceleration& value)
 {
-    auto body = GetBody(world, id);
-    SetAcceleration(body, value);
-    SetBody(world, id, body);
+    world.m_impl->SetAcceleration_(id, value);
 }
 
 void SetTransformation(World& world, BodyID id, const Transformation& value)
 {
-    auto body = GetBody(world, id);
-    SetTransformation(body, value);
-    SetBody(world, id, body);
+    world.m_impl->SetTransformation_(id, value);
 }
 
 void SetLocation(World& world, BodyID id, const Length2& value)
 {
-    auto body = GetBody(world, id);
-    SetLocation(body, value);
-    SetBody(world, id, body);
+    SetTransformation(world, id, Transformation{value, GetTransformation(world, id).q});
 }
 
 void SetAngle(World& world, BodyID id, Angle value)
@@ -262,23 +250,17 @@ Velocity GetVelocity(const World& world, BodyID id)
 
 void SetVelocity(World& world, BodyID id, const Velocity& value)
 {
-    auto body = GetBody(world, id);
-    SetVelocity(body, value);
-    SetBody(world, id, body);
+    world.m_impl->SetVelocity_(id, value);
 }
 
 void SetVelocity(World& world, BodyID id, const LinearVelocity2& value)
 {
-    auto body = GetBody(world, id);
-    SetVelocity(body, Velocity{value, GetAngularVelocity(body)});
-    SetBody(world, id, body);
+    SetVelocity(world, id, Velocity{value, GetAngularVelocity(GetBody(world, id))});
 }
 
 void SetVelocity(World& world, BodyID id, AngularVelocity value)
 {
-    auto body = GetBody(world, id);
-    SetVelocity(body, Velocity{GetLinearVelocity(body), value});
-    SetBody(world, id, body);
+    SetVelocity(world, id, Velocity{GetLinearVelocity(GetBody(world, id)), value});
 }
 
 bool IsEnabled(const World& world, BodyID id)
@@ -288,6 +270,7 @@ bool IsEnabled(const World& world, BodyID id)
 
 void SetEnabled(World& world, BodyID id, bool value)
 {
+    // Proxies get created or destroyed for this, so it goes through SetBody.
     auto body = GetBody(world, id);
     SetEnabled(body, value);
     SetBody(world, id, body);
@@ -300,16 +283,12 @@ bool IsAwake(const World& world, BodyID id)
 
 void SetAwake(World& world, BodyID id)
 {
-    auto body = GetBody(world, id);
-    SetAwake(body);
-    SetBody(world, id, body);
+    world.m_impl->SetAwake_(id, true);
 }
 
 void UnsetAwake(World& world, BodyID id)
 {
-    auto body = GetBody(world, id);
-    UnsetAwake(body);
-    SetBody(world, id, body);
+    world.m_impl->SetAwake_(id, false);
 }
 
 bool IsMassDataDirty(const World& world, BodyID id)
@@ -416,16 +395,12 @@ bool IsImpenetrable(const World& world, BodyID id)
 
 void SetImpenetrable(World& world, BodyID id)
 {
-    auto body = GetBody(world, id);
-    SetImpenetrable(body);
-    SetBody(world, id, body);
+    world.m_impl->SetImpenetrable_(id, true);
 }
 
 void UnsetImpenetrable(World& world, BodyID id)
 {
-    auto body = GetBody(world, id);
-    UnsetImpenetrable(body);
-    SetBody(world, id, body);
+    world.m_impl->SetImpenetrable_(id, false);
 }
 
 bool IsSleepingAllowed(const World& world, BodyID id)
@@ -435,9 +410,7 @@ bool IsSleepingAllowed(const World& world, BodyID id)
 
 void SetSleepingAllowed(World& world, BodyID id, bool value)
 {
-    auto body = GetBody(world, id);
-    SetSleepingAllowed(body, value);
-    SetBody(world, id, body);
+    world.m_impl->SetSleepingAllowed_(id, value);
 }
 
 Frequency GetLinearDamping(const World& world, BodyID id)
@@ -483,7 +456,7 @@ Force2 GetCentripetalForce(const World& world, BodyID id, const Length2& axis)
 void ApplyForce(World& world, BodyID id, const Force2& force, const Length2& point)
 {
     // Torque is L^2 M T^-2 QP^-1.
-    const auto body = GetBody(world, id);
+    const auto& body = GetBody(world, id);
     const auto linAccel = LinearAcceleration2{force * GetInvMass(body)};
     const auto invRotI = GetInvRotInertia(body); // L^-2 M^-1 QP^2
     const auto dp = Length2{point - GetWorldCenter(body)}; // L
@@ -505,16 +478,12 @@ void ApplyTorque(World& world, BodyID id, Torque torque)
 
 void ApplyLinearImpulse(World& world, BodyID id, const Momentum2& impulse, const Length2& point)
 {
-    auto body = GetBody(world, id);
-    ApplyLinearImpulse(body, impulse, point);
-    SetBody(world, id, body);
+    world.m_impl->ApplyLinearImpulse_(id, impulse, point);
 }
 
 void ApplyAngularImpulse(World& world, BodyID id, AngularMomentum impulse)
 {
-    auto body = GetBody(world, id);
-    ApplyAngularImpulse(body, impulse);
-    SetBody(world, id, body);
+    world.m_impl->ApplyAngularImpulse_(id, impulse);
 }
 
 void SetForce(World& world, BodyID id, const Force2& force, const Length2& point)
@@ -19,12 +19,18 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 
+#include <optional>
+#include <vector>
+
 #include <playrho/MovementConf.hpp>
 #include <playrho/StepConf.hpp>
+#include <playrho/to_underlying.hpp>
 
+#include <playrho/d2/DynamicTree.hpp>
 #include <playrho/d2/World.hpp>
 #include <playrho/d2/WorldBody.hpp>
 #include <playrho/d2/WorldMisc.hpp>
+#include <playrho/d2/WorldShape.hpp>
 
 namespace playrho::d2 {
 
@@ -44,4 +50,34 @@ StepStats Step(World &world, Time delta, TimestepIters velocityIterations,
     return Step(world, conf);
 }
 
+std::size_t Query(const World& world, const Span<const AABB>& aabbs, const Filter& filter,
+                  const Span<ShapeQueryHit>& hits)
+{
+    const auto& tree = GetTree(world);
+    // Dense cache of the filters of the shapes hit so far, indexed by shape identifier...
+    auto filters = std::vector<std::optional<Filter>>(GetShapeRange(world));
+    const auto getFilter = [&world,&filters](ShapeID id) -> const Filter& {
+        auto& cached = filters[to_underlying(id)];
+        if (!cached) {
+            cached = GetFilterData(world, id);
+        }
+        return *cached;
+    };
+    auto count = std::size_t{0};
+    for (auto query = std::size_t{0}; query < aabbs.size(); ++query) {
+        QueryLeafs(tree, tree.GetRootIndex(), aabbs[query], [&](DynamicTree::Size index) {
+            const auto leafData = tree.GetLeafData(index);
+            if (ShouldCollide(filter, getFilter(leafData.shapeId))) {
+                if (count < hits.size()) {
+                    hits[count] = ShapeQueryHit{query, leafData.bodyId, leafData.shapeId,
+                                                leafData.childId};
+                }
+                ++count;
+            }
+            return DynamicTreeOpcode::Continue;
+        });
+    }
+    return count;
+}
+
 } // namespace playrho::d2
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <algorithm> // for std::max
+#include <cassert> // for assert
+#include <memory> // for std::align
+
+#include <playrho/pmr/MonotonicMemoryResource.hpp>
+
+namespace playrho::pmr {
+
+static_assert(MonotonicMemoryOptions{}.reserveBytes == 0u);
+
+namespace {
+
+/// @brief Minimum number of bytes to allocate from upstream at a time.
+constexpr auto MinBlockBytes = std::size_t{1024u};
+
+/// @brief Alignment of blocks allocated from upstream.
+constexpr auto BlockAlignment = alignof(std::max_align_t);
+
+/// @brief Gets the given size rounded up to a multiple of the given alignment.
+constexpr std::size_t RoundUp(std::size_t num_bytes, std::size_t alignment = BlockAlignment) noexcept
+{
+    return ((num_bytes + alignment - 1u) / alignment) * alignment;
+}
+
+} // anonymous namespace
+
+MonotonicMemoryResource::MonotonicMemoryResource(const MonotonicMemoryOptions& options,
+                                                 memory_resource* upstream)
+    : m_options{options},
+      m_upstream{upstream ? upstream : new_delete_resource()}
+{
+    if (m_options.reserveBytes > 0u) {
+        AllocateBlock(m_options.reserveBytes);
+    }
+}
+
+MonotonicMemoryResource::~MonotonicMemoryResource() noexcept
+{
+    DeallocateBlocks();
+}
+
+MonotonicMemoryResource::Stats MonotonicMemoryResource::GetStats() const noexcept
+{
+    Stats stats;
+    stats.numBlocks = size(m_blocks);
+    for (const auto& block: m_blocks) {
+        stats.totalBytes += block.size;
+    }
+    stats.usedBytes = m_usedBytes;
+    stats.maxUsedBytes = m_maxUsedBytes;
+    stats.upstreamAllocations = m_upstreamAllocations;
+    return stats;
+}
+
+void MonotonicMemoryResource::Release()
+{
+    m_offset = 0u;
+    m_usedBytes = 0u;
+    if (size(m_blocks) > 1u) {
+        // Consolidate into one block big enough for everything that's been needed so far.
+        DeallocateBlocks();
+        AllocateBlock(m_maxUsedBytes); // could throw!
+    }
+}
+
+MonotonicMemoryResource::Block& MonotonicMemoryResource::AllocateBlock(std::size_t num_bytes)
+{
+    m_blocks.reserve(size(m_blocks) + 1u); // could throw!
+    const auto bytes = RoundUp(num_bytes);
+    auto* p = m_upstream->allocate(bytes, BlockAlignment); // could throw!
+    ++m_upstreamAllocations;
+    m_offset = 0u;
+    return m_blocks.emplace_back(Block{static_cast<std::byte*>(p), bytes});
+}
+
+void MonotonicMemoryResource::DeallocateBlocks() noexcept
+{
+    for (const auto& block: m_blocks) {
+        // Deallocate should not throw in this context of having previously allocated
+        // this memory. If it does, fail fast!
+        m_upstream->deallocate(block.data, block.size, BlockAlignment);
+    }
+    m_blocks.clear();
+    m_offset = 0u;
+}
+
+void *MonotonicMemoryResource::do_allocate(std::size_t num_bytes, std::size_t alignment)
+{
+    if (empty(m_blocks) || ((m_blocks.back().size - m_offset) < num_bytes)) {
+        const auto last = empty(m_blocks)? std::size_t{0}: m_blocks.back().size;
+        const auto padding = (alignment > BlockAlignment)? alignment: std::size_t{0};
+        AllocateBlock(std::max({num_bytes + padding, last * 2u, MinBlockBytes})); // could throw!
+    }
+    auto* block = &m_blocks.back();
+    auto* p = static_cast<void*>(block->data + m_offset);
+    auto space = block->size - m_offset;
+    if (!std::align(alignment, num_bytes, p, space)) {
+        // Only alignment padding kept this from fitting, so a new block will always do.
+        const auto padding = (alignment > BlockAlignment)? alignment: std::size_t{0};
+        block = &AllocateBlock(std::max({num_bytes + padding, block->size * 2u})); // could throw!
+        p = block->data;
+        space = block->size;
+        [[maybe_unused]] const auto aligned = std::align(alignment, num_bytes, p, space);
+        assert(aligned);
+    }
+    m_offset = static_cast<std::size_t>(static_cast<std::byte*>(p) - block->data) + num_bytes;
+    // Count bytes used as though all allocations since the last release were in one block,
+    // so that a block of the max used size fits them all the same way when done again.
+    m_usedBytes = (alignment > BlockAlignment)
+        ? m_usedBytes + alignment + num_bytes
+        : RoundUp(m_usedBytes, alignment) + num_bytes;
+    m_maxUsedBytes = std::max(m_maxUsedBytes, m_usedBytes);
+    return p;
+}
+
+void MonotonicMemoryResource::do_deallocate(void *, std::size_t, std::size_t)
+{
+    // Intentionally empty.
+}
+
+bool MonotonicMemoryResource::do_is_equal(const memory_resource &other) const noexcept
+{
+    return &other == this;
+}
+
+std::ostream& operator<<(std::ostream& os, const MonotonicMemoryResource::Stats& stats)
+{
+    os << "{";
+    os << "total-bytes=" << stats.totalBytes;
+    os << ", num-blocks=" << stats.numBlocks;
+    os << ", used-bytes=" << stats.usedBytes;
+    os << ", max-used-bytes=" << stats.maxUsedBytes;
+    os << ", upstream-allocs=" << stats.upstreamAllocations;
+    os << "}";
+    return os;
+}
+
+} // namespace playrho::pmr
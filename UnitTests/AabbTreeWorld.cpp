@@ -18,12 +18,19 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
 #include <type_traits>
 
+#include <playrho/ChromeTracer.hpp>
 #include <playrho/Contact.hpp>
 #include <playrho/LengthError.hpp>
 #include <playrho/OutOfRange.hpp>
 #include <playrho/StepConf.hpp>
+#include <playrho/TaskScheduler.hpp>
 #include <playrho/to_underlying.hpp>
 #include <playrho/WrongState.hpp>
 
@@ -54,13 +61,45 @@
 #include <playrho/d2/GearJointConf.hpp>
 #include <playrho/d2/World.hpp>
 
-#include "gtest/gtest.h"
+#include "UnitTests.hpp"
 
 using namespace playrho;
 using namespace playrho::d2;
 
 namespace {
 
+/// @brief Task scheduler that runs all but the first task on their own threads.
+class ThreadedScheduler: public TaskScheduler
+{
+public:
+    explicit ThreadedScheduler(size_type concurrency): m_concurrency{concurrency} {}
+
+    size_type GetConcurrency() const noexcept override
+    {
+        return m_concurrency;
+    }
+
+    void Run(const Span<const Task>& tasks) override
+    {
+        ++runs;
+        auto threads = std::vector<std::thread>{};
+        for (auto i = size_type{1}; i < size(tasks); ++i) {
+            threads.emplace_back(tasks[i]);
+        }
+        if (!empty(tasks)) {
+            tasks[0]();
+        }
+        for (auto& thread: threads) {
+            thread.join();
+        }
+    }
+
+    int runs{};
+
+private:
+    size_type m_concurrency{};
+};
+
 template <typename T, class Exception = void>
 struct PushBackListener
 {
@@ -734,11 +773,98 @@ TEST(AabbTreeWorld, Proxies)
         ASSERT_EQ(GetProxies(world, body).size(), 4u);
         EXPECT_EQ(GetProxies(world, body)[0], 0u);
         EXPECT_EQ(GetProxies(world, body)[1], 1u);
-        EXPECT_EQ(GetProxies(world, body)[2], 3u);
-        EXPECT_EQ(GetProxies(world, body)[3], 5u);
+        EXPECT_EQ(GetProxies(world, body)[2], 2u);
+        EXPECT_EQ(GetProxies(world, body)[3], 3u);
     }
 }
 
+TEST(AabbTreeWorld, ProxiesBulkLoaded)
+{
+    auto world = AabbTreeWorld{};
+    const auto shapeId = CreateShape(world, Shape{DiskShapeConf(0.5_m)});
+    auto bodies = std::vector<BodyID>{};
+    for (auto i = 0; i < 200; ++i) {
+        const auto location = Length2{static_cast<Real>(i % 20) * 2_m,
+                                      static_cast<Real>(i / 20) * 2_m};
+        bodies.push_back(CreateBody(world, BodyConf{}.UseLocation(location)));
+        ASSERT_NO_THROW(Attach(world, bodies.back(), shapeId));
+    }
+    ASSERT_EQ(GetFixturesForProxies(world).size(), 200u);
+
+    auto stepStats = StepStats{};
+    ASSERT_NO_THROW(stepStats = Step(world, StepConf{}));
+    EXPECT_EQ(stepStats.pre.proxiesCreated, 200u);
+    EXPECT_EQ(GetFixturesForProxies(world).size(), 0u);
+    const auto& tree = GetTree(world);
+    EXPECT_EQ(tree.GetLeafCount(), 200u);
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+    for (const auto& body: bodies) {
+        ASSERT_EQ(GetProxies(world, body).size(), 1u);
+        const auto leafData = tree.GetLeafData(GetProxies(world, body)[0]);
+        EXPECT_EQ(leafData.bodyId, body);
+        EXPECT_EQ(leafData.shapeId, shapeId);
+    }
+
+    // Incrementally adding a shape to a loaded world still works...
+    const auto body = CreateBody(world, BodyConf{}.UseLocation(Length2{-4_m, -4_m}));
+    ASSERT_NO_THROW(Attach(world, body, shapeId));
+    ASSERT_NO_THROW(stepStats = Step(world, StepConf{}));
+    EXPECT_EQ(stepStats.pre.proxiesCreated, 1u);
+    EXPECT_EQ(tree.GetLeafCount(), 201u);
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    ASSERT_EQ(GetProxies(world, body).size(), 1u);
+    EXPECT_EQ(tree.GetLeafData(GetProxies(world, body)[0]).bodyId, body);
+}
+
+TEST(AabbTreeWorld, ProxiesPartitionedByBodyType)
+{
+    using Partition = DynamicTree::Partition;
+    auto world = AabbTreeWorld{};
+    const auto shapeId = CreateShape(world, Shape{DiskShapeConf(1_m)});
+    auto staticBodies = std::vector<BodyID>{};
+    for (auto i = 0; i < 10; ++i) {
+        const auto location = Length2{static_cast<Real>(i) * 1.5_m, 0_m};
+        staticBodies.push_back(CreateBody(world, BodyConf{}.UseLocation(location)));
+        ASSERT_NO_THROW(Attach(world, staticBodies.back(), shapeId));
+    }
+    const auto dynamicBody = CreateBody(world, BodyConf{}.Use(BodyType::Dynamic)
+                                        .UseLocation(Length2{3_m, 1_m}));
+    ASSERT_NO_THROW(Attach(world, dynamicBody, shapeId));
+
+    auto stepConf = StepConf{};
+    stepConf.deltaTime = 0_s;
+    ASSERT_NO_THROW(Step(world, stepConf));
+    const auto& tree = GetTree(world);
+    EXPECT_EQ(tree.GetLeafCount(Partition::Static), 10u);
+    EXPECT_EQ(tree.GetLeafCount(Partition::Dynamic), 1u);
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+    for (const auto& body: staticBodies) {
+        ASSERT_EQ(GetProxies(world, body).size(), 1u);
+        EXPECT_EQ(tree.GetPartition(GetProxies(world, body)[0]), Partition::Static);
+    }
+    ASSERT_EQ(GetProxies(world, dynamicBody).size(), 1u);
+    const auto proxy = GetProxies(world, dynamicBody)[0];
+    EXPECT_EQ(tree.GetPartition(proxy), Partition::Dynamic);
+
+    // Contacts only between the dynamic body and the static ones it overlaps.
+    EXPECT_EQ(GetContacts(world).size(), 3u);
+
+    SetType(world, dynamicBody, BodyType::Static);
+    ASSERT_EQ(GetProxies(world, dynamicBody).size(), 1u);
+    EXPECT_EQ(GetProxies(world, dynamicBody)[0], proxy);
+    EXPECT_EQ(tree.GetPartition(proxy), Partition::Static);
+    EXPECT_EQ(tree.GetLeafCount(Partition::Static), 11u);
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+
+    SetType(world, dynamicBody, BodyType::Kinematic);
+    EXPECT_EQ(tree.GetPartition(proxy), Partition::Dynamic);
+    EXPECT_EQ(tree.GetLeafCount(Partition::Dynamic), 1u);
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+}
+
 TEST(AabbTreeWorld, SetEnabledBody)
 {
     auto stepConf = StepConf{};
@@ -1185,6 +1311,31 @@ TEST(AabbTreeWorld, SetShapeWithGeometryChange)
     EXPECT_EQ(size(GetProxies(world, bodyId)), 3u);
 }
 
+TEST(AabbTreeWorld, CopyCollidesAfterOriginalGone)
+{
+    auto copy = std::optional<AabbTreeWorld>{};
+    auto bodyId = InvalidBodyID;
+    {
+        auto world = AabbTreeWorld{};
+        const auto groundShape = CreateShape(world, Shape{EdgeShapeConf{Length2{-10_m, 0_m},
+                                                                        Length2{+10_m, 0_m}}});
+        const auto diskShape = CreateShape(world, Shape{DiskShapeConf{0.5_m}});
+        CreateBody(world, Body{BodyConf{}.Use(BodyType::Static).Use(groundShape)});
+        bodyId = CreateBody(world, Body{BodyConf{}.Use(BodyType::Dynamic)
+            .UseLocation(Length2{0_m, 0.45_m}).Use(diskShape)});
+        ASSERT_NO_THROW(Step(world, StepConf{}));
+        copy.emplace(world);
+        ASSERT_NO_THROW(Destroy(world, diskShape));
+        ASSERT_NO_THROW(Destroy(world, groundShape));
+    }
+    auto stepConf = StepConf{};
+    for (auto i = 0; i < 10; ++i) {
+        ASSERT_NO_THROW(Step(*copy, stepConf));
+    }
+    EXPECT_FALSE(empty(GetContacts(*copy, bodyId)));
+    EXPECT_GT(GetLocation(GetBody(*copy, bodyId))[1], 0.4_m);
+}
+
 TEST(AabbTreeWorld, CreateEmptyShapeThrows)
 {
     auto world = AabbTreeWorld{};
@@ -1345,3 +1496,292 @@ TEST(AabbTreeWorld, GetSoonestContact)
     ids.emplace_back(ContactKey(), ContactID(3));
     EXPECT_EQ(GetSoonestContact(ids, contacts), ContactID(2));
 }
+
+TEST(AabbTreeWorld, StepWithTaskSchedulerSameAsWithout)
+{
+    auto scheduler = ThreadedScheduler{4u};
+    auto serialWorld = AabbTreeWorld{};
+    auto threadedWorld = AabbTreeWorld{WorldConf{}.UseTaskScheduler(&scheduler)};
+    for (auto world: {&serialWorld, &threadedWorld}) {
+        const auto box = CreateShape(*world, Shape{PolygonShapeConf{}.SetAsBox(0.5_m, 0.5_m)});
+        CreateBodiesOnGround(*world, 40_m, box, GetGridLocations(8, 5, [](int i, int j) {
+            return Length2{(i * 8 - 28) * 1_m, (j * 1.1f + 0.6f) * 1_m};
+        }));
+    }
+    const auto stepConf = StepConf{};
+    auto maxIslands = 0u;
+    for (auto step = 0; step < 100; ++step) {
+        const auto serialStats = Step(serialWorld, stepConf);
+        const auto threadedStats = Step(threadedWorld, stepConf);
+        EXPECT_EQ(serialStats.reg.islandsFound, threadedStats.reg.islandsFound);
+        EXPECT_EQ(serialStats.reg.bodiesSlept, threadedStats.reg.bodiesSlept);
+        maxIslands = std::max(maxIslands, static_cast<unsigned>(threadedStats.reg.islandsFound));
+    }
+    EXPECT_GT(maxIslands, 1u);
+    EXPECT_GT(scheduler.runs, 0);
+    ASSERT_EQ(size(GetBodies(serialWorld)), size(GetBodies(threadedWorld)));
+    for (const auto& id: GetBodies(serialWorld)) {
+        const auto& serialBody = GetBody(serialWorld, id);
+        const auto& threadedBody = GetBody(threadedWorld, id);
+        EXPECT_EQ(GetTransformation(serialBody), GetTransformation(threadedBody));
+        EXPECT_EQ(GetVelocity(serialBody), GetVelocity(threadedBody));
+    }
+}
+
+TEST(AabbTreeWorld, ColoredIslandSolveWithTaskScheduler)
+{
+    auto scheduler = ThreadedScheduler{4u};
+    auto serialWorld = AabbTreeWorld{};
+    auto coloredWorld = AabbTreeWorld{WorldConf{}.UseTaskScheduler(&scheduler)};
+    for (auto world: {&serialWorld, &coloredWorld}) {
+        const auto box = CreateShape(*world, Shape{PolygonShapeConf{}.SetAsBox(0.5_m, 0.5_m)});
+        // A pyramid of boxes touching each other makes one big island.
+        constexpr auto baseCount = 16;
+        auto locations = std::vector<Length2>{};
+        for (auto row = 0; row < baseCount; ++row) {
+            for (auto col = 0; col < baseCount - row; ++col) {
+                locations.push_back(Length2{(col - (baseCount - row) * 0.5f) * 1_m,
+                                            (row + 0.5f) * 1_m});
+            }
+        }
+        // The bottom row's boxes are the first ones created.
+        const auto boxes = CreateBodiesOnGround(*world, 40_m, box, locations);
+        for (auto i = 1; i < baseCount; ++i) {
+            CreateJoint(*world, Joint{RevoluteJointConf{boxes[i - 1], boxes[i],
+                Length2{+0.5_m, -0.5_m}, Length2{-0.5_m, -0.5_m}}});
+        }
+    }
+    auto stepConf = StepConf{};
+    stepConf.doColoredIslandSolve = true;
+    for (auto step = 0; step < 60; ++step) {
+        const auto serialStats = Step(serialWorld, stepConf);
+        const auto coloredStats = Step(coloredWorld, stepConf);
+        EXPECT_EQ(serialStats.reg.islandsFound, coloredStats.reg.islandsFound);
+    }
+    EXPECT_GT(scheduler.runs, 0);
+    ASSERT_EQ(size(GetBodies(serialWorld)), size(GetBodies(coloredWorld)));
+    for (const auto& id: GetBodies(serialWorld)) {
+        const auto serial = GetLocation(GetBody(serialWorld, id));
+        const auto colored = GetLocation(GetBody(coloredWorld, id));
+        EXPECT_NEAR(static_cast<double>(Real{GetX(colored) / 1_m}),
+                    static_cast<double>(Real{GetX(serial) / 1_m}), 0.05);
+        EXPECT_NEAR(static_cast<double>(Real{GetY(colored) / 1_m}),
+                    static_cast<double>(Real{GetY(serial) / 1_m}), 0.05);
+    }
+}
+
+TEST(AabbTreeWorld, ContactListenersWithTaskSchedulerSameAsWithout)
+{
+    using Event = std::pair<char, ContactID>;
+    auto scheduler = ThreadedScheduler{3u};
+    auto serialWorld = AabbTreeWorld{};
+    auto threadedWorld = AabbTreeWorld{WorldConf{}.UseTaskScheduler(&scheduler)};
+    auto serialEvents = std::vector<Event>{};
+    auto threadedEvents = std::vector<Event>{};
+    for (auto [world, events]: {std::make_pair(&serialWorld, &serialEvents),
+                                std::make_pair(&threadedWorld, &threadedEvents)}) {
+        SetBeginContactListener(*world, [events](ContactID id) {
+            events->emplace_back('b', id);
+        });
+        SetEndContactListener(*world, [events](ContactID id) {
+            events->emplace_back('e', id);
+        });
+        SetPreSolveContactListener(*world, [events](ContactID id, const Manifold&) {
+            events->emplace_back('p', id);
+        });
+        const auto disk = CreateShape(*world, Shape{DiskShapeConf{0.5_m}.UseRestitution(0.5f)});
+        CreateBodiesOnGround(*world, 20_m, disk, GetGridLocations(20, 1, [](int i, int) {
+            return Length2{(i - 10) * 1.5_m, (i % 3 + 1) * 1_m};
+        }));
+    }
+    const auto stepConf = StepConf{};
+    for (auto step = 0; step < 60; ++step) {
+        Step(serialWorld, stepConf);
+        Step(threadedWorld, stepConf);
+    }
+    EXPECT_FALSE(empty(serialEvents));
+    EXPECT_EQ(serialEvents, threadedEvents);
+    for (const auto& id: GetBodies(serialWorld)) {
+        EXPECT_EQ(GetTransformation(GetBody(serialWorld, id)),
+                  GetTransformation(GetBody(threadedWorld, id)));
+    }
+}
+
+TEST(AabbTreeWorld, FindContactsWithTaskSchedulerSameAsWithout)
+{
+    auto scheduler = ThreadedScheduler{4u};
+    auto serialWorld = AabbTreeWorld{};
+    auto threadedWorld = AabbTreeWorld{WorldConf{}.UseTaskScheduler(&scheduler)};
+    for (auto world: {&serialWorld, &threadedWorld}) {
+        const auto disk = CreateShape(*world, Shape{DiskShapeConf{1_m}});
+        for (auto i = 0; i < 10; ++i) {
+            for (auto j = 0; j < 10; ++j) {
+                const auto id = CreateBody(*world, BodyConf{}
+                                           .Use(BodyType::Dynamic)
+                                           .UseLocation(Length2{i * 1.5_m, j * 1.5_m}));
+                Attach(*world, id, disk);
+            }
+        }
+    }
+    const auto stepConf = StepConf{};
+    for (auto step = 0; step < 5; ++step) {
+        const auto serialStats = Step(serialWorld, stepConf);
+        const auto threadedStats = Step(threadedWorld, stepConf);
+        EXPECT_EQ(serialStats.pre.contactsAdded, threadedStats.pre.contactsAdded);
+        EXPECT_EQ(serialStats.reg.contactsAdded, threadedStats.reg.contactsAdded);
+        EXPECT_EQ(GetContacts(serialWorld), GetContacts(threadedWorld));
+    }
+    EXPECT_FALSE(empty(GetContacts(threadedWorld)));
+}
+
+TEST(AabbTreeWorld, StepArena)
+{
+    auto arenaConf = WorldConf{};
+    arenaConf.doStepArena = true;
+    auto arenaWorld = AabbTreeWorld{arenaConf};
+    auto poolWorld = AabbTreeWorld{};
+    EXPECT_FALSE(GetStepArenaStats(poolWorld));
+    ASSERT_TRUE(GetStepArenaStats(arenaWorld));
+    for (auto world: {&arenaWorld, &poolWorld}) {
+        const auto box = CreateShape(*world, Shape{PolygonShapeConf{}.SetAsBox(0.5_m, 0.5_m)});
+        CreateBodiesOnGround(*world, 40_m, box, GetGridLocations(8, 5, [](int i, int j) {
+            return Length2{(i * 8 - 28) * 1_m, (j * 1.1f + 0.6f) * 1_m};
+        }));
+    }
+    const auto stepConf = StepConf{};
+    for (auto step = 0; step < 10; ++step) {
+        Step(arenaWorld, stepConf);
+        Step(poolWorld, stepConf);
+    }
+    const auto warmedUp = *GetStepArenaStats(arenaWorld);
+    EXPECT_GT(warmedUp.maxUsedBytes, 0u);
+    EXPECT_EQ(warmedUp.usedBytes, 0u);
+    EXPECT_EQ(warmedUp.numBlocks, 1u);
+    for (auto step = 0; step < 50; ++step) {
+        Step(arenaWorld, stepConf);
+        Step(poolWorld, stepConf);
+    }
+    EXPECT_EQ(GetStepArenaStats(arenaWorld)->upstreamAllocations, warmedUp.upstreamAllocations);
+    ASSERT_EQ(size(GetBodies(arenaWorld)), size(GetBodies(poolWorld)));
+    for (const auto& id: GetBodies(arenaWorld)) {
+        EXPECT_EQ(GetTransformation(GetBody(arenaWorld, id)), GetTransformation(GetBody(poolWorld, id)));
+    }
+
+    const auto copy = AabbTreeWorld{arenaWorld};
+    ASSERT_TRUE(GetStepArenaStats(copy));
+    EXPECT_EQ(GetStepArenaStats(copy)->usedBytes, 0u);
+}
+
+TEST(AabbTreeWorld, StepWithTracer)
+{
+    auto scheduler = ThreadedScheduler{4u};
+    auto tracer = ChromeTracer{};
+    auto world = AabbTreeWorld{WorldConf{}.UseTaskScheduler(&scheduler).UseTracer(&tracer)};
+    const auto disk = CreateShape(world, Shape{DiskShapeConf{1_m}});
+    for (auto i = 0; i < 10; ++i) {
+        for (auto j = 0; j < 10; ++j) {
+            const auto id = CreateBody(world, BodyConf{}
+                                       .Use(BodyType::Dynamic)
+                                       .UseLocation(Length2{i * 3_m, j * 3_m})
+                                       .UseLinearVelocity(LinearVelocity2{0_mps, -1_mps}));
+            Attach(world, id, disk);
+        }
+    }
+    EXPECT_EQ(tracer.GetEventCount(), 0u);
+    Step(world, StepConf{});
+
+    auto names = std::set<std::string>{};
+    auto lanes = std::map<std::uint32_t, std::vector<const char*>>{};
+    for (const auto& event: tracer.GetEvents()) {
+        names.insert(event.name);
+        auto& stack = lanes[event.lane];
+        if (event.phase == 'B') {
+            stack.push_back(event.name);
+        }
+        else {
+            ASSERT_EQ(event.phase, 'E');
+            ASSERT_FALSE(empty(stack));
+            EXPECT_EQ(std::string(stack.back()), std::string(event.name));
+            stack.pop_back();
+        }
+    }
+    for (const auto& lane: lanes) {
+        EXPECT_TRUE(empty(lane.second));
+    }
+    EXPECT_GT(size(lanes), 1u);
+    for (const auto& name: {"Step", "SolveReg", "SolveRegIsland", "SolveToi",
+                            "UpdateContacts", "FindContacts", "FindContactsTask"}) {
+        EXPECT_EQ(names.count(name), 1u) << name;
+    }
+    const auto events = tracer.GetEvents();
+    ASSERT_FALSE(empty(events));
+    EXPECT_EQ(std::string(events.front().name), "Step");
+    EXPECT_EQ(std::string(events.back().name), "Step");
+}
+
+TEST(AabbTreeWorld, BulletsAmongManyContactsDontTunnel)
+{
+    auto world = AabbTreeWorld{};
+    const auto box = CreateShape(world, Shape{PolygonShapeConf{}.SetAsBox(0.5_m, 0.5_m)});
+    CreateBodiesOnGround(world, 40_m, box, GetGridLocations(10, 4, [](int i, int j) {
+        return Length2{(i * 1.1f - 30) * 1_m, (j * 1.1f + 0.55f) * 1_m};
+    }));
+    const auto wall = CreateBody(world, BodyConf{}.Use(BodyType::Static));
+    Attach(world, wall, CreateShape(world, Shape{EdgeShapeConf{}.Set(Length2{20_m, 0_m},
+                                                                    Length2{20_m, 40_m})}));
+    const auto disk = CreateShape(world, Shape{DiskShapeConf{0.05_m}.UseDensity(1_kgpm2)});
+    auto bullets = std::vector<BodyID>{};
+    for (auto i = 0; i < 12; ++i) {
+        const auto id = CreateBody(world, BodyConf{}
+                                   .Use(BodyType::Dynamic)
+                                   .UseBullet(true)
+                                   .UseLocation(Length2{15_m, (i * 2 + 10) * 1_m})
+                                   .UseLinearVelocity(LinearVelocity2{800_mps, 0_mps}));
+        Attach(world, id, disk);
+        bullets.push_back(id);
+    }
+    auto contactsFound = 0u;
+    for (auto step = 0; step < 10; ++step) {
+        contactsFound += Step(world, StepConf{}).toi.contactsFound;
+    }
+    EXPECT_GE(contactsFound, size(bullets));
+    for (const auto& id: bullets) {
+        EXPECT_LT(GetX(GetLocation(GetBody(world, id))), 20_m);
+    }
+}
+
+TEST(AabbTreeWorld, StepArenaDoesNotGrowPerToiEvent)
+{
+    const auto maxUsedBytes = [](int numBullets) {
+        auto conf = WorldConf{};
+        conf.doStepArena = true;
+        auto world = AabbTreeWorld{conf};
+        const auto box = CreateShape(world, Shape{PolygonShapeConf{}.SetAsBox(0.5_m, 0.5_m)});
+        CreateBodiesOnGround(world, 40_m, box, GetGridLocations(10, 4, [](int i, int j) {
+            return Length2{(i * 1.1f - 30) * 1_m, (j * 1.1f + 0.55f) * 1_m};
+        }));
+        const auto wall = CreateBody(world, BodyConf{}.Use(BodyType::Static));
+        Attach(world, wall, CreateShape(world, Shape{EdgeShapeConf{}.Set(Length2{20_m, 0_m},
+                                                                        Length2{20_m, 40_m})}));
+        const auto disk = CreateShape(world, Shape{DiskShapeConf{0.05_m}.UseDensity(1_kgpm2)});
+        for (auto i = 0; i < numBullets; ++i) {
+            Attach(world, CreateBody(world, BodyConf{}
+                                                .Use(BodyType::Dynamic)
+                                                .UseBullet(true)
+                                                .UseLocation(Length2{15_m, (i * 2 + 10) * 1_m})
+                                                .UseLinearVelocity(LinearVelocity2{800_mps, 0_mps})),
+                   disk);
+        }
+        auto toiContactsFound = 0u;
+        for (auto step = 0; step < 10; ++step) {
+            toiContactsFound += Step(world, StepConf{}).toi.contactsFound;
+        }
+        EXPECT_EQ(toiContactsFound, static_cast<unsigned>(numBullets));
+        return GetStepArenaStats(world)->maxUsedBytes;
+    };
+    const auto oneEvent = maxUsedBytes(1);
+    const auto manyEvents = maxUsedBytes(12);
+    // Each extra bullet only adds its own body & contact to the regular phase. TOI scratch memory
+    // isn't taken from the arena anymore so it shouldn't grow with the number of TOI events.
+    EXPECT_LT(manyEvents - oneEvent, 4096u);
+}
@@ -21,6 +21,10 @@
 #include "UnitTests.hpp"
 
 #include <playrho/d2/BodyConstraint.hpp>
+#include <playrho/d2/Joint.hpp> // for At
+
+#include <stdexcept>
+#include <vector>
 
 using namespace playrho;
 using namespace playrho::d2;
@@ -37,3 +41,34 @@ TEST(BodyConstraint, ByteSize)
         default: FAIL(); break;
     }
 }
+
+TEST(BodyConstraintsMap, DefaultConstruction)
+{
+    const auto map = BodyConstraintsMap{};
+    EXPECT_TRUE(empty(map.GetConstraints()));
+    EXPECT_TRUE(empty(map.GetIndices()));
+}
+
+TEST(BodyConstraintsMap, DirectlyIndexed)
+{
+    auto constraints = std::vector<BodyConstraint>(2u);
+    const auto map = BodyConstraintsMap{constraints};
+    EXPECT_EQ(size(map.GetConstraints()), std::size_t(2));
+    EXPECT_TRUE(empty(map.GetIndices()));
+    EXPECT_EQ(&At(map, BodyID(0u)), &constraints[0]);
+    EXPECT_EQ(&At(map, BodyID(1u)), &constraints[1]);
+    EXPECT_THROW(At(map, BodyID(2u)), std::out_of_range);
+}
+
+TEST(BodyConstraintsMap, MapIndexed)
+{
+    auto constraints = std::vector<BodyConstraint>(2u);
+    const auto indices = std::vector<BodyID>{InvalidBodyID, BodyID(1u), InvalidBodyID, BodyID(0u)};
+    const auto map = BodyConstraintsMap{constraints, indices};
+    EXPECT_EQ(size(map.GetConstraints()), std::size_t(2));
+    EXPECT_EQ(size(map.GetIndices()), std::size_t(4));
+    EXPECT_EQ(&At(map, BodyID(1u)), &constraints[1]);
+    EXPECT_EQ(&At(map, BodyID(3u)), &constraints[0]);
+    EXPECT_THROW(At(map, BodyID(0u)), std::out_of_range);
+    EXPECT_THROW(At(map, BodyID(4u)), std::out_of_range);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "UnitTests.hpp"
+
+#include <playrho/ChromeTracer.hpp>
+#include <playrho/InvalidArgument.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility> // for std::declval
+
+using namespace playrho;
+
+TEST(ChromeTracer, Traits)
+{
+    EXPECT_TRUE(std::is_default_constructible_v<ChromeTracer>);
+    EXPECT_FALSE(std::is_copy_constructible_v<ChromeTracer>);
+    EXPECT_TRUE((std::is_convertible_v<ChromeTracer*, Tracer*>));
+    EXPECT_TRUE(noexcept(std::declval<Tracer&>().Begin("")));
+    EXPECT_TRUE(noexcept(std::declval<Tracer&>().End("")));
+    EXPECT_TRUE((std::is_nothrow_constructible_v<TraceScope, Tracer*, const char*>));
+    EXPECT_TRUE(std::is_nothrow_destructible_v<TraceScope>);
+}
+
+TEST(ChromeTracer, DefaultConstruction)
+{
+    const auto tracer = ChromeTracer{};
+    EXPECT_EQ(tracer.GetEventCount(), 0u);
+    EXPECT_EQ(tracer.GetDroppedEventCount(), 0u);
+    EXPECT_TRUE(empty(tracer.GetEvents()));
+    EXPECT_LE(tracer.GetEpoch(), ChromeTracer::clock::now());
+}
+
+TEST(ChromeTracer, TraceScopeRecordsBeginAndEnd)
+{
+    auto tracer = ChromeTracer{};
+    {
+        const auto outer = TraceScope{&tracer, "outer"};
+        const auto inner = TraceScope{&tracer, "inner"};
+        EXPECT_EQ(tracer.GetEventCount(), 2u);
+    }
+    const auto events = tracer.GetEvents();
+    ASSERT_EQ(size(events), 4u);
+    EXPECT_EQ(std::string(events[0].name), "outer");
+    EXPECT_EQ(events[0].phase, 'B');
+    EXPECT_EQ(std::string(events[1].name), "inner");
+    EXPECT_EQ(events[1].phase, 'B');
+    EXPECT_EQ(std::string(events[2].name), "inner");
+    EXPECT_EQ(events[2].phase, 'E');
+    EXPECT_EQ(std::string(events[3].name), "outer");
+    EXPECT_EQ(events[3].phase, 'E');
+    for (auto i = std::size_t{1}; i < size(events); ++i) {
+        EXPECT_LE(events[i - 1u].time, events[i].time);
+        EXPECT_EQ(events[i].lane, events[0].lane);
+    }
+    tracer.Clear();
+    EXPECT_EQ(tracer.GetEventCount(), 0u);
+}
+
+TEST(ChromeTracer, TraceScopeWithNullTracer)
+{
+    EXPECT_NO_THROW(TraceScope(nullptr, "name"));
+}
+
+TEST(ChromeTracer, ThreadsGetTheirOwnLanes)
+{
+    auto tracer = ChromeTracer{};
+    tracer.Begin("main");
+    auto thread = std::thread{[&tracer]{
+        const auto scope = TraceScope{&tracer, "worker"};
+    }};
+    thread.join();
+    tracer.End("main");
+    const auto events = tracer.GetEvents();
+    ASSERT_EQ(size(events), 4u);
+    EXPECT_EQ(events[0].lane, events[3].lane);
+    EXPECT_EQ(events[1].lane, events[2].lane);
+    EXPECT_NE(events[0].lane, events[1].lane);
+}
+
+TEST(ChromeTracer, Write)
+{
+    auto tracer = ChromeTracer{};
+    {
+        const auto scope = TraceScope{&tracer, "quote\"and\\slash"};
+    }
+    auto os = std::ostringstream{};
+    tracer.Write(os);
+    const auto json = os.str();
+    EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+    EXPECT_NE(json.find("\"name\":\"quote\\\"and\\\\slash\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"B\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"E\""), std::string::npos);
+    EXPECT_NE(json.find("\"tid\":0"), std::string::npos);
+    EXPECT_NE(json.find("\"ts\":"), std::string::npos);
+    EXPECT_EQ(json.back(), '\n');
+}
+
+TEST(ChromeTracer, WriteFileThrowsForBadPath)
+{
+    const auto tracer = ChromeTracer{};
+    EXPECT_THROW(WriteFile(tracer, "/nonexistent-directory/trace.json"), InvalidArgument);
+}
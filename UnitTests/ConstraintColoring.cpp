@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <set>
+#include <vector>
+
+#include <playrho/ConstraintColoring.hpp>
+
+#include "gtest/gtest.h"
+
+using namespace playrho;
+
+namespace {
+
+ConstraintBodies MakeBodies(BodyID::underlying_type a, BodyID::underlying_type b)
+{
+    return ConstraintBodies{BodyID(a), BodyID(b), InvalidBodyID, InvalidBodyID};
+}
+
+/// @brief Expects that no two constraints of the same color share a body.
+void ExpectNoSharedBodies(const std::vector<ConstraintBodies>& constraints,
+                          const ConstraintColors& colors)
+{
+    for (const auto& color: colors.colors) {
+        auto bodies = std::set<BodyID>{};
+        for (const auto& index: color) {
+            for (const auto& body: constraints[index]) {
+                if (IsValid(body)) {
+                    EXPECT_TRUE(bodies.insert(body).second);
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(ConstraintColoring, NoConstraints)
+{
+    const auto colors = GetConstraintColors({}, 0u);
+    EXPECT_TRUE(empty(colors.colors));
+    EXPECT_TRUE(empty(colors.uncolored));
+}
+
+TEST(ConstraintColoring, ChainTakesTwoColors)
+{
+    auto constraints = std::vector<ConstraintBodies>{};
+    for (auto i = 0u; i < 9u; ++i) {
+        constraints.push_back(MakeBodies(i, i + 1u));
+    }
+    const auto colors = GetConstraintColors(constraints, 10u);
+    ASSERT_EQ(size(colors.colors), 2u);
+    EXPECT_EQ(colors.colors[0], (std::vector<std::size_t>{0u, 2u, 4u, 6u, 8u}));
+    EXPECT_EQ(colors.colors[1], (std::vector<std::size_t>{1u, 3u, 5u, 7u}));
+    EXPECT_TRUE(empty(colors.uncolored));
+    ExpectNoSharedBodies(constraints, colors);
+}
+
+TEST(ConstraintColoring, IgnoresInvalidBodies)
+{
+    // Like contacts with the ground where the ground's identifier is left out.
+    auto constraints = std::vector<ConstraintBodies>{};
+    for (auto i = 0u; i < 5u; ++i) {
+        constraints.push_back(ConstraintBodies{InvalidBodyID, BodyID(i),
+                                               InvalidBodyID, InvalidBodyID});
+    }
+    const auto colors = GetConstraintColors(constraints, 5u);
+    ASSERT_EQ(size(colors.colors), 1u);
+    EXPECT_EQ(size(colors.colors[0]), 5u);
+}
+
+TEST(ConstraintColoring, UsesAllFourBodies)
+{
+    const auto constraints = std::vector<ConstraintBodies>{
+        ConstraintBodies{BodyID(0u), BodyID(1u), BodyID(2u), BodyID(3u)},
+        MakeBodies(4u, 3u),
+        MakeBodies(4u, 5u),
+    };
+    const auto colors = GetConstraintColors(constraints, 6u);
+    ASSERT_EQ(size(colors.colors), 2u);
+    EXPECT_EQ(colors.colors[0], (std::vector<std::size_t>{0u, 2u}));
+    EXPECT_EQ(colors.colors[1], (std::vector<std::size_t>{1u}));
+}
+
+TEST(ConstraintColoring, LeavesTooManySharingUncolored)
+{
+    auto constraints = std::vector<ConstraintBodies>{};
+    const auto count = static_cast<BodyID::underlying_type>(MaxConstraintColors + 3u);
+    for (auto i = 1u; i <= count; ++i) {
+        constraints.push_back(MakeBodies(0u, i));
+    }
+    const auto colors = GetConstraintColors(constraints, count + 1u);
+    EXPECT_EQ(size(colors.colors), MaxConstraintColors);
+    EXPECT_EQ(size(colors.uncolored), 3u);
+    ExpectNoSharedBodies(constraints, colors);
+}
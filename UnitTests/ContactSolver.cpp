@@ -27,6 +27,7 @@
 #include <playrho/d2/BodyConstraint.hpp>
 #include <playrho/d2/PolygonShapeConf.hpp>
 #include <playrho/d2/Manifold.hpp>
+#include <playrho/d2/WorldManifold.hpp>
 
 using namespace playrho;
 using namespace playrho::d2;
@@ -494,6 +495,60 @@ TEST(ContactSolver, SolvePosConstraintsForDefault)
     EXPECT_EQ(solution.pos_b, bc1.GetPosition());
 }
 
+TEST(ContactSolver, SoftStepGetSoftness)
+{
+    const auto rigid = SoftStep::GetSoftness(0_Hz, Real(10), 1_s / Real(240));
+    EXPECT_EQ(rigid.biasRate, 0_Hz);
+    EXPECT_EQ(rigid.massScale, Real(1));
+    EXPECT_EQ(rigid.impulseScale, Real(0));
+
+    const auto soft = SoftStep::GetSoftness(30_Hz, Real(10), 1_s / Real(240));
+    EXPECT_GT(soft.biasRate, 0_Hz);
+    EXPECT_GT(soft.massScale, Real(0));
+    EXPECT_LT(soft.massScale, Real(1));
+    EXPECT_NEAR(static_cast<double>(soft.massScale + soft.impulseScale), 1.0, 1e-6);
+}
+
+TEST(ContactSolver, SoftStepPushesOverlapApartThenRelaxes)
+{
+    const auto pA = Position{Vec2{0, -2} * Meter, 0_deg};
+    const auto pB = Position{Vec2{0, +1.5f} * Meter, 0_deg};
+    const auto shape = PolygonShapeConf(2_m, 2_m);
+    const auto xfmA = Transformation{pA.linear, UnitVec::Get(pA.angular)};
+    const auto xfmB = Transformation{pB.linear, UnitVec::Get(pB.angular)};
+    const auto manifold = CollideShapes(GetChild(shape, 0), xfmA, GetChild(shape, 0), xfmB);
+    ASSERT_EQ(manifold.GetPointCount(), 2);
+
+    auto bodies = std::vector<BodyConstraint>{
+        BodyConstraint{InvMass{}, InvRotInertia{}, Length2{}, pA, Velocity{}},
+        BodyConstraint{
+            Real(1) / 1_kg,
+            InvRotInertia{Real{1} * SquareRadian / (SquareMeter * 1_kg)},
+            Length2{}, pB, Velocity{}
+        }
+    };
+    const auto pc = PositionConstraint{manifold, BodyID(0u), BodyID(1u), 0_m};
+    auto vc = VelocityConstraint{Real(0), Real(0), 0_mps,
+        GetWorldManifold(manifold, xfmA, 0_m, xfmB, 0_m), BodyID(0u), BodyID(1u), bodies};
+    EXPECT_NEAR(static_cast<double>(Real{SoftStep::GetMinSeparation(pc, bodies) / 1_m}),
+                -0.5, 1e-4);
+
+    const auto h = 1_s / Real(240);
+    auto conf = SoftStep::SoftContactConf{SoftStep::GetSoftness(30_Hz, Real(10), h), h,
+        DefaultLinearSlop, 3_mps, true};
+    EXPECT_GT(SoftStep::SolveVelocityConstraint(vc, pc, bodies, conf), 0_Ns);
+    EXPECT_EQ(bodies[0].GetVelocity(), Velocity{});
+    const auto pushed = GetY(bodies[1].GetVelocity().linear);
+    EXPECT_GT(pushed, 0_mps);
+    EXPECT_LE(pushed, 3_mps * Real(1.001f));
+
+    conf.usePush = false;
+    SoftStep::SolveVelocityConstraint(vc, pc, bodies, conf);
+    const auto relaxed = GetY(bodies[1].GetVelocity().linear);
+    EXPECT_GE(relaxed, 0_mps);
+    EXPECT_LT(relaxed, pushed);
+}
+
 #if 0
 TEST(ContactSolver, SolveVelocityConstraint1)
 {
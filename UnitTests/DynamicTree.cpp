@@ -20,6 +20,8 @@
 
 #include <algorithm>
 #include <type_traits>
+#include <utility> // for std::pair
+#include <vector>
 
 #include <playrho/d2/DynamicTree.hpp>
 
@@ -1040,3 +1042,360 @@ TEST(DynamicTree, FindIndex)
         EXPECT_EQ(playrho::d2::FindIndex(tree, contactable0), idx0);
     }
 }
+
+TEST(DynamicTree, RebuildEmpty)
+{
+    auto tree = DynamicTree{};
+    EXPECT_NO_THROW(tree.Rebuild());
+    EXPECT_EQ(tree.GetRootIndex(), DynamicTree::InvalidSize);
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(0));
+    EXPECT_EQ(tree.GetLeafCount(), DynamicTree::Size(0));
+}
+
+TEST(DynamicTree, RebuildOneLeaf)
+{
+    auto tree = DynamicTree{};
+    const auto aabb = AABB{Length2{-1_m, -1_m}, Length2{+1_m, +1_m}};
+    const auto leaf = tree.CreateLeaf(aabb, Contactable{BodyID(0), ShapeID(0), ChildCounter(0)});
+    EXPECT_NO_THROW(tree.Rebuild());
+    EXPECT_EQ(tree.GetRootIndex(), leaf);
+    EXPECT_EQ(tree.GetOther(leaf), DynamicTree::InvalidSize);
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(1));
+    EXPECT_EQ(tree.GetAABB(leaf), aabb);
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+}
+
+TEST(DynamicTree, RebuildIdenticalLeaves)
+{
+    auto tree = DynamicTree{};
+    const auto aabb = AABB{Length2{-1_m, -1_m}, Length2{+1_m, +1_m}};
+    for (auto i = 0u; i < 5u; ++i) {
+        tree.CreateLeaf(aabb, Contactable{BodyID(i), ShapeID(0), ChildCounter(0)});
+    }
+    EXPECT_NO_THROW(tree.Rebuild());
+    EXPECT_EQ(tree.GetLeafCount(), DynamicTree::Size(5));
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(9));
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+    EXPECT_LE(GetMaxImbalance(tree), DynamicTree::Height(1));
+}
+
+TEST(DynamicTree, RebuildLowersPerimeterRatio)
+{
+    auto tree = DynamicTree{};
+    auto leaves = std::vector<std::pair<DynamicTree::Size, Contactable>>{};
+    // Pseudo-randomly placed and sized boxes, inserted in an unhelpful order.
+    auto seed = 12345u;
+    const auto next = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<Real>((seed >> 16u) % 1000u);
+    };
+    for (auto i = 0u; i < 1000u; ++i) {
+        const auto x = next() * 0.1_m;
+        const auto y = next() * 0.1_m;
+        const auto w = (next() * 0.001_m) + 0.1_m;
+        const auto h = (next() * 0.001_m) + 0.1_m;
+        const auto contactable = Contactable{BodyID(i), ShapeID(0), ChildCounter(0)};
+        const auto aabb = AABB{Length2{x, y}, Length2{x + w, y + h}};
+        leaves.emplace_back(tree.CreateLeaf(aabb, contactable), contactable);
+    }
+    const auto nodeCount = tree.GetNodeCount();
+    const auto ratio = ComputePerimeterRatio(tree);
+    const auto totalAABB = tree.GetAABB(tree.GetRootIndex());
+
+    EXPECT_NO_THROW(tree.Rebuild());
+    EXPECT_EQ(tree.GetNodeCount(), nodeCount);
+    EXPECT_EQ(tree.GetLeafCount(), DynamicTree::Size(1000));
+    EXPECT_EQ(tree.GetAABB(tree.GetRootIndex()), totalAABB);
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+    EXPECT_LT(ComputePerimeterRatio(tree), ratio);
+    for (const auto& leaf: leaves) {
+        EXPECT_EQ(tree.GetLeafData(leaf.first), leaf.second);
+    }
+
+    // Tree must still be usable incrementally afterwards.
+    const auto aabb = AABB{Length2{-1_m, -1_m}, Length2{+1_m, +1_m}};
+    const auto index = tree.CreateLeaf(aabb, Contactable{BodyID(1000), ShapeID(0), ChildCounter(0)});
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+    tree.DestroyLeaf(leaves[0].first);
+    tree.DestroyLeaf(index);
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+}
+
+TEST(DynamicTree, BulkLoadingConstruction)
+{
+    {
+        const auto tree = DynamicTree{Span<const AABB>{}, Span<const Contactable>{}};
+        EXPECT_EQ(tree.GetRootIndex(), DynamicTree::InvalidSize);
+        EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(0));
+        EXPECT_EQ(tree.GetLeafCount(), DynamicTree::Size(0));
+    }
+    auto aabbs = std::vector<AABB>{};
+    auto data = std::vector<Contactable>{};
+    for (auto i = 0u; i < 100u; ++i) {
+        const auto x = static_cast<Real>(i % 10u) * 1_m;
+        const auto y = static_cast<Real>(i / 10u) * 1_m;
+        aabbs.push_back(AABB{Length2{x, y}, Length2{x + 0.5_m, y + 0.5_m}});
+        data.push_back(Contactable{BodyID(i), ShapeID(0), ChildCounter(0)});
+    }
+    const auto tree = DynamicTree{aabbs, data};
+    EXPECT_EQ(tree.GetLeafCount(), DynamicTree::Size(100));
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(199));
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+    EXPECT_EQ(tree.GetAABB(tree.GetRootIndex()),
+              (AABB{Length2{0_m, 0_m}, Length2{9.5_m, 9.5_m}}));
+    for (auto i = 0u; i < 100u; ++i) {
+        EXPECT_EQ(tree.GetLeafData(i), data[i]);
+        EXPECT_EQ(tree.GetAABB(i), aabbs[i]);
+    }
+    auto incremental = DynamicTree{};
+    for (auto i = 0u; i < 100u; ++i) {
+        incremental.CreateLeaf(aabbs[i], data[i]);
+    }
+    EXPECT_LE(ComputePerimeterRatio(tree), ComputePerimeterRatio(incremental));
+    EXPECT_LE(GetHeight(tree), GetHeight(incremental));
+}
+
+TEST(DynamicTree, CreateLeaves)
+{
+    auto tree = DynamicTree{};
+    auto aabbs = std::vector<AABB>{};
+    auto data = std::vector<Contactable>{};
+    for (auto i = 0u; i < 8u; ++i) {
+        const auto x = static_cast<Real>(i) * 1_m;
+        aabbs.push_back(AABB{Length2{x, 0_m}, Length2{x + 0.5_m, 0.5_m}});
+        data.push_back(Contactable{BodyID(i), ShapeID(0), ChildCounter(0)});
+    }
+
+    // Into an empty tree (builds everything)...
+    auto indices = std::vector<DynamicTree::Size>(4u);
+    tree.CreateLeaves(Span<const AABB>(aabbs.data(), 4u), Span<const Contactable>(data.data(), 4u),
+                      indices);
+    EXPECT_EQ(tree.GetLeafCount(), DynamicTree::Size(4));
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(7));
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+    for (auto i = 0u; i < 4u; ++i) {
+        EXPECT_EQ(tree.GetLeafData(indices[i]), data[i]);
+    }
+
+    // Fewer than existing (inserts incrementally)...
+    auto moreIndices = std::vector<DynamicTree::Size>(1u);
+    tree.CreateLeaves(Span<const AABB>(aabbs.data() + 4u, 1u),
+                      Span<const Contactable>(data.data() + 4u, 1u), moreIndices);
+    EXPECT_EQ(tree.GetLeafCount(), DynamicTree::Size(5));
+    EXPECT_EQ(tree.GetLeafData(moreIndices[0]), data[4]);
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+
+    // At least as many as existing (rebuilds everything)...
+    auto lastIndices = std::vector<DynamicTree::Size>(3u);
+    const auto leafIndex = indices[0];
+    tree.DestroyLeaf(indices[1]);
+    tree.CreateLeaves(Span<const AABB>(aabbs.data() + 5u, 3u),
+                      Span<const Contactable>(data.data() + 5u, 3u), lastIndices);
+    EXPECT_EQ(tree.GetLeafCount(), DynamicTree::Size(7));
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(13));
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+    EXPECT_EQ(tree.GetLeafData(leafIndex), data[0]);
+    for (auto i = 0u; i < 3u; ++i) {
+        EXPECT_EQ(tree.GetLeafData(lastIndices[i]), data[5u + i]);
+    }
+
+    // Nothing...
+    EXPECT_NO_THROW(tree.CreateLeaves(Span<const AABB>{}, Span<const Contactable>{},
+                                      Span<DynamicTree::Size>{}));
+    EXPECT_EQ(tree.GetLeafCount(), DynamicTree::Size(7));
+}
+
+TEST(DynamicTree, Partitions)
+{
+    using Partition = DynamicTree::Partition;
+    auto tree = DynamicTree{};
+    EXPECT_EQ(tree.GetRootIndex(Partition::Static), DynamicTree::InvalidSize);
+    EXPECT_EQ(tree.GetRootIndex(Partition::Dynamic), DynamicTree::InvalidSize);
+
+    auto staticLeaves = std::vector<DynamicTree::Size>{};
+    auto dynamicLeaves = std::vector<DynamicTree::Size>{};
+    for (auto i = 0u; i < 10u; ++i) {
+        const auto x = static_cast<Real>(i) * 1_m;
+        const auto aabb = AABB{Length2{x, 0_m}, Length2{x + 0.5_m, 0.5_m}};
+        staticLeaves.push_back(tree.CreateLeaf(aabb, Contactable{BodyID(i), ShapeID(0), 0u},
+                                               Partition::Static));
+        EXPECT_EQ(tree.GetRootIndex(), tree.GetRootIndex(Partition::Static));
+    }
+    EXPECT_EQ(tree.GetLeafCount(Partition::Static), DynamicTree::Size(10));
+    EXPECT_EQ(tree.GetLeafCount(Partition::Dynamic), DynamicTree::Size(0));
+    for (auto i = 0u; i < 5u; ++i) {
+        const auto x = static_cast<Real>(i) * 2_m;
+        const auto aabb = AABB{Length2{x, 0.25_m}, Length2{x + 0.5_m, 1_m}};
+        dynamicLeaves.push_back(tree.CreateLeaf(aabb, Contactable{BodyID(10u + i), ShapeID(0), 0u}));
+    }
+    EXPECT_EQ(tree.GetLeafCount(), DynamicTree::Size(15));
+    EXPECT_EQ(tree.GetLeafCount(Partition::Dynamic), DynamicTree::Size(5));
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(29));
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+    ASSERT_TRUE(DynamicTree::IsBranch(tree.GetHeight(tree.GetRootIndex())));
+    EXPECT_EQ(tree.GetBranchData(tree.GetRootIndex()).child1, tree.GetRootIndex(Partition::Static));
+    EXPECT_EQ(tree.GetBranchData(tree.GetRootIndex()).child2, tree.GetRootIndex(Partition::Dynamic));
+    const auto joinIndex = tree.GetRootIndex();
+    for (const auto& leaf: staticLeaves) {
+        EXPECT_EQ(tree.GetPartition(leaf), Partition::Static);
+    }
+    for (const auto& leaf: dynamicLeaves) {
+        EXPECT_EQ(tree.GetPartition(leaf), Partition::Dynamic);
+    }
+
+    // Querying a partition only finds leaves of that partition...
+    const auto everything = AABB{Length2{-1_m, -1_m}, Length2{20_m, 2_m}};
+    auto found = std::vector<DynamicTree::Size>{};
+    Query(tree, tree.GetRootIndex(Partition::Dynamic), everything, [&](DynamicTree::Size index) {
+        found.push_back(index);
+        return DynamicTreeOpcode::Continue;
+    });
+    std::sort(begin(found), end(found));
+    auto expected = dynamicLeaves;
+    std::sort(begin(expected), end(expected));
+    EXPECT_EQ(found, expected);
+    found.clear();
+    Query(tree, everything, [&](DynamicTree::Size index) {
+        found.push_back(index);
+        return DynamicTreeOpcode::Continue;
+    });
+    EXPECT_EQ(size(found), 15u);
+
+    // Updating leaves keeps them in their partitions...
+    for (const auto& leaf: dynamicLeaves) {
+        tree.UpdateLeaf(leaf, GetMovedAABB(tree.GetAABB(leaf), Length2{0.5_m, 0_m}));
+        EXPECT_EQ(tree.GetPartition(leaf), Partition::Dynamic);
+    }
+    tree.UpdateLeaf(staticLeaves[0], GetMovedAABB(tree.GetAABB(staticLeaves[0]), Length2{0_m, 1_m}));
+    EXPECT_EQ(tree.GetPartition(staticLeaves[0]), Partition::Static);
+    EXPECT_EQ(tree.GetRootIndex(), joinIndex);
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+
+    // Moving leaves between partitions preserves their indices...
+    tree.SetPartition(staticLeaves[3], Partition::Dynamic);
+    EXPECT_EQ(tree.GetPartition(staticLeaves[3]), Partition::Dynamic);
+    EXPECT_EQ(tree.GetLeafCount(Partition::Static), DynamicTree::Size(9));
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(29));
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+    tree.SetPartition(staticLeaves[3], Partition::Static);
+    EXPECT_EQ(tree.GetPartition(staticLeaves[3]), Partition::Static);
+    EXPECT_EQ(tree.GetRootIndex(), joinIndex);
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+
+    // Rebuilding preserves partitions...
+    const auto copy = tree;
+    tree.Rebuild(Partition::Static);
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(29));
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+    EXPECT_EQ(tree.GetRootIndex(), joinIndex);
+    tree.RebuildBottomUp();
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(29));
+    EXPECT_EQ(tree.GetRootIndex(), joinIndex);
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+    for (const auto& leaf: staticLeaves) {
+        EXPECT_EQ(tree.GetPartition(leaf), Partition::Static);
+        EXPECT_EQ(copy.GetPartition(leaf), Partition::Static);
+    }
+    for (const auto& leaf: dynamicLeaves) {
+        EXPECT_EQ(tree.GetPartition(leaf), Partition::Dynamic);
+        EXPECT_EQ(copy.GetPartition(leaf), Partition::Dynamic);
+    }
+
+    // Emptying a partition leaves just the other one...
+    for (const auto& leaf: dynamicLeaves) {
+        tree.DestroyLeaf(leaf);
+        EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    }
+    EXPECT_EQ(tree.GetRootIndex(Partition::Dynamic), DynamicTree::InvalidSize);
+    EXPECT_EQ(tree.GetRootIndex(), tree.GetRootIndex(Partition::Static));
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(19));
+    tree.SetPartition(staticLeaves[0], Partition::Dynamic);
+    EXPECT_EQ(tree.GetRootIndex(Partition::Dynamic), staticLeaves[0]);
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(19));
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+
+    // Moving a partition's only leaf to the other partition reuses the joining node...
+    tree.SetPartition(staticLeaves[0], Partition::Static);
+    EXPECT_EQ(tree.GetPartition(staticLeaves[0]), Partition::Static);
+    EXPECT_EQ(tree.GetRootIndex(Partition::Dynamic), DynamicTree::InvalidSize);
+    EXPECT_EQ(tree.GetRootIndex(), tree.GetRootIndex(Partition::Static));
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(19));
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+}
+
+TEST(DynamicTree, CreateLeavesInStaticPartition)
+{
+    using Partition = DynamicTree::Partition;
+    auto tree = DynamicTree{};
+    const auto dynamicLeaf = tree.CreateLeaf(AABB{Length2{0_m, 0_m}, Length2{1_m, 1_m}},
+                                             Contactable{BodyID(100), ShapeID(0), 0u});
+    auto aabbs = std::vector<AABB>{};
+    auto data = std::vector<Contactable>{};
+    for (auto i = 0u; i < 20u; ++i) {
+        const auto x = static_cast<Real>(i) * 1_m;
+        aabbs.push_back(AABB{Length2{x, -1_m}, Length2{x + 0.5_m, -0.5_m}});
+        data.push_back(Contactable{BodyID(i), ShapeID(0), ChildCounter(0)});
+    }
+    auto indices = std::vector<DynamicTree::Size>(size(aabbs));
+    tree.CreateLeaves(aabbs, data, indices, Partition::Static);
+    EXPECT_EQ(tree.GetLeafCount(Partition::Static), DynamicTree::Size(20));
+    EXPECT_EQ(tree.GetLeafCount(Partition::Dynamic), DynamicTree::Size(1));
+    EXPECT_EQ(tree.GetNodeCount(), DynamicTree::Size(41));
+    EXPECT_EQ(tree.GetRootIndex(Partition::Dynamic), dynamicLeaf);
+    EXPECT_TRUE(ValidateStructure(tree, tree.GetRootIndex()));
+    EXPECT_TRUE(ValidateMetrics(tree, tree.GetRootIndex()));
+    for (auto i = 0u; i < 20u; ++i) {
+        EXPECT_EQ(tree.GetLeafData(indices[i]), data[i]);
+        EXPECT_EQ(tree.GetPartition(indices[i]), Partition::Static);
+    }
+}
+
+TEST(DynamicTree, ModificationCount)
+{
+    using Partition = DynamicTree::Partition;
+    auto tree = DynamicTree{};
+    auto count = tree.GetModificationCount();
+    EXPECT_EQ(count, 0u);
+    const auto leaf = tree.CreateLeaf(AABB{Length2{0_m, 0_m}, Length2{1_m, 1_m}},
+                                      Contactable{BodyID(1), ShapeID(0), 0u});
+    EXPECT_GT(tree.GetModificationCount(), count);
+    count = tree.GetModificationCount();
+    tree.Reserve(tree.GetNodeCapacity() * 2u);
+    EXPECT_EQ(tree.GetModificationCount(), count);
+    EXPECT_EQ(DynamicTree{tree}.GetModificationCount(), count);
+    tree.UpdateLeaf(leaf, AABB{Length2{0_m, 0_m}, Length2{2_m, 2_m}});
+    EXPECT_GT(tree.GetModificationCount(), count);
+    count = tree.GetModificationCount();
+    tree.SetPartition(leaf, Partition::Dynamic);
+    EXPECT_EQ(tree.GetModificationCount(), count);
+    tree.SetPartition(leaf, Partition::Static);
+    EXPECT_GT(tree.GetModificationCount(), count);
+    count = tree.GetModificationCount();
+    tree.ShiftOrigin(Length2{1_m, 1_m});
+    EXPECT_GT(tree.GetModificationCount(), count);
+    count = tree.GetModificationCount();
+    tree.Rebuild();
+    EXPECT_GT(tree.GetModificationCount(), count);
+    count = tree.GetModificationCount();
+    tree.DestroyLeaf(leaf);
+    EXPECT_GT(tree.GetModificationCount(), count);
+    count = tree.GetModificationCount();
+    tree.Clear();
+    EXPECT_GT(tree.GetModificationCount(), count);
+}
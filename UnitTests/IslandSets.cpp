@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "UnitTests.hpp"
+
+#include <playrho/IslandSets.hpp>
+
+#include <set>
+
+using namespace playrho;
+
+namespace {
+
+std::set<BodyID> GetMembers(const IslandSets& sets, BodyID id)
+{
+    auto members = std::set<BodyID>{};
+    auto member = id;
+    do {
+        members.insert(member);
+        member = sets.GetNext(member);
+    } while (member != id);
+    return members;
+}
+
+} // namespace
+
+TEST(IslandSets, DefaultConstructor)
+{
+    const auto sets = IslandSets{};
+    EXPECT_EQ(sets.size(), 0u);
+}
+
+TEST(IslandSets, ResizeMakesSingletons)
+{
+    auto sets = IslandSets{};
+    sets.resize(3u);
+    EXPECT_EQ(sets.size(), 3u);
+    for (auto i = 0u; i < 3u; ++i) {
+        const auto id = BodyID(static_cast<BodyID::underlying_type>(i));
+        EXPECT_EQ(sets.Find(id), id);
+        EXPECT_EQ(sets.GetNext(id), id);
+        EXPECT_EQ(sets.GetSize(id), 1u);
+        EXPECT_FALSE(sets.NeedsSplitting(id));
+    }
+    sets.clear();
+    EXPECT_EQ(sets.size(), 0u);
+}
+
+TEST(IslandSets, Join)
+{
+    auto sets = IslandSets{};
+    sets.resize(5u);
+    EXPECT_TRUE(sets.Join(BodyID(0u), BodyID(1u)));
+    EXPECT_FALSE(sets.Join(BodyID(1u), BodyID(0u)));
+    EXPECT_TRUE(sets.Join(BodyID(3u), BodyID(2u)));
+    EXPECT_EQ(sets.Find(BodyID(0u)), sets.Find(BodyID(1u)));
+    EXPECT_EQ(sets.Find(BodyID(2u)), sets.Find(BodyID(3u)));
+    EXPECT_NE(sets.Find(BodyID(0u)), sets.Find(BodyID(2u)));
+    EXPECT_EQ(sets.GetSize(BodyID(0u)), 2u);
+    EXPECT_EQ(GetMembers(sets, BodyID(1u)), (std::set<BodyID>{BodyID(0u), BodyID(1u)}));
+
+    EXPECT_TRUE(sets.Join(BodyID(1u), BodyID(2u)));
+    EXPECT_EQ(sets.GetSize(BodyID(3u)), 4u);
+    EXPECT_EQ(GetMembers(sets, BodyID(3u)),
+              (std::set<BodyID>{BodyID(0u), BodyID(1u), BodyID(2u), BodyID(3u)}));
+    EXPECT_EQ(GetMembers(sets, BodyID(4u)), (std::set<BodyID>{BodyID(4u)}));
+}
+
+TEST(IslandSets, JoinWhileIteratingVisitsNewMembers)
+{
+    auto sets = IslandSets{};
+    sets.resize(4u);
+    sets.Join(BodyID(0u), BodyID(1u));
+    sets.Join(BodyID(2u), BodyID(3u));
+    auto visited = std::set<BodyID>{};
+    auto member = BodyID(0u);
+    do {
+        visited.insert(member);
+        if (member == BodyID(1u)) {
+            sets.Join(member, BodyID(3u));
+        }
+        member = sets.GetNext(member);
+    } while (member != BodyID(0u));
+    EXPECT_EQ(size(visited), 4u);
+}
+
+TEST(IslandSets, FlagForSplitting)
+{
+    auto sets = IslandSets{};
+    sets.resize(3u);
+    sets.Join(BodyID(0u), BodyID(1u));
+    sets.FlagForSplitting(BodyID(1u));
+    EXPECT_TRUE(sets.NeedsSplitting(BodyID(0u)));
+    EXPECT_FALSE(sets.NeedsSplitting(BodyID(2u)));
+    sets.Join(BodyID(2u), BodyID(0u));
+    EXPECT_TRUE(sets.NeedsSplitting(BodyID(2u)));
+    sets.Reset(BodyID(0u));
+    sets.Reset(BodyID(1u));
+    sets.Reset(BodyID(2u));
+    EXPECT_FALSE(sets.NeedsSplitting(BodyID(0u)));
+    EXPECT_EQ(sets.GetSize(BodyID(0u)), 1u);
+}
+
+TEST(IslandSets, LinkedConstraints)
+{
+    auto sets = IslandSets{};
+    sets.resize(3u);
+    EXPECT_EQ(sets.GetContact(BodyID(0u)), InvalidContactID);
+    EXPECT_EQ(sets.GetJoint(BodyID(0u)), InvalidJointID);
+    EXPECT_FALSE(sets.IsLinked(ContactID(0u)));
+    sets.Link(ContactID(0u), BodyID(0u));
+    sets.Link(ContactID(1u), BodyID(0u));
+    sets.Link(ContactID(2u), BodyID(1u));
+    sets.Link(JointID(0u), BodyID(2u));
+    EXPECT_TRUE(sets.IsLinked(ContactID(1u)));
+    EXPECT_EQ(sets.GetContact(BodyID(0u)), ContactID(0u));
+    EXPECT_EQ(sets.GetNext(ContactID(0u)), ContactID(1u));
+    EXPECT_EQ(sets.GetNext(ContactID(1u)), ContactID(0u));
+
+    // Joining splices the lists of constraints together too.
+    sets.Join(BodyID(0u), BodyID(1u));
+    sets.Join(BodyID(2u), BodyID(1u));
+    EXPECT_EQ(sets.GetContact(BodyID(2u)), ContactID(0u));
+    EXPECT_EQ(sets.GetNext(ContactID(1u)), ContactID(2u));
+    EXPECT_EQ(sets.GetNext(ContactID(2u)), ContactID(0u));
+    EXPECT_EQ(sets.GetJoint(BodyID(0u)), JointID(0u));
+    EXPECT_EQ(sets.GetNext(JointID(0u)), JointID(0u));
+    EXPECT_FALSE(sets.NeedsSplitting(BodyID(0u)));
+
+    // Unlinking flags the set for splitting.
+    sets.Unlink(ContactID(0u));
+    EXPECT_FALSE(sets.IsLinked(ContactID(0u)));
+    EXPECT_TRUE(sets.NeedsSplitting(BodyID(2u)));
+    EXPECT_EQ(sets.GetContact(BodyID(0u)), ContactID(1u));
+    EXPECT_EQ(sets.GetNext(ContactID(2u)), ContactID(1u));
+    sets.Unlink(ContactID(1u));
+    sets.Unlink(ContactID(2u));
+    sets.Unlink(JointID(0u));
+    EXPECT_EQ(sets.GetContact(BodyID(1u)), InvalidContactID);
+    EXPECT_EQ(sets.GetJoint(BodyID(1u)), InvalidJointID);
+    sets.clear();
+    EXPECT_FALSE(sets.IsLinked(ContactID(1u)));
+}
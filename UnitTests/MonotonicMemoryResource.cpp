@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "UnitTests.hpp"
+
+#include <cstdint> // for std::uintptr_t
+#include <sstream>
+#include <vector>
+
+#include <playrho/pmr/MonotonicMemoryResource.hpp>
+#include <playrho/pmr/StatsResource.hpp>
+
+using namespace playrho::pmr;
+
+TEST(MonotonicMemoryOptions, DefaultConstruction)
+{
+    EXPECT_EQ(MonotonicMemoryOptions().reserveBytes, 0u);
+    EXPECT_TRUE(MonotonicMemoryOptions() == MonotonicMemoryOptions());
+    EXPECT_TRUE(MonotonicMemoryOptions{2u} != MonotonicMemoryOptions());
+}
+
+TEST(MonotonicMemoryResource, DefaultConstruction)
+{
+    const auto resource = MonotonicMemoryResource{};
+    EXPECT_EQ(resource.GetOptions(), MonotonicMemoryOptions());
+    EXPECT_EQ(resource.GetUpstream(), new_delete_resource());
+    EXPECT_EQ(resource.GetStats(), MonotonicMemoryResource::Stats());
+}
+
+TEST(MonotonicMemoryResource, ReserveBytes)
+{
+    auto upstream = StatsResource{};
+    const auto resource = MonotonicMemoryResource{MonotonicMemoryOptions{4000u}, &upstream};
+    EXPECT_EQ(resource.GetUpstream(), &upstream);
+    EXPECT_EQ(upstream.GetStats().blocksAllocated, 1u);
+    EXPECT_GE(upstream.GetStats().bytesAllocated, 4000u);
+    const auto stats = resource.GetStats();
+    EXPECT_EQ(stats.numBlocks, 1u);
+    EXPECT_GE(stats.totalBytes, 4000u);
+    EXPECT_EQ(stats.usedBytes, 0u);
+    EXPECT_EQ(stats.upstreamAllocations, 1u);
+}
+
+TEST(MonotonicMemoryResource, DestructorDeallocates)
+{
+    auto upstream = StatsResource{};
+    {
+        auto resource = MonotonicMemoryResource{MonotonicMemoryOptions{64u}, &upstream};
+        EXPECT_NE(resource.allocate(1000u, 8u), nullptr);
+        EXPECT_NE(resource.allocate(5000u, 8u), nullptr);
+        EXPECT_GT(upstream.GetStats().blocksAllocated, 1u);
+    }
+    EXPECT_EQ(upstream.GetStats().blocksAllocated, 0u);
+    EXPECT_EQ(upstream.GetStats().bytesAllocated, 0u);
+}
+
+TEST(MonotonicMemoryResource, AllocateBumpsWithinBlock)
+{
+    auto resource = MonotonicMemoryResource{MonotonicMemoryOptions{1024u}};
+    auto* p0 = static_cast<char*>(resource.allocate(10u, 1u));
+    auto* p1 = static_cast<char*>(resource.allocate(10u, 1u));
+    EXPECT_EQ(p1, p0 + 10);
+    auto* p2 = resource.allocate(16u, 16u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p2) % 16u, 0u);
+    resource.deallocate(p1, 10u, 1u);
+    const auto stats = resource.GetStats();
+    EXPECT_EQ(stats.numBlocks, 1u);
+    EXPECT_EQ(stats.usedBytes, 32u + 16u);
+    EXPECT_EQ(stats.maxUsedBytes, stats.usedBytes);
+    EXPECT_EQ(stats.upstreamAllocations, 1u);
+}
+
+TEST(MonotonicMemoryResource, AllocateOverAlignment)
+{
+    auto resource = MonotonicMemoryResource{};
+    EXPECT_NE(resource.allocate(1u, 1u), nullptr);
+    constexpr auto alignment = alignof(std::max_align_t) * 4u;
+    auto* p = resource.allocate(2000u, alignment);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignment, 0u);
+}
+
+TEST(MonotonicMemoryResource, ReleaseConsolidatesToOneBlock)
+{
+    auto resource = MonotonicMemoryResource{};
+    const auto allocateAll = [&resource]{
+        for (auto i = 0; i < 20; ++i) {
+            EXPECT_NE(resource.allocate(static_cast<std::size_t>(100 + i * 50), 8u), nullptr);
+        }
+    };
+    allocateAll();
+    const auto before = resource.GetStats();
+    EXPECT_GT(before.numBlocks, 1u);
+    resource.Release();
+    const auto after = resource.GetStats();
+    EXPECT_EQ(after.numBlocks, 1u);
+    EXPECT_EQ(after.usedBytes, 0u);
+    EXPECT_EQ(after.maxUsedBytes, before.maxUsedBytes);
+    EXPECT_GE(after.totalBytes, before.maxUsedBytes);
+    EXPECT_EQ(after.upstreamAllocations, before.upstreamAllocations + 1u);
+
+    // Going through the same allocations again shouldn't need any more from upstream.
+    for (auto i = 0; i < 3; ++i) {
+        allocateAll();
+        resource.Release();
+    }
+    EXPECT_EQ(resource.GetStats().upstreamAllocations, after.upstreamAllocations);
+    EXPECT_EQ(resource.GetStats().numBlocks, 1u);
+}
+
+TEST(MonotonicMemoryResource, IsEqual)
+{
+    auto resource0 = MonotonicMemoryResource{};
+    auto resource1 = MonotonicMemoryResource{};
+    EXPECT_TRUE(resource0.is_equal(resource0));
+    EXPECT_FALSE(resource0.is_equal(resource1));
+}
+
+TEST(MonotonicMemoryResource, StreamOutput)
+{
+    auto stats = MonotonicMemoryResource::Stats{};
+    stats.numBlocks = 1u;
+    stats.totalBytes = 1024u;
+    auto os = std::ostringstream{};
+    os << stats;
+    EXPECT_EQ(os.str(), "{total-bytes=1024, num-blocks=1, used-bytes=0, max-used-bytes=0, upstream-allocs=0}");
+}
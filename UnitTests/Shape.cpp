@@ -56,7 +56,7 @@ TEST(Shape, Traits)
     EXPECT_FALSE((std::is_trivially_constructible_v<Shape, X, X>));
 
     EXPECT_TRUE(std::is_copy_constructible_v<Shape>);
-    EXPECT_FALSE(std::is_nothrow_copy_constructible_v<Shape>);
+    EXPECT_TRUE(std::is_nothrow_copy_constructible_v<Shape>);
     EXPECT_FALSE(std::is_trivially_copy_constructible_v<Shape>);
 
     EXPECT_TRUE(std::is_move_constructible_v<Shape>);
@@ -64,7 +64,7 @@ TEST(Shape, Traits)
     EXPECT_FALSE(std::is_trivially_move_constructible_v<Shape>);
 
     EXPECT_TRUE(std::is_copy_assignable_v<Shape>);
-    EXPECT_FALSE(std::is_nothrow_copy_assignable_v<Shape>);
+    EXPECT_TRUE(std::is_nothrow_copy_assignable_v<Shape>);
     EXPECT_FALSE(std::is_trivially_copy_assignable_v<Shape>);
 
     EXPECT_TRUE(std::is_move_assignable_v<Shape>);
@@ -275,6 +275,26 @@ TEST(Shape, AssignmentFromCopyable)
     EXPECT_EQ(0, TestConf::moveAssignmentCalled);
 }
 
+TEST(Shape, CopySharesValue)
+{
+    TestConf::resetClass();
+    TestConf conf;
+    conf.data = "have some";
+    const auto s = Shape{conf};
+    ASSERT_EQ(1, TestConf::copyConstructorCalled);
+    auto t = s;
+    EXPECT_EQ(1, TestConf::copyConstructorCalled);
+    EXPECT_EQ(GetData(s), GetData(t));
+    EXPECT_EQ(s, t);
+    auto u = Shape{DiskShapeConf{}.UseFriction(Real(0.5))};
+    const auto v = u;
+    EXPECT_EQ(GetData(u), GetData(v));
+    SetFriction(u, Real(0.25));
+    EXPECT_NE(GetData(u), GetData(v));
+    EXPECT_EQ(GetFriction(u), Real(0.25));
+    EXPECT_EQ(GetFriction(v), Real(0.5));
+}
+
 TEST(Shape, SetNoops)
 {
     TestConf::resetClass();
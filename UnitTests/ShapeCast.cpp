@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "UnitTests.hpp"
+
+#include <playrho/d2/BodyConf.hpp>
+#include <playrho/d2/DiskShapeConf.hpp>
+#include <playrho/d2/DistanceProxy.hpp>
+#include <playrho/d2/Shape.hpp>
+#include <playrho/d2/ShapeCast.hpp>
+#include <playrho/d2/World.hpp>
+#include <playrho/d2/WorldBody.hpp>
+#include <playrho/d2/WorldMisc.hpp>
+
+using namespace playrho;
+using namespace playrho::d2;
+
+namespace {
+
+/// @brief Makes a world having two disks of 1m radius on the X-axis at 5m and at 10m.
+/// @note The disk at 10m has a category of 0x2.
+World MakeWorld(BodyID& nearBody, BodyID& farBody)
+{
+    auto world = World{};
+    auto farFilter = Filter{};
+    farFilter.categoryBits = 0x2;
+    nearBody = CreateBody(world, BodyConf{}.UseLocation(Length2{5_m, 0_m}));
+    Attach(world, nearBody, CreateShape(world, Shape{DiskShapeConf{}.UseRadius(1_m)}));
+    farBody = CreateBody(world, BodyConf{}.UseLocation(Length2{10_m, 0_m}));
+    Attach(world, farBody, CreateShape(world, Shape{DiskShapeConf{}.UseRadius(1_m)
+                                                    .UseFilter(farFilter)}));
+    Step(world, StepConf{});
+    return world;
+}
+
+} // namespace
+
+TEST(ShapeCast, EmptyWorld)
+{
+    const auto shape = Shape{DiskShapeConf{}.UseRadius(0.5_m)};
+    EXPECT_FALSE(ShapeCast(World{}, GetChild(shape, 0u), Transformation{},
+                           Length2{10_m, 0_m}).has_value());
+}
+
+TEST(ShapeCast, HitsClosest)
+{
+    auto nearBody = InvalidBodyID;
+    auto farBody = InvalidBodyID;
+    const auto world = MakeWorld(nearBody, farBody);
+    const auto shape = Shape{DiskShapeConf{}.UseRadius(0.5_m)};
+    const auto proxy = GetChild(shape, 0u);
+
+    const auto output = ShapeCast(world, proxy, Transformation{}, Length2{20_m, 0_m});
+    ASSERT_TRUE(output.has_value());
+    EXPECT_EQ(output->body, nearBody);
+    EXPECT_EQ(output->child, 0u);
+    EXPECT_EQ(output->toi.state, ToiOutput::e_touching);
+    EXPECT_NEAR(static_cast<double>(Real{output->fraction}), 3.5 / 20.0, 0.001);
+    EXPECT_NEAR(static_cast<double>(Real{GetX(output->point) / 1_m}), 4.0, 0.01);
+    EXPECT_NEAR(static_cast<double>(Real{GetY(output->point) / 1_m}), 0.0, 0.01);
+    EXPECT_NEAR(static_cast<double>(GetX(output->normal)), -1.0, 0.01);
+    EXPECT_NEAR(static_cast<double>(GetY(output->normal)), 0.0, 0.01);
+}
+
+TEST(ShapeCast, FilteredAndMissed)
+{
+    auto nearBody = InvalidBodyID;
+    auto farBody = InvalidBodyID;
+    const auto world = MakeWorld(nearBody, farBody);
+    const auto shape = Shape{DiskShapeConf{}.UseRadius(0.5_m)};
+    const auto proxy = GetChild(shape, 0u);
+
+    auto filter = Filter{};
+    filter.maskBits = 0x2;
+    const auto filtered = ShapeCast(world, proxy, Transformation{}, Length2{20_m, 0_m}, filter);
+    ASSERT_TRUE(filtered.has_value());
+    EXPECT_EQ(filtered->body, farBody);
+    EXPECT_NEAR(static_cast<double>(Real{filtered->fraction}), 8.5 / 20.0, 0.001);
+
+    EXPECT_FALSE(ShapeCast(world, proxy, Transformation{Length2{0_m, 2_m}, UnitVec::GetRight()},
+                           Length2{20_m, 2_m}).has_value());
+    EXPECT_FALSE(ShapeCast(world, proxy, Transformation{}, Length2{3_m, 0_m}).has_value());
+}
+
+TEST(ShapeCast, IgnoresInitiallyOverlapped)
+{
+    auto nearBody = InvalidBodyID;
+    auto farBody = InvalidBodyID;
+    const auto world = MakeWorld(nearBody, farBody);
+    const auto shape = Shape{DiskShapeConf{}.UseRadius(0.5_m)};
+    const auto from = Transformation{Length2{5_m, 0_m}, UnitVec::GetRight()};
+    const auto output = ShapeCast(world, GetChild(shape, 0u), from, Length2{20_m, 0_m});
+    ASSERT_TRUE(output.has_value());
+    EXPECT_EQ(output->body, farBody);
+    EXPECT_NEAR(static_cast<double>(Real{output->fraction}), 3.5 / 15.0, 0.001);
+}
@@ -31,9 +31,9 @@ TEST(StepConf, ByteSize)
     // builds and to report actual size rather than just reporting that expected size is wrong.
     switch (sizeof(Real))
     {
-        case  4: EXPECT_EQ(sizeof(StepConf), std::size_t(104)); break;
-        case  8: EXPECT_EQ(sizeof(StepConf), std::size_t(200)); break;
-        case 16: EXPECT_EQ(sizeof(StepConf), std::size_t(384)); break;
+        case  4: EXPECT_EQ(sizeof(StepConf), std::size_t(120)); break;
+        case  8: EXPECT_EQ(sizeof(StepConf), std::size_t(224)); break;
+        case 16: EXPECT_EQ(sizeof(StepConf), std::size_t(432)); break;
         default: FAIL(); break;
     }
 }
@@ -75,6 +75,14 @@ TEST(StepConf, DefaultConstuction)
     EXPECT_EQ(conf.doWarmStart, StepConf::DefaultDoWarmStart);
     EXPECT_EQ(conf.doToi, StepConf::DefaultDoToi);
     EXPECT_EQ(conf.doBlocksolve, StepConf::DefaultDoBlocksolve);
+    EXPECT_EQ(conf.doWideVelocitySolve, StepConf::DefaultDoWideVelocitySolve);
+    EXPECT_EQ(conf.doColoredIslandSolve, StepConf::DefaultDoColoredIslandSolve);
+    EXPECT_EQ(conf.doJointBatching, StepConf::DefaultDoJointBatching);
+    EXPECT_EQ(conf.regSubSteps, StepConf::DefaultRegSubSteps);
+    EXPECT_EQ(conf.softContactFrequency, StepConf::DefaultSoftContactFrequency);
+    EXPECT_EQ(conf.softContactDampingRatio, StepConf::DefaultSoftContactDampingRatio);
+    EXPECT_EQ(conf.softContactPushSpeed, StepConf::DefaultSoftContactPushSpeed);
+    EXPECT_EQ(conf.doTiming, StepConf::DefaultDoTiming);
 }
 
 TEST(StepConf, CopyConstruction)
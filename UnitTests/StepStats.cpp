@@ -78,6 +78,20 @@ TEST(RegStepStats, DefaultConstructor)
     EXPECT_EQ(object.sumVelIters, static_cast<decltype(object.sumVelIters)>(0));
 }
 
+TEST(StepTimes, DefaultConstructor)
+{
+    const auto object = StepTimes{};
+    EXPECT_EQ(object.proxyCreation, StepTimes::duration{});
+    EXPECT_EQ(object.proxySync, StepTimes::duration{});
+    EXPECT_EQ(object.contactDestroy, StepTimes::duration{});
+    EXPECT_EQ(object.contactUpdate, StepTimes::duration{});
+    EXPECT_EQ(object.pairFinding, StepTimes::duration{});
+    EXPECT_EQ(object.islandBuilding, StepTimes::duration{});
+    EXPECT_EQ(object.velocitySolve, StepTimes::duration{});
+    EXPECT_EQ(object.positionSolve, StepTimes::duration{});
+    EXPECT_EQ(object.toi, StepTimes::duration{});
+}
+
 TEST(PreStepStats, Equality)
 {
     EXPECT_TRUE(PreStepStats() == PreStepStats());
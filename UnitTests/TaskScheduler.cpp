@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "UnitTests.hpp"
+
+#include <playrho/TaskScheduler.hpp>
+
+#include <algorithm> // for std::clamp
+#include <vector>
+
+using namespace playrho;
+
+namespace {
+
+class SerialScheduler: public TaskScheduler
+{
+public:
+    explicit SerialScheduler(size_type concurrency): m_concurrency{concurrency} {}
+
+    size_type GetConcurrency() const noexcept override
+    {
+        return m_concurrency;
+    }
+
+    void Run(const Span<const Task>& tasks) override
+    {
+        ++runs;
+        for (const auto& task: tasks) {
+            task();
+        }
+    }
+
+    int runs{};
+
+private:
+    size_type m_concurrency{};
+};
+
+} // namespace
+
+TEST(TaskScheduler, ParallelForWithZeroCount)
+{
+    auto scheduler = SerialScheduler{4u};
+    auto calls = 0;
+    scheduler.ParallelFor(0u, [&calls](std::size_t, std::size_t) { ++calls; });
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(scheduler.runs, 0);
+}
+
+TEST(TaskScheduler, ParallelForCoversRangeOnce)
+{
+    for (const auto concurrency: {std::size_t{0}, std::size_t{1}, std::size_t{3}, std::size_t{16}}) {
+        auto scheduler = SerialScheduler{concurrency};
+        auto counts = std::vector<int>(10u);
+        auto calls = std::size_t{0};
+        scheduler.ParallelFor(size(counts), [&](std::size_t first, std::size_t last) {
+            EXPECT_LT(first, last);
+            for (auto i = first; i < last; ++i) {
+                ++counts[i];
+            }
+            ++calls;
+        });
+        EXPECT_EQ(counts, std::vector<int>(10u, 1));
+        EXPECT_EQ(calls, std::clamp(concurrency, std::size_t{1}, size(counts)));
+        EXPECT_EQ(scheduler.runs, (calls > 1u)? 1: 0);
+    }
+}
@@ -21,6 +21,55 @@
 #ifndef UnitTests_hpp
 #define UnitTests_hpp
 
+#include <vector>
+
 #include "gtest/gtest.h"
 
+#include <playrho/BodyID.hpp>
+#include <playrho/ShapeID.hpp>
+#include <playrho/Vector2.hpp>
+
+#include <playrho/d2/BodyConf.hpp>
+#include <playrho/d2/EdgeShapeConf.hpp>
+#include <playrho/d2/Shape.hpp>
+
+/// @brief Gets the locations of a grid of the given number of columns & rows.
+/// @param locate Function returning the location of the given column & row.
+template <class Function>
+std::vector<playrho::Length2> GetGridLocations(int columns, int rows, const Function& locate)
+{
+    auto locations = std::vector<playrho::Length2>{};
+    for (auto column = 0; column < columns; ++column) {
+        for (auto row = 0; row < rows; ++row) {
+            locations.push_back(locate(column, row));
+        }
+    }
+    return locations;
+}
+
+/// @brief Creates a static edge ground of the given half width along the X-axis and dynamic
+///   bodies of the given shape, accelerated by gravity, at the given locations.
+/// @return Identifiers of the dynamic bodies in the order of the given locations.
+template <class World>
+std::vector<playrho::BodyID> CreateBodiesOnGround(World& world, playrho::Length halfWidth,
+                                                  playrho::ShapeID shape,
+                                                  const std::vector<playrho::Length2>& locations)
+{
+    using namespace playrho;
+    using namespace playrho::d2;
+    const auto ground = CreateBody(world, BodyConf{}.Use(BodyType::Static));
+    Attach(world, ground, CreateShape(world, Shape{EdgeShapeConf{}.Set(Length2{-halfWidth, 0_m},
+                                                                       Length2{+halfWidth, 0_m})}));
+    auto bodies = std::vector<BodyID>{};
+    for (const auto& location: locations) {
+        const auto body = CreateBody(world, BodyConf{}
+                                     .Use(BodyType::Dynamic)
+                                     .UseLocation(location)
+                                     .UseLinearAcceleration(EarthlyGravity));
+        Attach(world, body, shape);
+        bodies.push_back(body);
+    }
+    return bodies;
+}
+
 #endif /* UnitTests_hpp */
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include <playrho/d2/DynamicTree.hpp>
+#include <playrho/d2/RayCastOutput.hpp>
+#include <playrho/d2/WideDynamicTree.hpp>
+
+#include "gtest/gtest.h"
+
+using namespace playrho;
+using namespace playrho::d2;
+
+namespace {
+
+/// @brief Makes a tree having leaves in a grid, with the bottom row in the static partition.
+DynamicTree MakeGridTree(unsigned columns, unsigned rows)
+{
+    auto tree = DynamicTree{};
+    for (auto row = 0u; row < rows; ++row) {
+        for (auto col = 0u; col < columns; ++col) {
+            const auto x = static_cast<Real>(col) * 2_m;
+            const auto y = static_cast<Real>(row) * 2_m;
+            const auto partition = (row == 0u)? DynamicTree::Partition::Static
+                                              : DynamicTree::Partition::Dynamic;
+            tree.CreateLeaf(AABB{Length2{x, y}, Length2{x + 1_m, y + 1_m}},
+                            Contactable{BodyID(row * columns + col), ShapeID(0), 0u}, partition);
+        }
+    }
+    return tree;
+}
+
+template <class Tree>
+std::vector<DynamicTree::Size> QueryAll(const Tree& tree, typename Tree::Size root,
+                                        const AABB& aabb)
+{
+    auto found = std::vector<DynamicTree::Size>{};
+    Query(tree, root, aabb, [&found](DynamicTree::Size index) {
+        found.push_back(index);
+        return DynamicTreeOpcode::Continue;
+    });
+    std::sort(begin(found), end(found));
+    return found;
+}
+
+template <class Tree>
+std::vector<BodyID> RayCastAll(const Tree& tree, const RayCastInput& input)
+{
+    auto found = std::vector<BodyID>{};
+    RayCast(tree, input, [&found](BodyID body, ShapeID, ChildCounter, const RayCastInput&) {
+        found.push_back(body);
+        return Real(-1);
+    });
+    std::sort(begin(found), end(found));
+    return found;
+}
+
+} // namespace
+
+TEST(WideDynamicTree, Traits)
+{
+    EXPECT_TRUE(std::is_nothrow_default_constructible_v<WideDynamicTree>);
+    EXPECT_TRUE(std::is_copy_constructible_v<WideDynamicTree>);
+    EXPECT_TRUE(std::is_nothrow_move_constructible_v<WideDynamicTree>);
+}
+
+TEST(WideDynamicTree, DefaultConstruction)
+{
+    const auto tree = WideDynamicTree{};
+    EXPECT_EQ(tree.GetRootIndex(), WideDynamicTree::InvalidSize);
+    EXPECT_EQ(tree.GetRootIndex(DynamicTree::Partition::Static), WideDynamicTree::InvalidSize);
+    EXPECT_EQ(tree.GetRootIndex(DynamicTree::Partition::Dynamic), WideDynamicTree::InvalidSize);
+    EXPECT_EQ(tree.GetNodeCount(), 0u);
+    EXPECT_EQ(tree.GetLeafCount(), 0u);
+    auto calls = 0;
+    Query(tree, AABB{Length2{-10_m, -10_m}, Length2{10_m, 10_m}}, [&calls](DynamicTree::Size) {
+        ++calls;
+        return DynamicTreeOpcode::Continue;
+    });
+    EXPECT_EQ(calls, 0);
+    EXPECT_FALSE(RayCast(tree, RayCastInput{Length2{-10_m, 0_m}, Length2{10_m, 0_m}, Real(1)},
+                         [](BodyID, ShapeID, ChildCounter, const RayCastInput&) {
+        return Real(0);
+    }));
+}
+
+TEST(WideDynamicTree, OneLeaf)
+{
+    auto dynamicTree = DynamicTree{};
+    const auto leaf = dynamicTree.CreateLeaf(AABB{Length2{0_m, 0_m}, Length2{1_m, 1_m}},
+                                             Contactable{BodyID(3), ShapeID(2), 1u});
+    const auto tree = WideDynamicTree{dynamicTree};
+    ASSERT_NE(tree.GetRootIndex(), WideDynamicTree::InvalidSize);
+    EXPECT_EQ(tree.GetRootIndex(), tree.GetRootIndex(DynamicTree::Partition::Dynamic));
+    EXPECT_EQ(tree.GetRootIndex(DynamicTree::Partition::Static), WideDynamicTree::InvalidSize);
+    EXPECT_EQ(tree.GetNodeCount(), 1u);
+    ASSERT_EQ(tree.GetLeafCount(), 1u);
+    EXPECT_EQ(tree.GetLeaf(0u).index, leaf);
+    EXPECT_EQ(tree.GetLeaf(0u).data, dynamicTree.GetLeafData(leaf));
+    const auto& root = tree.GetNode(tree.GetRootIndex());
+    EXPECT_EQ(root.count, 1u);
+    EXPECT_EQ(root.leafMask, 1u);
+    EXPECT_EQ(QueryAll(tree, tree.GetRootIndex(), AABB{Length2{0.5_m, 0.5_m}}),
+              std::vector<DynamicTree::Size>{leaf});
+    EXPECT_TRUE(empty(QueryAll(tree, tree.GetRootIndex(), AABB{Length2{2_m, 2_m}})));
+}
+
+TEST(WideDynamicTree, CollapsesToFourWide)
+{
+    const auto dynamicTree = MakeGridTree(16u, 16u);
+    const auto tree = WideDynamicTree{dynamicTree};
+    EXPECT_EQ(tree.GetLeafCount(), dynamicTree.GetLeafCount());
+    EXPECT_LT(tree.GetNodeCount(), dynamicTree.GetLeafCount() / 2u);
+    auto childCount = WideDynamicTree::Size{0};
+    for (auto i = WideDynamicTree::Size{0}; i < tree.GetNodeCount(); ++i) {
+        const auto& node = tree.GetNode(i);
+        EXPECT_GT(node.count, 0u);
+        EXPECT_LE(node.count, WideDynamicTree::Width);
+        childCount += node.count;
+    }
+    // Every node except the root is the child of another node.
+    EXPECT_EQ(childCount, tree.GetNodeCount() - 1u + tree.GetLeafCount());
+}
+
+TEST(WideDynamicTree, QueryFindsSameAsDynamicTree)
+{
+    const auto dynamicTree = MakeGridTree(13u, 11u);
+    const auto tree = WideDynamicTree{dynamicTree};
+    for (const auto partition: {DynamicTree::Partition::Static, DynamicTree::Partition::Dynamic}) {
+        EXPECT_NE(tree.GetRootIndex(partition), WideDynamicTree::InvalidSize);
+    }
+    for (auto i = 0; i < 30; ++i) {
+        const auto x = static_cast<Real>(i % 7) * 3.5_m - 1_m;
+        const auto y = static_cast<Real>(i % 5) * 4.5_m - 1_m;
+        const auto aabb = AABB{Length2{x, y}, Length2{x + static_cast<Real>(i % 4) * 2_m,
+                                                      y + static_cast<Real>(i % 3) * 3_m}};
+        EXPECT_EQ(QueryAll(tree, tree.GetRootIndex(), aabb),
+                  QueryAll(dynamicTree, dynamicTree.GetRootIndex(), aabb));
+        for (const auto partition: {DynamicTree::Partition::Static,
+                                    DynamicTree::Partition::Dynamic}) {
+            EXPECT_EQ(QueryAll(tree, tree.GetRootIndex(partition), aabb),
+                      QueryAll(dynamicTree, dynamicTree.GetRootIndex(partition), aabb));
+        }
+    }
+}
+
+TEST(WideDynamicTree, QueryEnds)
+{
+    const auto tree = WideDynamicTree{MakeGridTree(8u, 8u)};
+    auto calls = 0;
+    Query(tree, AABB{Length2{-1_m, -1_m}, Length2{100_m, 100_m}}, [&calls](DynamicTree::Size) {
+        ++calls;
+        return DynamicTreeOpcode::End;
+    });
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(WideDynamicTree, RayCastFindsSameAsDynamicTree)
+{
+    const auto dynamicTree = MakeGridTree(10u, 10u);
+    const auto tree = WideDynamicTree{dynamicTree};
+    const auto inputs = {
+        RayCastInput{Length2{-1_m, 0.5_m}, Length2{30_m, 0.5_m}, Real(1)},
+        RayCastInput{Length2{-1_m, -1_m}, Length2{30_m, 30_m}, Real(1)},
+        RayCastInput{Length2{0.5_m, 18.5_m}, Length2{18.5_m, 0.5_m}, Real(0.5f)},
+        RayCastInput{Length2{2.5_m, -1_m}, Length2{2.5_m, 30_m}, Real(1)},
+    };
+    for (const auto& input: inputs) {
+        const auto found = RayCastAll(tree, input);
+        EXPECT_FALSE(empty(found));
+        EXPECT_EQ(found, RayCastAll(dynamicTree, input));
+    }
+    auto calls = 0;
+    EXPECT_TRUE(RayCast(tree, *begin(inputs),
+                        [&calls](BodyID, ShapeID, ChildCounter, const RayCastInput&) {
+        ++calls;
+        return Real(0);
+    }));
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(WideDynamicTree, Rebuild)
+{
+    auto dynamicTree = MakeGridTree(4u, 4u);
+    auto tree = WideDynamicTree{dynamicTree};
+    EXPECT_EQ(tree.GetLeafCount(), 16u);
+    dynamicTree.Clear();
+    tree.Rebuild(dynamicTree);
+    EXPECT_EQ(tree.GetRootIndex(), WideDynamicTree::InvalidSize);
+    EXPECT_EQ(tree.GetLeafCount(), 0u);
+    tree.Rebuild(MakeGridTree(3u, 1u));
+    EXPECT_EQ(tree.GetLeafCount(), 3u);
+    EXPECT_EQ(tree.GetRootIndex(), tree.GetRootIndex(DynamicTree::Partition::Static));
+    tree.Clear();
+    EXPECT_EQ(tree.GetNodeCount(), 0u);
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2023 Louis Langholtz https://github.com/louis-langholtz/PlayRho
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <algorithm>
+#include <set>
+#include <type_traits>
+#include <vector>
+
+#include <playrho/to_underlying.hpp>
+
+#include <playrho/d2/BodyConstraint.hpp>
+#include <playrho/d2/ContactSolver.hpp>
+#include <playrho/d2/VelocityConstraint.hpp>
+#include <playrho/d2/WideVelocityConstraints.hpp>
+#include <playrho/d2/WorldManifold.hpp>
+
+#include "gtest/gtest.h"
+
+using namespace playrho;
+using namespace playrho::d2;
+
+namespace {
+
+constexpr auto BodyCount = 9u;
+
+/// @brief Makes body constraints of a static ground body followed by dynamic boxes
+///   resting on it that are moving into it.
+std::vector<BodyConstraint> MakeBodies()
+{
+    auto bodies = std::vector<BodyConstraint>{};
+    bodies.emplace_back(InvMass{}, InvRotInertia{}, Length2{},
+                        Position{Length2{}, 0_deg}, Velocity{});
+    for (auto i = 1u; i < BodyCount; ++i) {
+        const auto x = static_cast<Real>(i) * 2_m;
+        const auto velocity = Velocity{
+            LinearVelocity2{static_cast<Real>(i % 3) * 0.5_mps, -static_cast<Real>(i) * 1_mps},
+            static_cast<Real>(i % 2) * 0.25_rad / 1_s
+        };
+        bodies.emplace_back(Real(1) / 1_kg,
+                            InvRotInertia{Real{6} * SquareRadian / (SquareMeter * 1_kg)},
+                            Length2{}, Position{Length2{x, 0.5_m}, 0_deg}, velocity);
+    }
+    return bodies;
+}
+
+/// @brief Makes a velocity constraint of the given body resting on the ground body.
+VelocityConstraint MakeGroundConstraint(BodyID body, bool twoPoints,
+                                        const Span<const BodyConstraint>& bodies)
+{
+    const auto x = GetX(bodies[to_underlying(body)].GetPosition().linear);
+    const auto p0 = WorldManifold::PointData{Length2{x - 0.5_m, 0_m}, Momentum2{}, 0_m};
+    const auto p1 = WorldManifold::PointData{Length2{x + 0.5_m, 0_m}, Momentum2{}, 0_m};
+    const auto manifold = twoPoints? WorldManifold{UnitVec::GetUp(), p0, p1}
+                                   : WorldManifold{UnitVec::GetUp(), p0};
+    return VelocityConstraint{Real(0.6f), Real(0.2f), 0_mps, manifold, BodyID(0u), body, bodies};
+}
+
+} // namespace
+
+TEST(WideVelocityConstraints, Traits)
+{
+    EXPECT_TRUE(std::is_nothrow_default_constructible_v<WideVelocityConstraints>);
+    EXPECT_TRUE(std::is_copy_constructible_v<WideVelocityConstraints>);
+    EXPECT_TRUE(std::is_nothrow_move_constructible_v<WideVelocityConstraints>);
+}
+
+TEST(WideVelocityConstraints, DefaultConstruction)
+{
+    auto constraints = WideVelocityConstraints{};
+    EXPECT_EQ(constraints.GetBundleCount(), 0u);
+    EXPECT_EQ(constraints.Solve(Span<BodyConstraint>{}), 0_Ns);
+}
+
+TEST(WideVelocityConstraints, BundlesDontShareMovableBodies)
+{
+    const auto bodies = MakeBodies();
+    auto vcs = std::vector<VelocityConstraint>{};
+    for (auto i = 1u; i < BodyCount; ++i) {
+        vcs.push_back(MakeGroundConstraint(BodyID(i), (i % 2) == 0u, bodies));
+    }
+    // Chain the boxes to each other too so some constraints have to go in separate bundles.
+    for (auto i = 1u; i + 1u < BodyCount; ++i) {
+        const auto manifold = WorldManifold{UnitVec::GetRight(), WorldManifold::PointData{
+            Length2{static_cast<Real>(i) * 2_m + 1_m, 0.5_m}, Momentum2{}, 0_m}};
+        vcs.emplace_back(Real(0.5f), Real(0), 0_mps, manifold, BodyID(i), BodyID(i + 1u), bodies);
+    }
+
+    const auto constraints = WideVelocityConstraints{vcs, bodies};
+    EXPECT_LT(constraints.GetBundleCount(), size(vcs));
+    auto found = std::vector<std::size_t>{};
+    for (auto i = std::size_t{0}; i < constraints.GetBundleCount(); ++i) {
+        const auto& bundle = constraints.GetBundle(i);
+        ASSERT_GT(bundle.count, 0u);
+        ASSERT_LE(bundle.count, WideVelocityConstraints::Width);
+        auto movable = std::set<BodyID>{};
+        for (auto lane = std::size_t{0}; lane < bundle.count; ++lane) {
+            found.push_back(bundle.constraints[lane]);
+            for (const auto body: {bundle.bodyA[lane], bundle.bodyB[lane]}) {
+                if (body != BodyID(0u)) {
+                    EXPECT_TRUE(movable.insert(body).second);
+                }
+            }
+        }
+    }
+    std::sort(begin(found), end(found));
+    auto expected = std::vector<std::size_t>(size(vcs));
+    for (auto i = std::size_t{0}; i < size(expected); ++i) {
+        expected[i] = i;
+    }
+    EXPECT_EQ(found, expected);
+}
+
+TEST(WideVelocityConstraints, SolveMatchesGaussSeidel)
+{
+    auto scalarBodies = MakeBodies();
+    auto scalarVcs = std::vector<VelocityConstraint>{};
+    for (auto i = 1u; i < BodyCount; ++i) {
+        scalarVcs.push_back(MakeGroundConstraint(BodyID(i), (i % 3) != 0u, scalarBodies));
+    }
+    auto wideBodies = scalarBodies;
+    auto wideVcs = scalarVcs;
+    auto constraints = WideVelocityConstraints{wideVcs, wideBodies};
+    EXPECT_EQ(constraints.GetBundleCount(), std::size_t{2});
+
+    for (auto iteration = 0; iteration < 3; ++iteration) {
+        auto scalarMax = 0_Ns;
+        for (auto& vc: scalarVcs) {
+            scalarMax = std::max(scalarMax, GaussSeidel::SolveVelocityConstraint(vc, scalarBodies));
+        }
+        const auto wideMax = constraints.Solve(wideBodies);
+        EXPECT_NEAR(static_cast<double>(Real{wideMax / 1_Ns}),
+                    static_cast<double>(Real{scalarMax / 1_Ns}), 1e-4);
+    }
+    constraints.Store(wideVcs);
+
+    for (auto i = std::size_t{0}; i < size(scalarBodies); ++i) {
+        const auto scalar = scalarBodies[i].GetVelocity();
+        const auto wide = wideBodies[i].GetVelocity();
+        EXPECT_NEAR(static_cast<double>(Real{GetX(wide.linear) / 1_mps}),
+                    static_cast<double>(Real{GetX(scalar.linear) / 1_mps}), 1e-4);
+        EXPECT_NEAR(static_cast<double>(Real{GetY(wide.linear) / 1_mps}),
+                    static_cast<double>(Real{GetY(scalar.linear) / 1_mps}), 1e-4);
+        EXPECT_NEAR(static_cast<double>(Real{wide.angular / 1_rad * 1_s}),
+                    static_cast<double>(Real{scalar.angular / 1_rad * 1_s}), 1e-4);
+    }
+    for (auto i = std::size_t{0}; i < size(scalarVcs); ++i) {
+        for (auto j = VelocityConstraint::size_type{0}; j < scalarVcs[i].GetPointCount(); ++j) {
+            EXPECT_NEAR(static_cast<double>(Real{wideVcs[i].GetNormalImpulseAtPoint(j) / 1_Ns}),
+                        static_cast<double>(Real{scalarVcs[i].GetNormalImpulseAtPoint(j) / 1_Ns}),
+                        1e-4);
+            EXPECT_NEAR(static_cast<double>(Real{wideVcs[i].GetTangentImpulseAtPoint(j) / 1_Ns}),
+                        static_cast<double>(Real{scalarVcs[i].GetTangentImpulseAtPoint(j) / 1_Ns}),
+                        1e-4);
+        }
+    }
+}
@@ -807,6 +807,87 @@ TEST(WorldBody, SetAwake)
     }
 }
 
+TEST(WorldBody, GetBodyIsInPlace)
+{
+    auto world = World{};
+    const auto body = CreateBody(world, BodyConf{}.Use(BodyType::Dynamic));
+    EXPECT_EQ(&GetBody(world, body), &GetBody(world, body));
+    const auto velocity = Velocity{LinearVelocity2{1_mps, 2_mps}, 3_rpm};
+    ASSERT_NO_THROW(SetVelocity(world, body, velocity));
+    EXPECT_EQ(GetVelocity(GetBody(world, body)), velocity);
+    const auto xfm = Transformation{Length2{4_m, 5_m}, UnitVec::GetRight()};
+    ASSERT_NO_THROW(SetTransformation(world, body, xfm));
+    EXPECT_EQ(GetTransformation(GetBody(world, body)), xfm);
+}
+
+TEST(WorldBody, InPlaceSettersThrowForInvalidBody)
+{
+    auto world = World{};
+    const auto body = CreateBody(world, BodyConf{}.Use(BodyType::Dynamic));
+    ASSERT_NO_THROW(CreateBody(world));
+    const auto invalid = BodyID(GetBodyRange(world));
+    const auto velocity = Velocity{};
+    const auto accel = Acceleration{};
+    const auto xfm = Transformation{};
+    EXPECT_THROW(SetVelocity(world, invalid, velocity), std::out_of_range);
+    EXPECT_THROW(SetAcceleration(world, invalid, accel), std::out_of_range);
+    EXPECT_THROW(SetTransformation(world, invalid, xfm), std::out_of_range);
+    EXPECT_THROW(SetEnabled(world, invalid, false), std::out_of_range);
+    EXPECT_THROW(SetAwake(world, invalid), std::out_of_range);
+    EXPECT_THROW(SetImpenetrable(world, invalid), std::out_of_range);
+    EXPECT_THROW(SetSleepingAllowed(world, invalid, false), std::out_of_range);
+    ASSERT_NO_THROW(Destroy(world, body));
+    EXPECT_THROW(SetVelocity(world, body, velocity), WasDestroyed<BodyID>);
+    EXPECT_THROW(SetAcceleration(world, body, accel), WasDestroyed<BodyID>);
+    EXPECT_THROW(SetTransformation(world, body, xfm), WasDestroyed<BodyID>);
+    EXPECT_THROW(SetEnabled(world, body, false), WasDestroyed<BodyID>);
+    EXPECT_THROW(UnsetAwake(world, body), WasDestroyed<BodyID>);
+    EXPECT_THROW(UnsetImpenetrable(world, body), WasDestroyed<BodyID>);
+    EXPECT_THROW(SetSleepingAllowed(world, body, false), WasDestroyed<BodyID>);
+}
+
+TEST(WorldBody, GetSetBodyStates)
+{
+    auto world = World{};
+    auto ids = std::vector<BodyID>{};
+    for (auto i = 0; i < 4; ++i) {
+        const auto x = static_cast<Real>(i) * 1_m;
+        ids.push_back(CreateBody(world, BodyConf{}.Use(BodyType::Dynamic).UseLocation(Length2{x, 0_m})));
+    }
+    auto locations = std::vector<Length2>(size(ids));
+    auto velocities = std::vector<Velocity>(size(ids));
+    ASSERT_NO_THROW(GetBodyStates(world, ids, BodyStateSpans{locations, {}, velocities, {}}));
+    for (auto i = std::size_t{0}; i < size(ids); ++i) {
+        EXPECT_EQ(locations[i], GetLocation(world, ids[i]));
+        EXPECT_EQ(velocities[i], GetVelocity(world, ids[i]));
+    }
+
+    for (auto i = std::size_t{0}; i < size(ids); ++i) {
+        locations[i] = Length2{0_m, static_cast<Real>(i) * 2_m};
+        velocities[i] = Velocity{LinearVelocity2{static_cast<Real>(i) * 1_mps, 0_mps}, 0_rpm};
+    }
+    const auto accelerations = std::vector<Acceleration>(size(ids), Acceleration{
+        LinearAcceleration2{0_mps2, -10_mps2}, AngularAcceleration{}});
+    ASSERT_NO_THROW(SetBodyStates(world, ids, ConstBodyStateSpans{
+        locations, {}, velocities, accelerations}));
+    for (auto i = std::size_t{0}; i < size(ids); ++i) {
+        EXPECT_EQ(GetLocation(world, ids[i]), locations[i]);
+        EXPECT_EQ(GetAngle(world, ids[i]), 0_deg);
+        EXPECT_EQ(GetVelocity(world, ids[i]), velocities[i]);
+        EXPECT_EQ(GetAcceleration(world, ids[i]), accelerations[i]);
+    }
+
+    auto tooFew = std::vector<Velocity>(size(ids) - 1u);
+    EXPECT_THROW(GetBodyStates(world, ids, BodyStateSpans{{}, {}, tooFew, {}}), InvalidArgument);
+    EXPECT_THROW(SetBodyStates(world, ids, ConstBodyStateSpans{{}, {}, tooFew, {}}),
+                 InvalidArgument);
+    const auto badIds = std::vector<BodyID>{ids[0], BodyID(GetBodyRange(world))};
+    const auto newVelocities = std::vector<Velocity>(size(badIds));
+    EXPECT_THROW(SetBodyStates(world, badIds, ConstBodyStateSpans{{}, {}, newVelocities, {}}),
+                 std::out_of_range);
+    EXPECT_EQ(GetVelocity(world, ids[0]), velocities[0]);
+}
+
 TEST(WorldBody, GetBodyRange)
 {
     auto world = World{};
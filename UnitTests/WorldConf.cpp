@@ -29,6 +29,8 @@ TEST(WorldConf, DefaultConstruction)
 {
     const auto worldConf = WorldConf{};
     EXPECT_EQ(worldConf.upstream, WorldConf::DefaultUpstream);
+    EXPECT_EQ(worldConf.taskScheduler, nullptr);
+    EXPECT_EQ(worldConf.tracer, nullptr);
     EXPECT_EQ(worldConf.vertexRadius, WorldConf::DefaultVertexRadius);
     EXPECT_EQ(worldConf.treeCapacity, WorldConf::DefaultTreeCapacity);
     EXPECT_EQ(worldConf.contactCapacity, WorldConf::DefaultContactCapacity);
@@ -39,6 +41,8 @@ TEST(WorldConf, DefaultConstruction)
     EXPECT_EQ(worldConf.reserveContactKeys, WorldConf::DefaultReserveContactKeys);
     EXPECT_EQ(worldConf.reserveBuffers, WorldConf::DefaultReserveBuffers);
     EXPECT_EQ(worldConf.doStats, WorldConf::DefaultDoStats);
+    EXPECT_EQ(worldConf.doStepArena, WorldConf::DefaultDoStepArena);
+    EXPECT_EQ(worldConf.doContactEvents, WorldConf::DefaultDoContactEvents);
 }
 
 TEST(WorldConf, UseUpstream)
@@ -46,6 +50,26 @@ TEST(WorldConf, UseUpstream)
     EXPECT_EQ(WorldConf().UseUpstream(nullptr).upstream, nullptr);
 }
 
+TEST(WorldConf, UseTaskScheduler)
+{
+    struct Scheduler: TaskScheduler {
+        size_type GetConcurrency() const noexcept override { return 1u; }
+        void Run(const Span<const Task>&) override {}
+    };
+    auto scheduler = Scheduler{};
+    EXPECT_EQ(WorldConf().UseTaskScheduler(&scheduler).taskScheduler, &scheduler);
+}
+
+TEST(WorldConf, UseTracer)
+{
+    struct NullTracer: Tracer {
+        void Begin(const char*) noexcept override {}
+        void End(const char*) noexcept override {}
+    };
+    auto tracer = NullTracer{};
+    EXPECT_EQ(WorldConf().UseTracer(&tracer).tracer, &tracer);
+}
+
 TEST(WorldConf, UseVertexRadius)
 {
     EXPECT_EQ(WorldConf().UseVertexRadius({4.2_m, 6.3_m}).vertexRadius.GetMin(), 4.2_m);